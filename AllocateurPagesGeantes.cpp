@@ -0,0 +1,107 @@
+/**
+ * \file AllocateurPagesGeantes.cpp
+ * \brief Allocation par mmap sur des pages de 2 Mo
+ *
+ */
+#include "AllocateurPagesGeantes.h"
+#include <cstdint>
+#include <sys/mman.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+
+namespace labTableHachage
+{
+
+namespace
+{
+    size_t arrondirPageGeante(size_t p_octets)
+    {
+        return (p_octets + TAILLE_PAGE_GEANTE - 1) & ~(TAILLE_PAGE_GEANTE - 1);
+    }
+}
+
+/**
+ * \brief Alloue une zone, sur des pages de 2 Mo si elle en vaut la peine
+ * \param[in] p_octets Taille demandée
+ * \param[out] p_type Si non nul, reçoit le type de pages obtenu
+ * \return La zone, alignée sur 2 Mo si p_octets atteint TAILLE_PAGE_GEANTE
+ * \throw std::bad_alloc si la mémoire manque
+ */
+void * allouerPagesGeantes(size_t p_octets, TypePages * p_type)
+{
+    TypePages type = TypePages::ORDINAIRES;
+    void * zone = nullptr;
+    if (p_octets < TAILLE_PAGE_GEANTE)
+    {
+        zone = ::operator new(p_octets == 0 ? 1 : p_octets);
+    }
+    else
+    {
+        const size_t arrondi = arrondirPageGeante(p_octets);
+        zone = mmap(nullptr, arrondi, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+        if (zone != MAP_FAILED)
+        {
+            type = TypePages::EXPLICITES;
+        }
+        else
+        {
+            // Réserver 2 Mo de plus pour aligner le début, puis rendre les excédents
+            const size_t reserve = arrondi + TAILLE_PAGE_GEANTE;
+            void * brut = mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (brut == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            const uintptr_t debut = reinterpret_cast<uintptr_t>(brut);
+            const uintptr_t aligne = (debut + TAILLE_PAGE_GEANTE - 1) & ~uintptr_t(TAILLE_PAGE_GEANTE - 1);
+            if (aligne > debut)
+            {
+                munmap(brut, aligne - debut);
+            }
+            const size_t excedentFin = (debut + reserve) - (aligne + arrondi);
+            if (excedentFin > 0)
+            {
+                munmap(reinterpret_cast<void *>(aligne + arrondi), excedentFin);
+            }
+            zone = reinterpret_cast<void *>(aligne);
+            if (madvise(zone, arrondi, MADV_HUGEPAGE) == 0)
+            {
+                type = TypePages::TRANSPARENTES;
+            }
+        }
+    }
+    if (p_type != nullptr)
+    {
+        *p_type = type;
+    }
+    return zone;
+}
+
+/**
+ * \brief Libère une zone obtenue de allouerPagesGeantes
+ * \param[in] p_zone La zone, ou nullptr
+ * \param[in] p_octets La taille demandée à l'allocation
+ */
+void libererPagesGeantes(void * p_zone, size_t p_octets) noexcept
+{
+    if (p_zone == nullptr)
+    {
+        return;
+    }
+    if (p_octets < TAILLE_PAGE_GEANTE)
+    {
+        ::operator delete(p_zone);
+    }
+    else
+    {
+        munmap(p_zone, arrondirPageGeante(p_octets));
+    }
+}
+
+} // namespace labTableHachage
@@ -0,0 +1,87 @@
+/**
+ * \file AllocateurPagesGeantes.h
+ * \brief Allocateur plaçant les grands tableaux de cases sur des pages de 2 Mo.
+ *
+ * Une table de plusieurs centaines de Mo sondée au hasard rate le TLB à
+ * presque chaque recherche avec des pages de 4 Ko. Sur des pages de 2 Mo, la
+ * même table n'a besoin que de quelques centaines d'entrées de TLB.
+ *
+ * Les allocations d'au moins 2 Mo sont faites par mmap : d'abord sur des
+ * pages géantes explicites (MAP_HUGETLB, réservées par l'administrateur dans
+ * /proc/sys/vm/nr_hugepages), sinon sur une zone alignée sur 2 Mo marquée
+ * MADV_HUGEPAGE pour les pages géantes transparentes. Les plus petites
+ * passent par operator new : elles n'occuperaient qu'une fraction de page.
+ */
+#ifndef ALLOCATEURPAGESGEANTES_H
+#define ALLOCATEURPAGESGEANTES_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace labTableHachage
+{
+
+/**
+ * \enum TypePages
+ * \brief Pages obtenues pour une allocation
+ */
+enum class TypePages
+{
+    ORDINAIRES, /*!< operator new, ou mmap dont le conseil a été refusé */
+    TRANSPARENTES, /*!< mmap aligné sur 2 Mo et MADV_HUGEPAGE */
+    EXPLICITES /*!< mmap avec MAP_HUGETLB */
+};
+
+inline constexpr size_t TAILLE_PAGE_GEANTE = size_t(2) << 20;
+
+void * allouerPagesGeantes(size_t p_octets, TypePages * p_type = nullptr);
+void libererPagesGeantes(void * p_zone, size_t p_octets) noexcept;
+
+/**
+ * \class AllocateurPagesGeantes
+ *
+ * \brief Allocateur standard utilisant allouerPagesGeantes
+ *
+ * Il n'a pas d'état : deux allocateurs sont toujours égaux. À passer aux
+ * tables comme paramètre Allocateur, par exemple
+ * TableHachage<int, int, HInt2, AllocateurPagesGeantes<char> >.
+ */
+template<typename T>
+class AllocateurPagesGeantes
+{
+public:
+    typedef T value_type;
+
+    AllocateurPagesGeantes() noexcept = default;
+
+    template<typename U>
+    AllocateurPagesGeantes(const AllocateurPagesGeantes<U> &) noexcept
+    {
+    }
+
+    T * allocate(size_t p_nombre)
+    {
+        if (p_nombre > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Alignement non pris en charge");
+        return static_cast<T *>(allouerPagesGeantes(p_nombre * sizeof(T)));
+    }
+
+    void deallocate(T * p_zone, size_t p_nombre) noexcept
+    {
+        libererPagesGeantes(p_zone, p_nombre * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const AllocateurPagesGeantes<U> &) const noexcept
+    {
+        return true;
+    }
+};
+
+} // namespace labTableHachage
+
+#endif // ALLOCATEURPAGESGEANTES_H
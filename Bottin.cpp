@@ -1,23 +1,122 @@
 #include "Bottin.h"
+#include "Instrumentation.h"
 #include <sstream>
 #include <stdexcept>
-#include <regex>
+#include <algorithm>
+#include <string_view>
 
 namespace TP3 {
+
+namespace {
+    /**
+     * \brief Vue sur la clé « nom prénom » d'une entrée, sans la concaténer.
+     */
+    struct VueCleNomPrenom {
+        std::string_view m_nom;
+        std::string_view m_prenom;
+
+        size_t size() const { return m_nom.size() + 1 + m_prenom.size(); }
+        char operator[](size_t i) const {
+            if (i < m_nom.size()) return m_nom[i];
+            if (i == m_nom.size()) return ' ';
+            return m_prenom[i - m_nom.size() - 1];
+        }
+    };
+
+    constexpr size_t SANS_LIMITE = static_cast<size_t>(-1);
+
+    /**
+     * \brief Lit le début d'un numéro au format (ddd) ddd-dddd : "(ddd)" ou "(ddd) ddd".
+     * \return Les chiffres lus, ou rien si le texte n'a pas l'une de ces deux formes.
+     */
+    std::optional<uint64_t> lirePrefixeTelephone(std::string_view p_texte, size_t p_longueur) {
+        if (p_texte.size() != p_longueur) {
+            return std::nullopt;
+        }
+        uint64_t valeur = 0;
+        for (size_t i = 0; i < p_longueur; ++i) {
+            if (GABARIT_TELEPHONE[i] == 'd') {
+                if (p_texte[i] < '0' || p_texte[i] > '9') return std::nullopt;
+                valeur = valeur * 10 + static_cast<uint64_t>(p_texte[i] - '0');
+            } else if (p_texte[i] != GABARIT_TELEPHONE[i]) {
+                return std::nullopt;
+            }
+        }
+        return valeur;
+    }
+
+    constexpr size_t LONGUEUR_INDICATIF = 5; /*!< "(ddd)" */
+    constexpr size_t LONGUEUR_CENTRAL = 9; /*!< "(ddd) ddd" */
+
+    /**
+     * \brief Compare lexicographiquement deux clés sur au plus p_limite caractères.
+     * \return Négatif, nul ou positif selon que p_a est avant, égale ou après p_b.
+     */
+    template<typename CleA, typename CleB>
+    int comparerCles(const CleA& p_a, const CleB& p_b, size_t p_limite) {
+        const size_t longueurA = std::min(p_a.size(), p_limite);
+        const size_t longueurB = std::min(p_b.size(), p_limite);
+        const size_t commun = std::min(longueurA, longueurB);
+        for (size_t i = 0; i < commun; ++i) {
+            const unsigned char a = static_cast<unsigned char>(p_a[i]);
+            const unsigned char b = static_cast<unsigned char>(p_b[i]);
+            if (a != b) return a < b ? -1 : 1;
+        }
+        return longueurA < longueurB ? -1 : (longueurA > longueurB ? 1 : 0);
+    }
+
+    VueCleNomPrenom vueCle(const StockageEntrees& p_entrees, size_t p_index) {
+        return VueCleNomPrenom{p_entrees.nom(p_index), p_entrees.prenom(p_index)};
+    }
+
+    /**
+     * \brief Recherche un bloc de clés dans un index en ne sondant que celles que le filtre n'écarte pas.
+     */
+    template<typename Index, typename Clef, typename PeutExister>
+    void trouverFiltrees(const Index& p_index, const std::vector<Clef>& p_clefs,
+                         std::span<std::optional<size_t> > p_resultats, PeutExister p_peutExister) {
+        std::vector<Clef> restantes;
+        std::vector<size_t> positions;
+        for (size_t i = 0; i < p_clefs.size(); ++i) {
+            if (p_peutExister(p_clefs[i])) {
+                restantes.push_back(p_clefs[i]);
+                positions.push_back(i);
+            } else {
+                p_resultats[i].reset();
+            }
+        }
+        std::vector<std::optional<size_t> > trouves(restantes.size());
+        p_index.trouverPlusieurs(restantes, trouves);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            p_resultats[positions[i]] = trouves[i];
+        }
+    }
+}
     /**
      * \brief Constructeur de la classe Bottin.
      * \details Initialise les structures internes et remplit le bottin à partir d'un fichier d'entrée.
      * \param[in] p_fichierEntree Fichier contenant les données à insérer dans le bottin.
      * \param[in] p_table_size Taille initiale des tables de hachage.
+     * \param[in] p_comparaisonNoms Comparaison exacte ou normalisée des clés nom/prénom.
      * \pre Le fichier doit être ouvert et non vide.
      * \post Les données valides du fichier sont insérées dans le bottin.
      */
-Bottin::Bottin(std::ifstream& p_fichierEntree, size_t p_table_size)
+Bottin::Bottin(std::ifstream& p_fichierEntree, size_t p_table_size, ComparaisonNoms p_comparaisonNoms)
     : m_tableauDesEntrees(),
-      m_tableParNomPrenom(p_table_size),
-      m_tableParTelephone(p_table_size) {
+      m_tableParNomPrenom(ExtracteurNomPrenom{&m_tableauDesEntrees}, p_table_size,
+                          HCleNomPrenom{p_comparaisonNoms == ComparaisonNoms::NORMALISEE},
+                          EgaliteCleNomPrenom{p_comparaisonNoms == ComparaisonNoms::NORMALISEE}),
+      m_tableParTelephone(ExtracteurTelephone{&m_tableauDesEntrees}, p_table_size),
+      m_tableParCellulaire(ExtracteurCellulaire{&m_tableauDesEntrees}, p_table_size),
+      m_tableParCourriel(ExtracteurCourriel{&m_tableauDesEntrees}, p_table_size),
+      m_tableParIndicatif(ExtracteurIndicatif{&m_tableauDesEntrees}, p_table_size),
+      m_tableParCentral(ExtracteurCentral{&m_tableauDesEntrees}, p_table_size),
+      m_indexFigeNomPrenom(ExtracteurNomPrenom{&m_tableauDesEntrees}),
+      m_indexFigeTelephone(ExtracteurTelephone{&m_tableauDesEntrees}) {
     PRECONDITION(p_fichierEntree.is_open());
+    MESURER_PHASE(labTableHachage::Phase::BOTTIN_CHARGEMENT);
     std::string line;
+    m_differerIndexPrefixe = true;
 
     // Ignorer la première ligne (en-tête)
     if (std::getline(p_fichierEntree, line)) {
@@ -48,6 +147,8 @@ Bottin::Bottin(std::ifstream& p_fichierEntree, size_t p_table_size)
 
         ajouter(p_nom, p_prenom, p_telephoneFixe, p_telephoneCellulaire, p_courriel);
     }
+    m_differerIndexPrefixe = false;
+    _trierIndexPrefixe();
 }
     /**
      * \brief Ajoute une entrée au bottin.
@@ -58,47 +159,184 @@ Bottin::Bottin(std::ifstream& p_fichierEntree, size_t p_table_size)
      * \param[in] p_courriel Adresse courriel.
      * \pre Aucun des paramètres ne doit être vide.
      * \pre Les numéros de téléphone doivent être dans un format valide (e.g., (555) 123-4567).
+     * \pre Le courriel doit avoir la forme local@domaine (voir validerEntree).
      * \pre La combinaison nom/prénom et le téléphone fixe doivent être uniques dans le bottin.
+     * \pre Le bottin n'est pas figé.
      * \post L'entrée est ajoutée aux structures internes et est accessible par recherche.
      */
 void Bottin::ajouter(const std::string& p_nom, const std::string& p_prenom,
                      const std::string& p_telephoneFixe, const std::string& p_cellulaire,
                      const std::string& p_courriel) {
 
-    PRECONDITION(!p_nom.empty() && "Le nom ne peut pas être vide");
-    PRECONDITION(!p_prenom.empty() && "Le prénom ne peut pas être vide");
-    PRECONDITION(!p_telephoneFixe.empty() && "Le téléphone fixe ne peut pas être vide");
-    PRECONDITION(!p_cellulaire.empty() && "Le téléphone cellulaire ne peut pas être vide");
-    PRECONDITION(!p_courriel.empty() && "L'adresse courriel ne peut pas être vide");
-    std::regex telRegex(R"(\(\d{3}\) \d{3}-\d{4})");
-    PRECONDITION(std::regex_match(p_telephoneFixe, telRegex) && "Le numéro de téléphone fixe n'est pas valide");
-    PRECONDITION(std::regex_match(p_cellulaire, telRegex) && "Le numéro de téléphone cellulaire n'est pas valide");
+    const ChampEntree champInvalide = validerEntree(p_nom, p_prenom, p_telephoneFixe, p_cellulaire, p_courriel);
+    PRECONDITION(champInvalide != ChampEntree::NOM && "Le nom ne peut pas être vide");
+    PRECONDITION(champInvalide != ChampEntree::PRENOM && "Le prénom ne peut pas être vide");
+    PRECONDITION(champInvalide != ChampEntree::TELEPHONE_FIXE && "Le numéro de téléphone fixe n'est pas valide");
+    PRECONDITION(champInvalide != ChampEntree::CELLULAIRE && "Le numéro de téléphone cellulaire n'est pas valide");
+    PRECONDITION(champInvalide != ChampEntree::COURRIEL && "L'adresse courriel n'est pas valide");
 
 
 
-    std::string cleNomPrenom = p_nom + " " + p_prenom;
+    PRECONDITION(!m_estFige && "Un bottin figé ne peut pas être modifié");
+
+    const CleNomPrenom cleNomPrenom{p_nom, p_prenom};
+    const uint64_t telephoneFixe = StockageEntrees::compacterTelephone(p_telephoneFixe);
+    const uint64_t cellulaire = StockageEntrees::compacterTelephone(p_cellulaire);
     PRECONDITION(!m_tableParNomPrenom.contient(cleNomPrenom));
-    PRECONDITION(!m_tableParTelephone.contient(p_telephoneFixe)); //Supposant que chaque numero est unique
+    PRECONDITION(!m_tableParTelephone.contient(telephoneFixe)); //Supposant que chaque numero est unique
+
+    size_t index;
+    if (!m_positionsLibres.empty()) {
+        // Réutiliser une position libérée par supprimer() plutôt que d'agrandir le tableau
+        index = m_positionsLibres.back();
+        m_positionsLibres.pop_back();
+        m_tableauDesEntrees.remplacer(index, p_nom, p_prenom, telephoneFixe, cellulaire, p_courriel);
+    } else {
+        index = m_tableauDesEntrees.ajouter(p_nom, p_prenom, telephoneFixe, cellulaire, p_courriel);
+    }
+
+    m_tableParNomPrenom.inserer(index);
+    m_tableParTelephone.inserer(index);
+    m_tableParCellulaire.inserer(index);
+    m_tableParCourriel.inserer(index);
+    m_tableParIndicatif.inserer(index);
+    m_tableParCentral.inserer(index);
+    if (m_tableParNomPrenom.taille() == labTableHachage::dispersion::SEUIL_REHACHAGE_PARALLELE) {
+        // Les prochains rehachages des grands index sont répartis entre les fils du bottin
+        GroupeTravailleurs& travailleurs = _travailleurs();
+        m_tableParNomPrenom.asgTravailleurs(&travailleurs);
+        m_tableParTelephone.asgTravailleurs(&travailleurs);
+        m_tableParCellulaire.asgTravailleurs(&travailleurs);
+        m_tableParCourriel.asgTravailleurs(&travailleurs);
+    }
+    _insererIndexPrefixe(index);
+    m_indexTrigrammes.ajouter(index, _texteNomPrenom(index));
+    _ajouterAuxFiltres(index);
+
+
+    POSTCONDITION_AUDIT(m_tableParNomPrenom.contient(cleNomPrenom) && "La clé NomPrenom n'a pas été insérée correctement");
+    POSTCONDITION_AUDIT(m_tableParTelephone.contient(telephoneFixe) && "La clé Téléphone fixe n'a pas été insérée correctement");
+
+
+    POSTCONDITION(m_tableauDesEntrees.nom(index) == p_nom && "Le nom n'a pas été inséré correctement dans le tableau");
+    POSTCONDITION(m_tableauDesEntrees.prenom(index) == p_prenom && "Le prénom n'a pas été inséré correctement dans le tableau");
+    POSTCONDITION(m_tableauDesEntrees.telephoneFixe(index) == telephoneFixe && "Le téléphone fixe n'a pas été inséré correctement dans le tableau");
+    POSTCONDITION(m_tableauDesEntrees.cellulaire(index) == cellulaire && "Le téléphone cellulaire n'a pas été inséré correctement dans le tableau");
+    POSTCONDITION(m_tableauDesEntrees.courriel(index) == p_courriel && "L'adresse courriel n'a pas été insérée correctement dans le tableau");
+}
+    /**
+     * \brief Supprime une entrée du bottin.
+     * \details L'entrée est retirée de chaque index en un sondage, puis sa position est mise dans la liste
+     * des positions libres; le tableau des entrées n'est pas décalé et les autres index restent valides.
+     * \param[in] p_nom Nom de la personne.
+     * \param[in] p_prenom Prénom de la personne.
+     * \pre Le bottin n'est pas figé.
+     * \pre L'entrée existe dans le bottin.
+     * \post L'entrée n'est plus accessible par aucune recherche.
+     */
+void Bottin::supprimer(const std::string& p_nom, const std::string& p_prenom) {
+    PRECONDITION(!m_estFige && "Un bottin figé ne peut pas être modifié");
 
-    Entree nouvelleEntree(p_nom, p_prenom, p_telephoneFixe, p_cellulaire, p_courriel);
-    m_tableauDesEntrees.push_back(nouvelleEntree);
+    const CleNomPrenom cleNomPrenom{p_nom, p_prenom};
+    // Un seul sondage trouve l'entrée et la retire de l'index des noms
+    std::optional<size_t> trouve = m_tableParNomPrenom.retirer(cleNomPrenom);
+    PRECONDITION(trouve.has_value() && "L'entrée à supprimer n'existe pas dans le bottin");
 
+    const size_t index = *trouve;
 
+    // Les autres index relisent les clés dans l'entrée : on les retire avant de vider l'entrée
+    m_tableParTelephone.enlever(m_tableauDesEntrees.telephoneFixe(index));
+    m_tableParCellulaire.enlever(index);
+    m_tableParCourriel.enlever(index);
+    m_tableParIndicatif.enlever(index);
+    m_tableParCentral.enlever(index);
+    _retirerIndexPrefixe(index);
+    m_indexTrigrammes.retirer(index, _texteNomPrenom(index));
 
+    m_tableauDesEntrees.liberer(index);
+    m_positionsLibres.push_back(index);
 
-    m_tableParNomPrenom.inserer(cleNomPrenom, m_tableauDesEntrees.size() - 1);
-    m_tableParTelephone.inserer(p_telephoneFixe, m_tableauDesEntrees.size() - 1);
+    POSTCONDITION_AUDIT(!m_tableParNomPrenom.contient(cleNomPrenom) && "La clé NomPrenom n'a pas été retirée correctement");
+}
+    /**
+     * \brief Modifie une entrée du bottin sur place.
+     * \details Seuls les index dont la clé change sont mis à jour, chacun par un retrait et une insertion;
+     * l'entrée garde sa position dans le tableau des entrées.
+     * \param[in] p_nom Nom actuel de la personne.
+     * \param[in] p_prenom Prénom actuel de la personne.
+     * \param[in] p_nouveauNom Nouveau nom.
+     * \param[in] p_nouveauPrenom Nouveau prénom.
+     * \param[in] p_telephoneFixe Nouveau numéro de téléphone fixe.
+     * \param[in] p_cellulaire Nouveau numéro de téléphone cellulaire.
+     * \param[in] p_courriel Nouvelle adresse courriel.
+     * \pre Les nouvelles valeurs respectent les mêmes règles que pour ajouter().
+     * \pre Le bottin n'est pas figé.
+     * \pre L'entrée existe dans le bottin.
+     * \pre Le nouveau nom/prénom et le nouveau téléphone fixe ne sont pas déjà utilisés par une autre entrée.
+     * \post L'entrée est accessible par ses nouvelles clés et plus par les anciennes.
+     */
+void Bottin::modifier(const std::string& p_nom, const std::string& p_prenom,
+                      const std::string& p_nouveauNom, const std::string& p_nouveauPrenom,
+                      const std::string& p_telephoneFixe, const std::string& p_cellulaire,
+                      const std::string& p_courriel) {
+    const ChampEntree champInvalide = validerEntree(p_nouveauNom, p_nouveauPrenom, p_telephoneFixe, p_cellulaire, p_courriel);
+    PRECONDITION(champInvalide != ChampEntree::NOM && "Le nom ne peut pas être vide");
+    PRECONDITION(champInvalide != ChampEntree::PRENOM && "Le prénom ne peut pas être vide");
+    PRECONDITION(champInvalide != ChampEntree::TELEPHONE_FIXE && "Le numéro de téléphone fixe n'est pas valide");
+    PRECONDITION(champInvalide != ChampEntree::CELLULAIRE && "Le numéro de téléphone cellulaire n'est pas valide");
+    PRECONDITION(champInvalide != ChampEntree::COURRIEL && "L'adresse courriel n'est pas valide");
+    PRECONDITION(!m_estFige && "Un bottin figé ne peut pas être modifié");
+
+    std::optional<size_t> trouve = m_tableParNomPrenom.trouver(CleNomPrenom{p_nom, p_prenom});
+    PRECONDITION(trouve.has_value() && "L'entrée à modifier n'existe pas dans le bottin");
 
+    const size_t index = *trouve;
+    const CleNomPrenom ancienneCle{m_tableauDesEntrees.nom(index), m_tableauDesEntrees.prenom(index)};
+    const CleNomPrenom nouvelleCle{p_nouveauNom, p_nouveauPrenom};
+    const uint64_t telephoneFixe = StockageEntrees::compacterTelephone(p_telephoneFixe);
+    const uint64_t cellulaire = StockageEntrees::compacterTelephone(p_cellulaire);
+    const bool nomChange = !(ancienneCle == nouvelleCle);
+    const bool telephoneChange = m_tableauDesEntrees.telephoneFixe(index) != telephoneFixe;
+    const bool cellulaireChange = m_tableauDesEntrees.cellulaire(index) != cellulaire;
+    const bool courrielChange = m_tableauDesEntrees.courriel(index) != p_courriel;
+
+    // En mode normalisé, la nouvelle clé peut désigner l'entrée elle-même ("Adam" devient "ADAM")
+    const std::optional<size_t> occupant = nomChange ? m_tableParNomPrenom.trouver(nouvelleCle) : std::nullopt;
+    PRECONDITION((!occupant || *occupant == index) && "Le nouveau nom/prénom est déjà utilisé");
+    PRECONDITION((!telephoneChange || !m_tableParTelephone.contient(telephoneFixe)) && "Le nouveau téléphone fixe est déjà utilisé");
+
+    // Retirer les anciennes clés pendant que l'entrée les contient encore
+    if (nomChange) {
+        m_tableParNomPrenom.enlever(ancienneCle);
+        _retirerIndexPrefixe(index);
+        m_indexTrigrammes.retirer(index, _texteNomPrenom(index));
+    }
+    if (telephoneChange) {
+        m_tableParTelephone.enlever(m_tableauDesEntrees.telephoneFixe(index));
+        m_tableParIndicatif.enlever(index);
+        m_tableParCentral.enlever(index);
+    }
+    if (cellulaireChange) m_tableParCellulaire.enlever(index);
+    if (courrielChange) m_tableParCourriel.enlever(index);
 
-    POSTCONDITION(m_tableParNomPrenom.contient(cleNomPrenom) && "La clé NomPrenom n'a pas été insérée correctement");
-    POSTCONDITION(m_tableParTelephone.contient(p_telephoneFixe) && "La clé Téléphone fixe n'a pas été insérée correctement");
+    m_tableauDesEntrees.remplacer(index, p_nouveauNom, p_nouveauPrenom, telephoneFixe, cellulaire, p_courriel);
 
+    if (nomChange) {
+        m_tableParNomPrenom.inserer(index);
+        _insererIndexPrefixe(index);
+        m_indexTrigrammes.ajouter(index, _texteNomPrenom(index));
+    }
+    if (telephoneChange) {
+        m_tableParTelephone.inserer(index);
+        m_tableParIndicatif.inserer(index);
+        m_tableParCentral.inserer(index);
+    }
+    if (cellulaireChange) m_tableParCellulaire.inserer(index);
+    if (courrielChange) m_tableParCourriel.inserer(index);
+    if (nomChange || telephoneChange) _ajouterAuxFiltres(index);
 
-    POSTCONDITION(m_tableauDesEntrees.back().m_nom == p_nom && "Le nom n'a pas été inséré correctement dans le tableau");
-    POSTCONDITION(m_tableauDesEntrees.back().m_prenom == p_prenom && "Le prénom n'a pas été inséré correctement dans le tableau");
-    POSTCONDITION(m_tableauDesEntrees.back().m_telephoneFixe == p_telephoneFixe && "Le téléphone fixe n'a pas été inséré correctement dans le tableau");
-    POSTCONDITION(m_tableauDesEntrees.back().m_cellulaire == p_cellulaire && "Le téléphone cellulaire n'a pas été inséré correctement dans le tableau");
-    POSTCONDITION(m_tableauDesEntrees.back().m_courriel == p_courriel && "L'adresse courriel n'a pas été insérée correctement dans le tableau");
+    POSTCONDITION_AUDIT(m_tableParNomPrenom.contient(nouvelleCle) && "La clé NomPrenom n'a pas été mise à jour correctement");
+    POSTCONDITION_AUDIT(m_tableParTelephone.contient(telephoneFixe) && "La clé Téléphone fixe n'a pas été mise à jour correctement");
 }
     /**
      * \brief Affiche toutes les entrées du bottin.
@@ -106,62 +344,408 @@ void Bottin::ajouter(const std::string& p_nom, const std::string& p_prenom,
      * \post Aucune modification des données internes.
      */
 void Bottin::afficherBottin(std::ostream& p_out) const {
-    for (const auto& entree : m_tableauDesEntrees) {
-        p_out << entree << std::endl;
-    }
+    _ecrireEntrees(p_out, OrdreExport::INSERTION, ", ");
+    p_out.flush();
+}
+    /**
+     * \brief Écrit le bottin au format TSV, précédé du nombre d'entrées.
+     * \param[out] p_sortie Flux de sortie.
+     * \param[in] p_ordre Ordre des lignes.
+     */
+void Bottin::exporterTSV(std::ostream& p_sortie, OrdreExport p_ordre) const {
+    p_sortie << nombreEntrees() << '\n';
+    _ecrireEntrees(p_sortie, p_ordre, "\t");
 }
     /**
      * \brief Recherche une entrée par nom et prénom.
      * \param[in] p_nom Nom de la personne à rechercher.
      * \param[in] p_prenom Prénom de la personne à rechercher.
-     * \return Une référence constante vers l'entrée correspondante.
+     * \return Une vue sur l'entrée correspondante.
      * \pre Les paramètres nom et prénom ne doivent pas être vides.
      * \throw std::runtime_error si l'entrée n'est pas trouvée.
      * \post Aucune modification des données internes.
      */
-const Bottin::Entree& Bottin::trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const {
+Bottin::Entree Bottin::trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const {
 
     PRECONDITION(!p_nom.empty() && "Le nom ne peut pas être vide");
     PRECONDITION(!p_prenom.empty() && "Le prénom ne peut pas être vide");
 
-    std::string cleNomPrenom = p_nom + " " + p_prenom;
-
-    if (!m_tableParNomPrenom.contient(cleNomPrenom)) {
-        throw std::runtime_error("Erreur : Le nom et prénom '" + cleNomPrenom + "' n'existent pas dans le bottin.");
+    std::optional<Entree> entree = chercherAvecNomPrenom(p_nom, p_prenom);
+    if (!entree) {
+        throw std::runtime_error("Erreur : Le nom et prénom '" + p_nom + " " + p_prenom + "' n'existent pas dans le bottin.");
     }
-
-    size_t index = m_tableParNomPrenom.element(cleNomPrenom);
-    POSTCONDITION(index < m_tableauDesEntrees.size() && "L'index récupéré est invalide.");
-    return m_tableauDesEntrees.at(index);
+    return std::move(*entree);
 
 }/**
  * \brief Recherche une entrée par numéro de téléphone fixe.
  * \param[in] p_telephoneFixe Numéro de téléphone fixe à rechercher.
- * \return Une référence constante vers l'entrée correspondante.
+ * \return Une vue sur l'entrée correspondante.
  * \pre Le numéro de téléphone fixe ne doit pas être vide.
  * \throw std::runtime_error si l'entrée n'est pas trouvée.
  * \post Aucune modification des données internes.
  */
-    const Bottin::Entree& Bottin::trouverAvecTelephone(const std::string& p_telephoneFixe) const {
+    Bottin::Entree Bottin::trouverAvecTelephone(const std::string& p_telephoneFixe) const {
 
     PRECONDITION(!p_telephoneFixe.empty() && "Le numéro de téléphone fixe ne peut pas être vide.");
 
-    if (!m_tableParTelephone.contient(p_telephoneFixe)) {
+    std::optional<Entree> entree = chercherAvecTelephone(p_telephoneFixe);
+    if (!entree) {
         throw std::runtime_error("Erreur : Le numéro de téléphone fixe '" + p_telephoneFixe + "' n'existe pas dans le bottin.");
     }
+    return std::move(*entree);
+}
+    /**
+     * \brief Recherche une entrée par nom et prénom, sans exception.
+     * \param[in] p_nom Nom de la personne à rechercher.
+     * \param[in] p_prenom Prénom de la personne à rechercher.
+     * \return Une vue sur l'entrée correspondante, ou rien si elle est absente.
+     * \post Aucune modification des données internes.
+     */
+std::optional<Bottin::Entree> Bottin::chercherAvecNomPrenom(std::string_view p_nom, std::string_view p_prenom) const {
+    const std::optional<size_t> trouve = _chercherNomPrenom(CleNomPrenom{p_nom, p_prenom});
+    if (!trouve) {
+        return std::nullopt;
+    }
+    POSTCONDITION(*trouve < m_tableauDesEntrees.taille() && "L'index récupéré est invalide.");
+    return _entree(*trouve);
+}
+    /**
+     * \brief Recherche une entrée par numéro de téléphone fixe, sans exception.
+     * \param[in] p_telephoneFixe Numéro de téléphone fixe à rechercher.
+     * \return Une vue sur l'entrée correspondante, ou rien si le numéro est absent ou mal formé.
+     * \post Aucune modification des données internes.
+     */
+std::optional<Bottin::Entree> Bottin::chercherAvecTelephone(std::string_view p_telephoneFixe) const {
+    // Un numéro mal formé ne peut pas être dans le bottin : ajouter() les refuse
+    if (!estTelephoneValide(p_telephoneFixe)) {
+        return std::nullopt;
+    }
+    const std::optional<size_t> trouve = _chercherTelephone(StockageEntrees::compacterTelephone(p_telephoneFixe));
+    if (!trouve) {
+        return std::nullopt;
+    }
+    POSTCONDITION(*trouve < m_tableauDesEntrees.taille() && "L'index récupéré est invalide.");
+    return _entree(*trouve);
+}
+    /**
+     * \brief Recherche un lot de numéros de téléphone fixe.
+     * \param[in] p_telephones Les numéros cherchés.
+     * \param[out] p_resultats L'index de l'entrée de chaque numéro, ou rien s'il est absent.
+     * \pre p_resultats a au moins autant de cases que p_telephones.
+     * \post Aucune modification des données internes.
+     */
+void Bottin::trouverPlusieursAvecTelephone(std::span<const std::string> p_telephones,
+                                           std::span<std::optional<size_t> > p_resultats) const {
+    PRECONDITION(p_resultats.size() >= p_telephones.size());
 
-    size_t index = m_tableParTelephone.element(p_telephoneFixe);
+    _executerParLots(p_telephones.size(), [&](size_t p_debut, size_t p_fin) {
+        // Un numéro mal formé reçoit une valeur qu'aucun numéro compacté ne peut prendre
+        std::vector<uint64_t> clefs;
+        clefs.reserve(p_fin - p_debut);
+        for (size_t i = p_debut; i < p_fin; ++i) {
+            clefs.push_back(estTelephoneValide(p_telephones[i]) ? StockageEntrees::compacterTelephone(p_telephones[i])
+                                                                : UINT64_MAX);
+        }
+        const std::span<std::optional<size_t> > resultats = p_resultats.subspan(p_debut, p_fin - p_debut);
+        if (m_filtresActifs) {
+            auto peutExister = [this](uint64_t p_telephone) { return _telephonePeutExister(p_telephone); };
+            if (m_estFige) {
+                trouverFiltrees(m_indexFigeTelephone, clefs, resultats, peutExister);
+            } else {
+                trouverFiltrees(m_tableParTelephone, clefs, resultats, peutExister);
+            }
+        } else if (m_estFige) {
+            m_indexFigeTelephone.trouverPlusieurs(clefs, resultats);
+        } else {
+            m_tableParTelephone.trouverPlusieurs(clefs, resultats);
+        }
+    });
+}
+    /**
+     * \brief Recherche un lot de clés nom/prénom.
+     * \param[in] p_nomsPrenoms Les paires (nom, prénom) cherchées.
+     * \param[out] p_resultats L'index de l'entrée de chaque paire, ou rien si elle est absente.
+     * \pre p_resultats a au moins autant de cases que p_nomsPrenoms.
+     * \post Aucune modification des données internes.
+     */
+void Bottin::trouverPlusieursAvecNomPrenom(std::span<const std::pair<std::string, std::string> > p_nomsPrenoms,
+                                           std::span<std::optional<size_t> > p_resultats) const {
+    PRECONDITION(p_resultats.size() >= p_nomsPrenoms.size());
 
-    POSTCONDITION(index < m_tableauDesEntrees.size() && "L'index récupéré est invalide.");
-    return m_tableauDesEntrees.at(index);
+    _executerParLots(p_nomsPrenoms.size(), [&](size_t p_debut, size_t p_fin) {
+        std::vector<CleNomPrenom> clefs;
+        clefs.reserve(p_fin - p_debut);
+        for (size_t i = p_debut; i < p_fin; ++i) {
+            clefs.push_back(CleNomPrenom{p_nomsPrenoms[i].first, p_nomsPrenoms[i].second});
+        }
+        const std::span<std::optional<size_t> > resultats = p_resultats.subspan(p_debut, p_fin - p_debut);
+        if (m_filtresActifs) {
+            auto peutExister = [this](const CleNomPrenom& p_cle) { return _nomPrenomPeutExister(p_cle); };
+            if (m_estFige) {
+                trouverFiltrees(m_indexFigeNomPrenom, clefs, resultats, peutExister);
+            } else {
+                trouverFiltrees(m_tableParNomPrenom, clefs, resultats, peutExister);
+            }
+        } else if (m_estFige) {
+            m_indexFigeNomPrenom.trouverPlusieurs(clefs, resultats);
+        } else {
+            m_tableParNomPrenom.trouverPlusieurs(clefs, resultats);
+        }
+    });
+}
+    /**
+     * \brief Recherche toutes les entrées ayant un numéro de cellulaire donné.
+     * \param[in] p_cellulaire Numéro de cellulaire.
+     * \return Les index des entrées correspondantes, vide si aucune.
+     * \post Aucune modification des données internes.
+     */
+std::span<const uint32_t> Bottin::trouverAvecCellulaire(const std::string& p_cellulaire) const {
+    if (!estTelephoneValide(p_cellulaire)) {
+        return {};
+    }
+    return m_tableParCellulaire.trouver(StockageEntrees::compacterTelephone(p_cellulaire));
+}
+    /**
+     * \brief Recherche toutes les entrées ayant une adresse courriel donnée.
+     * \param[in] p_courriel Adresse courriel.
+     * \return Les index des entrées correspondantes, vide si aucune.
+     * \post Aucune modification des données internes.
+     */
+std::span<const uint32_t> Bottin::trouverAvecCourriel(const std::string& p_courriel) const {
+    return m_tableParCourriel.trouver(p_courriel);
+}
+    /**
+     * \brief Recherche toutes les entrées d'un indicatif régional.
+     * \param[in] p_indicatif Indicatif au format "(ddd)".
+     * \return Les index des entrées correspondantes, vide si aucune ou si le format est invalide.
+     * \post Aucune modification des données internes.
+     */
+std::span<const uint32_t> Bottin::trouverAvecIndicatif(const std::string& p_indicatif) const {
+    const std::optional<uint64_t> indicatif = lirePrefixeTelephone(p_indicatif, LONGUEUR_INDICATIF);
+    return indicatif ? m_tableParIndicatif.trouver(*indicatif) : std::span<const uint32_t>();
+}
+    /**
+     * \brief Recherche toutes les entrées d'un indicatif et d'un central.
+     * \param[in] p_prefixe Début de numéro au format "(ddd) ddd".
+     * \return Les index des entrées correspondantes, vide si aucune ou si le format est invalide.
+     * \post Aucune modification des données internes.
+     */
+std::span<const uint32_t> Bottin::trouverAvecCentral(const std::string& p_prefixe) const {
+    const std::optional<uint64_t> central = lirePrefixeTelephone(p_prefixe, LONGUEUR_CENTRAL);
+    return central ? m_tableParCentral.trouver(*central) : std::span<const uint32_t>();
+}
+    /**
+     * \brief Compte les entrées d'un indicatif régional.
+     * \param[in] p_indicatif Indicatif au format "(ddd)".
+     * \return Le nombre d'entrées.
+     * \post Aucune modification des données internes.
+     */
+size_t Bottin::compterAvecIndicatif(const std::string& p_indicatif) const {
+    const std::optional<uint64_t> indicatif = lirePrefixeTelephone(p_indicatif, LONGUEUR_INDICATIF);
+    return indicatif ? m_tableParIndicatif.compter(*indicatif) : 0;
+}
+    /**
+     * \brief Compte les entrées d'un indicatif et d'un central.
+     * \param[in] p_prefixe Début de numéro au format "(ddd) ddd".
+     * \return Le nombre d'entrées.
+     * \post Aucune modification des données internes.
+     */
+size_t Bottin::compterAvecCentral(const std::string& p_prefixe) const {
+    const std::optional<uint64_t> central = lirePrefixeTelephone(p_prefixe, LONGUEUR_CENTRAL);
+    return central ? m_tableParCentral.compter(*central) : 0;
+}
+    /**
+     * \brief Recherche les entrées dont la clé « nom prénom » commence par un préfixe.
+     * \param[in] p_prefixe Début de la clé « nom prénom ».
+     * \param[in] p_limite Nombre maximal de résultats retournés.
+     * \return Les index des entrées correspondantes, en ordre alphabétique de clé.
+     * \post Aucune modification des données internes.
+     */
+std::vector<size_t> Bottin::trouverParPrefixe(const std::string& p_prefixe, size_t p_limite) const {
+    const std::string_view prefixe(p_prefixe);
+    auto debut = std::lower_bound(m_indexPrefixe.begin(), m_indexPrefixe.end(), prefixe,
+                                  [this](size_t p_index, std::string_view p_valeur) {
+        return comparerCles(vueCle(m_tableauDesEntrees, p_index), p_valeur, p_valeur.size()) < 0;
+    });
+
+    std::vector<size_t> resultats;
+    for (auto it = debut; it != m_indexPrefixe.end() && resultats.size() < p_limite; ++it) {
+        if (comparerCles(vueCle(m_tableauDesEntrees, *it), prefixe, prefixe.size()) != 0) {
+            break;
+        }
+        resultats.push_back(*it);
+    }
+    return resultats;
+}
+    /**
+     * \brief Recherche les entrées dont la clé « nom prénom » est proche d'une requête.
+     * \param[in] p_requete La clé cherchée, sous la forme « nom prénom ».
+     * \param[in] p_limite Nombre maximal de résultats retournés.
+     * \param[in] p_distanceMax Distance d'édition maximale tolérée.
+     * \return Les index des entrées retenues, par distance croissante puis en ordre alphabétique de clé.
+     * \post Aucune modification des données internes.
+     */
+std::vector<size_t> Bottin::trouverApproximatif(const std::string& p_requete, size_t p_limite,
+                                                size_t p_distanceMax) const {
+    const std::string requete = IndexTrigrammes::normaliser(p_requete);
+
+    std::vector<std::pair<size_t, size_t> > retenus; // (distance, index)
+    for (size_t index : m_indexTrigrammes.candidats(requete, p_distanceMax)) {
+        const size_t distance = IndexTrigrammes::distanceBornee(
+                requete, IndexTrigrammes::normaliser(_texteNomPrenom(index)), p_distanceMax);
+        if (distance <= p_distanceMax) {
+            retenus.emplace_back(distance, index);
+        }
+    }
+
+    const size_t nombre = std::min(p_limite, retenus.size());
+    std::partial_sort(retenus.begin(), retenus.begin() + nombre, retenus.end(),
+                      [this](const std::pair<size_t, size_t>& p_a, const std::pair<size_t, size_t>& p_b) {
+        if (p_a.first != p_b.first) return p_a.first < p_b.first;
+        return comparerCles(vueCle(m_tableauDesEntrees, p_a.second), vueCle(m_tableauDesEntrees, p_b.second),
+                            SANS_LIMITE) < 0;
+    });
+
+    std::vector<size_t> resultats;
+    resultats.reserve(nombre);
+    for (size_t i = 0; i < nombre; ++i) {
+        resultats.push_back(retenus[i].second);
+    }
+    return resultats;
+}
+    /**
+     * \brief Retourne l'entrée à un index donné.
+     * \param[in] p_index Index de l'entrée.
+     * \return Une vue sur l'entrée.
+     * \pre L'index désigne une entrée du bottin.
+     * \post Aucune modification des données internes.
+     */
+Bottin::Entree Bottin::reqEntree(size_t p_index) const {
+    PRECONDITION(p_index < m_tableauDesEntrees.taille() && "L'index est invalide.");
+    PRECONDITION(m_tableauDesEntrees.estActive(p_index) && "L'entrée a été supprimée.");
+    return _entree(p_index);
+}
+    /**
+     * \brief Insère une entrée à sa place dans l'index trié par clé « nom prénom ».
+     * \details Pendant le chargement du fichier, l'insertion est différée et l'index est trié une fois à la fin.
+     * \param[in] p_index Index de l'entrée dans le tableau des entrées.
+     */
+void Bottin::_insererIndexPrefixe(size_t p_index) {
+    if (m_differerIndexPrefixe) {
+        m_indexPrefixe.push_back(p_index);
+        return;
+    }
+    const VueCleNomPrenom cle = vueCle(m_tableauDesEntrees, p_index);
+    auto position = std::upper_bound(m_indexPrefixe.begin(), m_indexPrefixe.end(), cle,
+                                     [this](const VueCleNomPrenom& p_cle, size_t p_autre) {
+        return comparerCles(p_cle, vueCle(m_tableauDesEntrees, p_autre), SANS_LIMITE) < 0;
+    });
+    m_indexPrefixe.insert(position, p_index);
+}
+    /**
+     * \brief Retire une entrée de l'index trié par clé « nom prénom ».
+     * \details Des couples distincts peuvent donner la même clé (« Adams Jr » « Theodore E » et
+     * « Adams » « Jr Theodore E ») : l'entrée est cherchée parmi les clés égales.
+     * \param[in] p_index Index de l'entrée, qui doit encore contenir son nom et son prénom.
+     */
+void Bottin::_retirerIndexPrefixe(size_t p_index) {
+    const VueCleNomPrenom cle = vueCle(m_tableauDesEntrees, p_index);
+    auto position = std::lower_bound(m_indexPrefixe.begin(), m_indexPrefixe.end(), cle,
+                                     [this](size_t p_autre, const VueCleNomPrenom& p_cle) {
+        return comparerCles(vueCle(m_tableauDesEntrees, p_autre), p_cle, SANS_LIMITE) < 0;
+    });
+    while (position != m_indexPrefixe.end() && *position != p_index
+           && comparerCles(vueCle(m_tableauDesEntrees, *position), cle, SANS_LIMITE) == 0) {
+        ++position;
+    }
+    ASSERTION(position != m_indexPrefixe.end() && *position == p_index);
+    m_indexPrefixe.erase(position);
+}
+    /**
+     * \brief Trie l'index des préfixes selon la clé « nom prénom ».
+     */
+void Bottin::_trierIndexPrefixe() {
+    MESURER_PHASE(labTableHachage::Phase::BOTTIN_TRI_PREFIXES);
+    const auto inferieur = [this](size_t p_a, size_t p_b) {
+        return comparerCles(vueCle(m_tableauDesEntrees, p_a), vueCle(m_tableauDesEntrees, p_b), SANS_LIMITE) < 0;
+    };
+    const size_t nombre = m_indexPrefixe.size();
+    if (nombre < SEUIL_PARALLELE) {
+        std::sort(m_indexPrefixe.begin(), m_indexPrefixe.end(), inferieur);
+        return;
+    }
+    // Trier les blocs en parallèle, puis fusionner les séquences triées deux à deux, chaque passe en parallèle
+    const auto debut = m_indexPrefixe.begin();
+    _executerParLots(nombre, [&](size_t p_debut, size_t p_fin) {
+        std::sort(debut + p_debut, debut + p_fin, inferieur);
+    });
+    for (size_t largeur = TAILLE_BLOC_PARALLELE; largeur < nombre; largeur *= 2) {
+        const size_t nbPaires = (nombre + 2 * largeur - 1) / (2 * largeur);
+        _travailleurs().executerEnParallele(nbPaires, 1, [&](size_t p_premiere, size_t p_derniere) {
+            for (size_t paire = p_premiere; paire < p_derniere; ++paire) {
+                const size_t gauche = paire * 2 * largeur;
+                const size_t milieu = std::min(gauche + largeur, nombre);
+                const size_t droite = std::min(gauche + 2 * largeur, nombre);
+                std::inplace_merge(debut + gauche, debut + milieu, debut + droite, inferieur);
+            }
+        });
+    }
+}
+    /**
+     * \brief Formate les entrées actives dans un tampon écrit par blocs d'environ TAILLE_TAMPON_EXPORT octets.
+     * \param[out] p_sortie Flux de sortie.
+     * \param[in] p_ordre Ordre des lignes.
+     * \param[in] p_separateur Séparateur des champs après « nom, prénom ».
+     */
+void Bottin::_ecrireEntrees(std::ostream& p_sortie, OrdreExport p_ordre, std::string_view p_separateur) const {
+    std::string tampon;
+    tampon.reserve(TAILLE_TAMPON_EXPORT + 1024);
+    char telephone[LONGUEUR_TELEPHONE];
+
+    const auto ecrireLigne = [&](size_t p_index) {
+        tampon.append(m_tableauDesEntrees.nom(p_index)).append(", ").append(m_tableauDesEntrees.prenom(p_index));
+        tampon.append(p_separateur);
+        StockageEntrees::formaterTelephone(m_tableauDesEntrees.telephoneFixe(p_index), telephone);
+        tampon.append(telephone, LONGUEUR_TELEPHONE).append(p_separateur);
+        StockageEntrees::formaterTelephone(m_tableauDesEntrees.cellulaire(p_index), telephone);
+        tampon.append(telephone, LONGUEUR_TELEPHONE).append(p_separateur);
+        tampon.append(m_tableauDesEntrees.courriel(p_index)).push_back('\n');
+        if (tampon.size() >= TAILLE_TAMPON_EXPORT) {
+            p_sortie.write(tampon.data(), static_cast<std::streamsize>(tampon.size()));
+            tampon.clear();
+        }
+    };
+
+    if (p_ordre == OrdreExport::NOM) {
+        for (size_t index : m_indexPrefixe) {
+            ecrireLigne(index);
+        }
+    } else {
+        for (size_t i = 0; i < m_tableauDesEntrees.taille(); ++i) {
+            if (!m_tableauDesEntrees.estActive(i)) continue; // position libérée par supprimer()
+            ecrireLigne(i);
+        }
+    }
+    p_sortie.write(tampon.data(), static_cast<std::streamsize>(tampon.size()));
+}
+    /**
+     * \brief Retourne la clé « nom prénom » d'une entrée, telle qu'indexée par trigrammes.
+     * \param[in] p_index Index d'une entrée active.
+     * \return Le nom et le prénom séparés par une espace.
+     */
+std::string Bottin::_texteNomPrenom(size_t p_index) const {
+    std::string texte(m_tableauDesEntrees.nom(p_index));
+    texte += ' ';
+    texte += m_tableauDesEntrees.prenom(p_index);
+    return texte;
 }
     /**
  * \brief Retourne le nombre d'entrées dans le bottin.
  * \return Le nombre total d'entrées.
  * \post Aucune modification des données internes.
  */
-int Bottin::nombreEntrees() const {
-    return m_tableauDesEntrees.size();
+size_t Bottin::nombreEntrees() const {
+    return m_tableauDesEntrees.taille() - m_positionsLibres.size();
 }
 
 /**
@@ -171,8 +755,8 @@ int Bottin::nombreEntrees() const {
  */
 double Bottin::ratioDeCollisionsNomPrenom() const {
     double ratio = 0.0;
-    int nbCollisions, maxCollisions;
-    m_tableParNomPrenom.statistiques(ratio, nbCollisions, maxCollisions);
+    size_t nbCollisions, maxCollisions;
+    statistiquesNomPrenom(ratio, nbCollisions, maxCollisions);
     return ratio;
 }
  /**
@@ -182,8 +766,8 @@ double Bottin::ratioDeCollisionsNomPrenom() const {
      */
 double Bottin::ratioDeCollisionTelephone() const {
     double ratio = 0.0;
-    int nbCollisions, maxCollisions;
-    m_tableParTelephone.statistiques(ratio, nbCollisions, maxCollisions);
+    size_t nbCollisions, maxCollisions;
+    statistiquesTelephone(ratio, nbCollisions, maxCollisions);
     return ratio;
 }
     /**
@@ -191,10 +775,10 @@ double Bottin::ratioDeCollisionTelephone() const {
      * \return Le nombre maximal de collisions.
      * \post Aucune modification des données internes.
      */
-int Bottin::maximumNbCollisionNomPrenom() const {
+size_t Bottin::maximumNbCollisionNomPrenom() const {
     double ratio;
-    int nbCollisions, maxCollisions;
-    m_tableParNomPrenom.statistiques(ratio, nbCollisions, maxCollisions);
+    size_t nbCollisions, maxCollisions;
+    statistiquesNomPrenom(ratio, nbCollisions, maxCollisions);
     return maxCollisions;
 }
     /**
@@ -202,10 +786,10 @@ int Bottin::maximumNbCollisionNomPrenom() const {
      * \return Le nombre maximal de collisions.
      * \post Aucune modification des données internes.
      */
-int Bottin::maximumNbCollisionTelephone() const {
+size_t Bottin::maximumNbCollisionTelephone() const {
     double ratio;
-    int nbCollisions, maxCollisions;
-    m_tableParTelephone.statistiques(ratio, nbCollisions, maxCollisions);
+    size_t nbCollisions, maxCollisions;
+    statistiquesTelephone(ratio, nbCollisions, maxCollisions);
     return maxCollisions;
 }
     /**
@@ -214,8 +798,16 @@ int Bottin::maximumNbCollisionTelephone() const {
  * \param[out] p_nbCollisions Nombre total de collisions.
  * \param[out] p_maximumCollisionUneInsertion Nombre maximal de collisions pour une seule insertion.
  * \post Aucune modification des données internes.
+ * \note Une fois le bottin figé, les statistiques sont nulles : chaque recherche se fait en un accès.
  */
-    void Bottin::statistiquesNomPrenom(double& p_ratio, int& p_nbCollisions, int& p_maximumCollisionUneInsertion) const {
+    void Bottin::statistiquesNomPrenom(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const {
+    if (m_estFige) {
+        // Une table figée n'a aucune redistribution
+        p_ratio = 0.0;
+        p_nbCollisions = 0;
+        p_maximumCollisionUneInsertion = 0;
+        return;
+    }
     m_tableParNomPrenom.statistiques(p_ratio, p_nbCollisions, p_maximumCollisionUneInsertion);
 }
     /**
@@ -224,8 +816,215 @@ int Bottin::maximumNbCollisionTelephone() const {
      * \param[out] p_nbCollisions Nombre total de collisions.
      * \param[out] p_maximumCollisionUneInsertion Nombre maximal de collisions pour une seule insertion.
      * \post Aucune modification des données internes.
+     * \note Une fois le bottin figé, les statistiques sont nulles : chaque recherche se fait en un accès.
      */
-    void Bottin::statistiquesTelephone(double& p_ratio, int& p_nbCollisions, int& p_maximumCollisionUneInsertion) const {
+    void Bottin::statistiquesTelephone(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const {
+    if (m_estFige) {
+        // Une table figée n'a aucune redistribution
+        p_ratio = 0.0;
+        p_nbCollisions = 0;
+        p_maximumCollisionUneInsertion = 0;
+        return;
+    }
     m_tableParTelephone.statistiques(p_ratio, p_nbCollisions, p_maximumCollisionUneInsertion);
+}
+    /**
+     * \brief Fige le bottin en remplaçant ses index par des tables de hachage parfaites.
+     * \details Les tables dynamiques sont libérées une fois les tables figées construites.
+     * \pre Le bottin n'est pas déjà figé.
+     * \post Les recherches passent par les index figés et donnent les mêmes résultats.
+     */
+void Bottin::figer() {
+    PRECONDITION(!m_estFige && "Le bottin est déjà figé");
+
+    m_indexFigeNomPrenom = IndexFigeNomPrenom(m_tableParNomPrenom);
+    m_indexFigeTelephone = IndexFigeTelephone(m_tableParTelephone);
+    m_tableParNomPrenom = IndexNomPrenom(ExtracteurNomPrenom{&m_tableauDesEntrees}, 100,
+                                         m_tableParNomPrenom.reqHachage(), m_tableParNomPrenom.reqEgalite());
+    m_tableParTelephone = IndexTelephone(ExtracteurTelephone{&m_tableauDesEntrees});
+    m_estFige = true;
+
+    POSTCONDITION(m_indexFigeNomPrenom.taille() == nombreEntrees());
+    POSTCONDITION(m_indexFigeTelephone.taille() == nombreEntrees());
+}
+    /**
+     * \brief Indique si le bottin a été figé.
+     * \return Vrai si figer() a été appelé.
+     * \post Aucune modification des données internes.
+     */
+bool Bottin::estFige() const {
+    return m_estFige;
+}
+    /**
+     * \brief Retourne la façon dont les clés nom/prénom sont comparées.
+     * \return Le mode choisi à la construction.
+     * \post Aucune modification des données internes.
+     */
+Bottin::ComparaisonNoms Bottin::comparaisonNoms() const {
+    return m_tableParNomPrenom.reqHachage().m_normaliser ? ComparaisonNoms::NORMALISEE : ComparaisonNoms::EXACTE;
+}
+    /**
+     * \brief Construit les filtres de Bloom des index nom/prénom et téléphone.
+     * \param[in] p_bitsParCle Bits de filtre par entrée.
+     * \pre p_bitsParCle est positif.
+     * \post Les recherches écartent par les filtres la plupart des clés absentes.
+     */
+void Bottin::activerFiltresBloom(size_t p_bitsParCle) {
+    PRECONDITION(p_bitsParCle > 0);
+    m_bitsParCle = p_bitsParCle;
+    _reconstruireFiltres();
+    m_filtresActifs = true;
+}
+    /**
+     * \brief Indique si les filtres de Bloom sont actifs.
+     * \return Vrai si activerFiltresBloom() a été appelé.
+     * \post Aucune modification des données internes.
+     */
+bool Bottin::filtresBloomActifs() const {
+    return m_filtresActifs;
+}
+    /**
+     * \brief Ajoute les clés d'une entrée aux filtres actifs, en les reconstruisant s'ils sont pleins.
+     * \param[in] p_index Index d'une entrée active, déjà dans les index.
+     */
+void Bottin::_ajouterAuxFiltres(size_t p_index) {
+    if (!m_filtresActifs) {
+        return;
+    }
+    if (m_filtreTelephone.nombreElements() >= m_filtreTelephone.capacite()
+        || m_tableParNomPrenom.nombreRegenerationsGraine() != m_grainesFiltreNomPrenom) {
+        // Filtre plein, ou hachages nom/prénom changés avec la graine de l'index.
+        // Les clés de l'entrée sont déjà dans les index : la reconstruction les inclut
+        _reconstruireFiltres();
+        return;
+    }
+    m_filtreNomPrenom.ajouter(m_tableParNomPrenom.reqHachage()(
+            CleNomPrenom{m_tableauDesEntrees.nom(p_index), m_tableauDesEntrees.prenom(p_index)}));
+    m_filtreTelephone.ajouter(m_tableauDesEntrees.telephoneFixe(p_index));
+}
+    /**
+     * \brief Reconstruit les filtres à partir des entrées actives, avec une capacité double.
+     * \details Les bits des entrées supprimées ou modifiées sont éliminés du même coup.
+     */
+void Bottin::_reconstruireFiltres() {
+    const size_t capacite = std::max<size_t>(64, 2 * nombreEntrees());
+    m_filtreNomPrenom = labTableHachage::FiltreBloom(capacite, m_bitsParCle);
+    m_filtreTelephone = labTableHachage::FiltreBloom(capacite, m_bitsParCle);
+    const HCleNomPrenom& hachage = m_tableParNomPrenom.reqHachage();
+    m_grainesFiltreNomPrenom = m_tableParNomPrenom.nombreRegenerationsGraine();
+    for (size_t i = 0; i < m_tableauDesEntrees.taille(); ++i) {
+        if (!m_tableauDesEntrees.estActive(i)) continue;
+        m_filtreNomPrenom.ajouter(hachage(CleNomPrenom{m_tableauDesEntrees.nom(i), m_tableauDesEntrees.prenom(i)}));
+        m_filtreTelephone.ajouter(m_tableauDesEntrees.telephoneFixe(i));
+    }
+}
+    /**
+     * \brief Consulte le filtre nom/prénom.
+     * \param[in] p_cle La clé nom/prénom.
+     * \return Faux si la clé est sûrement absente; toujours vrai sans filtre.
+     */
+bool Bottin::_nomPrenomPeutExister(const CleNomPrenom& p_cle) const {
+    return !m_filtresActifs || m_filtreNomPrenom.peutContenir(m_tableParNomPrenom.reqHachage()(p_cle));
+}
+    /**
+     * \brief Consulte le filtre des téléphones.
+     * \param[in] p_telephoneFixe Le numéro de téléphone fixe compacté.
+     * \return Faux si le numéro est sûrement absent; toujours vrai sans filtre.
+     */
+bool Bottin::_telephonePeutExister(uint64_t p_telephoneFixe) const {
+    return !m_filtresActifs || m_filtreTelephone.peutContenir(p_telephoneFixe);
+}
+    /**
+     * \brief Cherche l'index d'une entrée par sa clé nom/prénom, dans l'index figé ou dynamique.
+     * \param[in] p_cle La clé nom/prénom.
+     * \return L'index de l'entrée, ou rien si la clé est absente.
+     */
+std::optional<size_t> Bottin::_chercherNomPrenom(const CleNomPrenom& p_cle) const {
+    if (!_nomPrenomPeutExister(p_cle)) {
+        return std::nullopt;
+    }
+    if (m_estFige) {
+        return m_indexFigeNomPrenom.trouver(p_cle);
+    }
+    return m_tableParNomPrenom.trouver(p_cle);
+}
+    /**
+     * \brief Cherche l'index d'une entrée par son téléphone fixe, dans l'index figé ou dynamique.
+     * \param[in] p_telephoneFixe Le numéro de téléphone fixe compacté.
+     * \return L'index de l'entrée, ou rien si le numéro est absent.
+     */
+std::optional<size_t> Bottin::_chercherTelephone(uint64_t p_telephoneFixe) const {
+    if (!_telephonePeutExister(p_telephoneFixe)) {
+        return std::nullopt;
+    }
+    if (m_estFige) {
+        return m_indexFigeTelephone.trouver(p_telephoneFixe);
+    }
+    return m_tableParTelephone.trouver(p_telephoneFixe);
+}
+    /**
+     * \brief Construit la vue sur une entrée à partir de ses colonnes.
+     * \param[in] p_index Index d'une entrée active.
+     * \return La vue sur l'entrée, avec ses téléphones formatés.
+     */
+Bottin::Entree Bottin::_entree(size_t p_index) const {
+    return Entree(m_tableauDesEntrees.nom(p_index), m_tableauDesEntrees.prenom(p_index),
+                  StockageEntrees::formaterTelephone(m_tableauDesEntrees.telephoneFixe(p_index)),
+                  StockageEntrees::formaterTelephone(m_tableauDesEntrees.cellulaire(p_index)),
+                  m_tableauDesEntrees.courriel(p_index));
+}
+    /**
+     * \brief Applique une fonction aux blocs d'un lot, dans l'appelant ou réparti entre les fils.
+     * \param[in] p_nombre Taille du lot.
+     * \param[in] p_fonction Fonction appelée avec (début, fin) de chaque bloc.
+     */
+void Bottin::_executerParLots(size_t p_nombre, const std::function<void(size_t, size_t)>& p_fonction) const {
+    if (p_nombre < SEUIL_PARALLELE) {
+        if (p_nombre > 0) p_fonction(0, p_nombre);
+        return;
+    }
+    _travailleurs().executerEnParallele(p_nombre, TAILLE_BLOC_PARALLELE, p_fonction);
+}
+    /**
+     * \brief Retourne les fils du bottin, créés au premier besoin.
+     * \return Le groupe partagé par les lots et les rehachages des grands index.
+     */
+GroupeTravailleurs& Bottin::_travailleurs() const {
+    std::call_once(m_creationTravailleurs, [this]() { m_travailleurs = std::make_unique<GroupeTravailleurs>(); });
+    return *m_travailleurs;
+}
+    /**
+     * \brief Hache la clé nom/prénom en combinant le hachage du nom et celui du prénom.
+     * \param[in] p_cle La clé nom/prénom.
+     * \return La valeur de hachage.
+     */
+size_t Bottin::HCleNomPrenom::operator()(const CleNomPrenom& p_cle) const {
+    if (m_normaliser) {
+        return m_normalise(p_cle.m_nom) ^ (m_normalise(p_cle.m_prenom) * 0x9e3779b97f4a7c15ull);
+    }
+    return m_exact(p_cle.m_nom) ^ (m_exact(p_cle.m_prenom) * 0x9e3779b97f4a7c15ull);
+}
+    /**
+     * \brief Tire une nouvelle graine, à la demande de l'index après une insertion trop longue.
+     */
+void Bottin::HCleNomPrenom::regenererGraine() {
+    if (m_normaliser) {
+        m_normalise.regenererGraine();
+    } else {
+        m_exact.regenererGraine();
+    }
+}
+    /**
+     * \brief Compare deux clés nom/prénom, octet par octet ou après normalisation.
+     * \param[in] p_a Première clé.
+     * \param[in] p_b Seconde clé.
+     * \return Vrai si les clés sont égales selon le mode de comparaison.
+     */
+bool Bottin::EgaliteCleNomPrenom::operator()(const CleNomPrenom& p_a, const CleNomPrenom& p_b) const {
+    if (m_normaliser) {
+        labTableHachage::EgaliteNormalisee egalite;
+        return egalite(p_a.m_nom, p_b.m_nom) && egalite(p_a.m_prenom, p_b.m_prenom);
+    }
+    return p_a == p_b;
 }
 } // namespace TP3
\ No newline at end of file
@@ -11,8 +11,24 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include "TableHachage.h"
+#include <optional>
+#include <string_view>
+#include <span>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "AllocateurPagesGeantes.h"
+#include "TableHachageIndex.h"
+#include "TableHachageIndexFigee.h"
+#include "TableHachageMulti.h"
 #include "FoncteurHachage.hpp"
+#include "ValidateurEntree.h"
+#include "StockageEntrees.h"
+#include "IndexTrigrammes.h"
+#include "GroupeTravailleurs.h"
+#include "FiltreBloom.h"
 
 namespace TP3 {
     /**
@@ -28,15 +44,18 @@ public:
  * \class Entree
  * \brief Représente une entrée individuelle dans le bottin.
  * \details Chaque entrée contient un nom, un prénom, un numéro de téléphone fixe, un numéro de téléphone cellulaire, et un courriel.
+ * Une Entree est une vue sur le stockage du bottin : le nom, le prénom et le courriel désignent ses bassins
+ * de caractères et restent valides jusqu'à la prochaine modification du bottin. Les téléphones, stockés
+ * compactés, sont remis au format (ddd) ddd-dddd.
  */
     class Entree {
 
     public:
-        std::string m_nom;
-        std::string m_prenom;
+        std::string_view m_nom;
+        std::string_view m_prenom;
         std::string m_telephoneFixe;
         std::string m_cellulaire;
-        std::string m_courriel;
+        std::string_view m_courriel;
         /**
 * \brief Constructeur de la classe Entree.
 * \param[in] p_nom Nom de la personne.
@@ -46,11 +65,11 @@ public:
 * \param[in] p_courriel Adresse courriel.
 */
 
-        Entree(const std::string& p_nom, const std::string& p_prenom,
-               const std::string& p_telephoneFixe, const std::string& p_cellulaire,
-               const std::string& p_courriel)
+        Entree(std::string_view p_nom, std::string_view p_prenom,
+               std::string p_telephoneFixe, std::string p_cellulaire,
+               std::string_view p_courriel)
             : m_nom(p_nom), m_prenom(p_prenom),
-              m_telephoneFixe(p_telephoneFixe), m_cellulaire(p_cellulaire),
+              m_telephoneFixe(std::move(p_telephoneFixe)), m_cellulaire(std::move(p_cellulaire)),
               m_courriel(p_courriel) {}
         /**
          * \brief Surcharge de l'opérateur `<<` pour afficher une entrée.
@@ -65,14 +84,38 @@ public:
         }
     };
     /**
+     * \enum ComparaisonNoms
+     * \brief Façon de comparer les clés nom/prénom dans l'index des noms.
+     */
+    enum class ComparaisonNoms {
+        EXACTE, /*!< octet par octet */
+        NORMALISEE /*!< sans égard à la casse ni aux accents : "adam carl" trouve "Adam, Carl" */
+    };
+    /**
+     * \enum OrdreExport
+     * \brief Ordre des lignes écrites par exporterTSV().
+     */
+    enum class OrdreExport {
+        INSERTION, /*!< ordre des positions dans le tableau des entrées */
+        NOM /*!< ordre octet par octet de la clé « nom prénom », quelle que soit la comparaison des noms */
+    };
+    /**
  * \brief Constructeur de la classe Bottin.
  * \param[in] p_fichierEntree Fichier contenant les données à insérer dans le bottin.
  * \param[in] p_table_size Taille initiale des tables de hachage (valeur par défaut : 100).
+ * \param[in] p_comparaisonNoms Comparaison des clés nom/prénom; en mode normalisé, deux entrées
+ * ne peuvent pas différer seulement par la casse ou les accents.
  * \pre Le fichier doit être ouvert et contenir des données valides.
  * \post Le bottin est initialisé avec les données du fichier.
  */
 
-    Bottin(std::ifstream& p_fichierEntree, size_t p_table_size = 100);
+    Bottin(std::ifstream& p_fichierEntree, size_t p_table_size = 100,
+           ComparaisonNoms p_comparaisonNoms = ComparaisonNoms::EXACTE);
+    /**
+     * \brief Un bottin n'est pas copiable : ses index désignent son propre tableau d'entrées.
+     */
+    Bottin(const Bottin&) = delete;
+    Bottin& operator=(const Bottin&) = delete;
     /**
      * \brief Ajoute une nouvelle entrée au bottin.
      * \param[in] p_nom Nom de la personne.
@@ -87,31 +130,164 @@ public:
     void ajouter(const std::string& p_nom, const std::string& p_prenom,
                  const std::string& p_telephoneFixe, const std::string& p_cellulaire,
                  const std::string& p_courriel);
+    /**
+     * \brief Supprime une entrée du bottin; sa position sera réutilisée par un prochain ajout.
+     * \param[in] p_nom Nom de la personne.
+     * \param[in] p_prenom Prénom de la personne.
+     * \pre Le bottin n'est pas figé et l'entrée existe.
+     * \post L'entrée n'est plus accessible par aucune recherche.
+     */
+    void supprimer(const std::string& p_nom, const std::string& p_prenom);
+    /**
+     * \brief Modifie une entrée sur place en ne mettant à jour que les index dont la clé change.
+     * \param[in] p_nom Nom actuel de la personne.
+     * \param[in] p_prenom Prénom actuel de la personne.
+     * \param[in] p_nouveauNom Nouveau nom.
+     * \param[in] p_nouveauPrenom Nouveau prénom.
+     * \param[in] p_telephoneFixe Nouveau numéro de téléphone fixe.
+     * \param[in] p_cellulaire Nouveau numéro de téléphone cellulaire.
+     * \param[in] p_courriel Nouvelle adresse courriel.
+     * \pre Mêmes règles que pour ajouter(); le bottin n'est pas figé et l'entrée existe.
+     * \post L'entrée est accessible par ses nouvelles clés et plus par les anciennes.
+     */
+    void modifier(const std::string& p_nom, const std::string& p_prenom,
+                  const std::string& p_nouveauNom, const std::string& p_nouveauPrenom,
+                  const std::string& p_telephoneFixe, const std::string& p_cellulaire,
+                  const std::string& p_courriel);
 
     void afficherBottin(std::ostream& p_out) const;
     /**
+     * \brief Écrit le bottin au format du fichier lu par le constructeur (TSV).
+     * \details Les lignes sont formatées dans un tampon d'environ 1 Mo écrit d'un bloc : le flux n'est
+     * ni sollicité ligne par ligne ni vidé avant la fin. L'ordre par nom suit l'index de préfixes, déjà trié.
+     * \param[out] p_sortie Flux de sortie.
+     * \param[in] p_ordre Ordre des lignes.
+     * \post Un Bottin construit sur le texte écrit contient les mêmes entrées.
+     */
+    void exporterTSV(std::ostream& p_sortie, OrdreExport p_ordre = OrdreExport::NOM) const;
+    /**
  * \brief Recherche une entrée par nom et prénom.
  * \param[in] p_nom Nom de la personne.
  * \param[in] p_prenom Prénom de la personne.
- * \return Une référence constante vers l'entrée correspondante.
+ * \return Une vue sur l'entrée correspondante.
  * \pre Les paramètres `p_nom` et `p_prenom` ne doivent pas être vides.
  * \throw std::runtime_error si aucune entrée correspondante n'est trouvée.
  */
 
-    const Entree& trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const;
+    Entree trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const;
     /**
  * \brief Recherche une entrée par numéro de téléphone fixe.
  * \param[in] p_telephoneFixe Numéro de téléphone fixe.
- * \return Une référence constante vers l'entrée correspondante.
+ * \return Une vue sur l'entrée correspondante.
  * \pre Le paramètre `p_telephoneFixe` ne doit pas être vide.
  * \throw std::runtime_error si aucune entrée correspondante n'est trouvée.
  */
-    const Entree& trouverAvecTelephone(const std::string& p_telephoneFixe) const;
+    Entree trouverAvecTelephone(const std::string& p_telephoneFixe) const;
+    /**
+     * \brief Recherche une entrée par nom et prénom, sans exception si elle est absente.
+     * \param[in] p_nom Nom de la personne.
+     * \param[in] p_prenom Prénom de la personne.
+     * \return Une vue sur l'entrée correspondante, ou rien si elle est absente.
+     */
+    std::optional<Entree> chercherAvecNomPrenom(std::string_view p_nom, std::string_view p_prenom) const;
+    /**
+     * \brief Recherche une entrée par numéro de téléphone fixe, sans exception s'il est absent ou mal formé.
+     * \param[in] p_telephoneFixe Numéro de téléphone fixe.
+     * \return Une vue sur l'entrée correspondante, ou rien si le numéro est absent.
+     */
+    std::optional<Entree> chercherAvecTelephone(std::string_view p_telephoneFixe) const;
+    /**
+     * \brief Recherche un lot de numéros de téléphone fixe, sans exception pour les numéros absents.
+     * \details Les clés sont hachées et leurs cases préchargées par petits groupes; un lot assez grand
+     * est réparti entre les fils d'un GroupeTravailleurs créé au premier besoin. Plusieurs lots peuvent
+     * être cherchés en même temps tant que le bottin n'est pas modifié.
+     * \param[in] p_telephones Les numéros cherchés.
+     * \param[out] p_resultats Pour chaque numéro, l'index de l'entrée (voir reqEntree()) ou rien s'il est absent.
+     * \pre p_resultats a au moins autant de cases que p_telephones.
+     */
+    void trouverPlusieursAvecTelephone(std::span<const std::string> p_telephones,
+                                       std::span<std::optional<size_t> > p_resultats) const;
+    /**
+     * \brief Recherche un lot de clés nom/prénom, sans exception pour les clés absentes.
+     * \details Même traitement que trouverPlusieursAvecTelephone().
+     * \param[in] p_nomsPrenoms Les paires (nom, prénom) cherchées.
+     * \param[out] p_resultats Pour chaque paire, l'index de l'entrée ou rien si elle est absente.
+     * \pre p_resultats a au moins autant de cases que p_nomsPrenoms.
+     */
+    void trouverPlusieursAvecNomPrenom(std::span<const std::pair<std::string, std::string> > p_nomsPrenoms,
+                                       std::span<std::optional<size_t> > p_resultats) const;
+    /**
+     * \brief Recherche toutes les entrées ayant un numéro de cellulaire donné.
+     * \param[in] p_cellulaire Numéro de cellulaire.
+     * \return Les index des entrées correspondantes (vide si aucune), utilisables avec reqEntree().
+     * La plage reste valide jusqu'à la prochaine modification du bottin.
+     */
+    std::span<const uint32_t> trouverAvecCellulaire(const std::string& p_cellulaire) const;
+    /**
+     * \brief Recherche toutes les entrées ayant une adresse courriel donnée.
+     * \param[in] p_courriel Adresse courriel.
+     * \return Les index des entrées correspondantes (vide si aucune), utilisables avec reqEntree().
+     * La plage reste valide jusqu'à la prochaine modification du bottin.
+     */
+    std::span<const uint32_t> trouverAvecCourriel(const std::string& p_courriel) const;
+    /**
+     * \brief Recherche toutes les entrées dont le téléphone fixe a un indicatif régional donné.
+     * \param[in] p_indicatif Indicatif au format du début d'un numéro, par exemple "(530)".
+     * \return Les index des entrées correspondantes (vide si aucune ou si le format est invalide),
+     * dans un ordre quelconque. La plage reste valide jusqu'à la prochaine modification du bottin.
+     */
+    std::span<const uint32_t> trouverAvecIndicatif(const std::string& p_indicatif) const;
+    /**
+     * \brief Recherche toutes les entrées dont le téléphone fixe commence par un indicatif et un central.
+     * \param[in] p_prefixe Début d'un numéro jusqu'au central, par exemple "(530) 752".
+     * \return Comme trouverAvecIndicatif().
+     */
+    std::span<const uint32_t> trouverAvecCentral(const std::string& p_prefixe) const;
+    /**
+     * \brief Compte les entrées d'un indicatif régional, en un sondage.
+     * \param[in] p_indicatif Indicatif, par exemple "(530)".
+     * \return Le nombre d'entrées, 0 si le format est invalide.
+     */
+    size_t compterAvecIndicatif(const std::string& p_indicatif) const;
+    /**
+     * \brief Compte les entrées d'un indicatif et d'un central, en un sondage.
+     * \param[in] p_prefixe Début d'un numéro, par exemple "(530) 752".
+     * \return Le nombre d'entrées, 0 si le format est invalide.
+     */
+    size_t compterAvecCentral(const std::string& p_prefixe) const;
+    /**
+     * \brief Recherche les entrées dont la clé « nom prénom » commence par un préfixe.
+     * \details Le préfixe peut ne porter que sur le début du nom ("Adam") ou couvrir le nom et le
+     * début du prénom ("Adams T"). Les résultats sont en ordre alphabétique de clé; le coût est
+     * logarithmique en nombre d'entrées plus linéaire en nombre de résultats retournés.
+     * \param[in] p_prefixe Début de la clé « nom prénom ».
+     * \param[in] p_limite Nombre maximal de résultats retournés.
+     * \return Les index des entrées correspondantes, utilisables avec reqEntree().
+     */
+    std::vector<size_t> trouverParPrefixe(const std::string& p_prefixe, size_t p_limite) const;
+    /**
+     * \brief Recherche les entrées dont la clé « nom prénom » est proche d'une requête mal orthographiée.
+     * \details Les candidats sont tirés de l'index de trigrammes puis classés par distance d'édition
+     * (sans égard à la casse ni aux accents), à égalité en ordre alphabétique de clé.
+     * \param[in] p_requete La clé cherchée, sous la forme « nom prénom ».
+     * \param[in] p_limite Nombre maximal de résultats retournés.
+     * \param[in] p_distanceMax Distance d'édition maximale tolérée.
+     * \return Les index des entrées retenues, les plus proches d'abord, utilisables avec reqEntree().
+     */
+    std::vector<size_t> trouverApproximatif(const std::string& p_requete, size_t p_limite,
+                                            size_t p_distanceMax = 2) const;
+    /**
+     * \brief Retourne l'entrée à un index donné.
+     * \param[in] p_index Index d'une entrée, tel que retourné par trouverParPrefixe().
+     * \return Une vue sur l'entrée.
+     * \pre L'index désigne une entrée du bottin.
+     */
+    Entree reqEntree(size_t p_index) const;
     /**
      * \brief Retourne le nombre total d'entrées dans le bottin.
      * \return Nombre d'entrées dans le bottin.
      */
-    int nombreEntrees() const;
+    size_t nombreEntrees() const;
     /**
      * \brief Calcule le ratio de collisions pour les entrées Nom/Prénom.
      * \return Le ratio des collisions.
@@ -126,12 +302,12 @@ public:
      * \brief Retourne le nombre maximal de collisions pour une insertion dans la table Nom/Prénom.
      * \return Le nombre maximal de collisions.
      */
-    int maximumNbCollisionNomPrenom() const;
+    size_t maximumNbCollisionNomPrenom() const;
     /**
  * \brief Retourne le nombre maximal de collisions pour une insertion dans la table Téléphone.
  * \return Le nombre maximal de collisions.
  */
-    int maximumNbCollisionTelephone() const;
+    size_t maximumNbCollisionTelephone() const;
 
     /**
   * \brief Calcule les statistiques des collisions pour la table Nom/Prénom.
@@ -139,20 +315,169 @@ public:
   * \param[out] p_nbCollisions Nombre total de collisions.
   * \param[out] p_maximumCollisionUneInsertion Nombre maximal de collisions pour une seule insertion.
   */
-    void statistiquesNomPrenom(double& p_ratio, int& p_nbCollisions, int& p_maximumCollisionUneInsertion) const;
+    void statistiquesNomPrenom(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const;
     /**
  * \brief Calcule les statistiques des collisions pour la table Téléphone.
  * \param[out] p_ratio Ratio des collisions par insertion.
  * \param[out] p_nbCollisions Nombre total de collisions.
  * \param[out] p_maximumCollisionUneInsertion Nombre maximal de collisions pour une seule insertion.
  */
-    void statistiquesTelephone(double& p_ratio, int& p_nbCollisions, int& p_maximumCollisionUneInsertion) const;
+    void statistiquesTelephone(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const;
+
+    /**
+     * \brief Fige le bottin : les index deviennent des tables de hachage parfaites en lecture seule.
+     * \details Chaque recherche ne fait plus qu'un accès à l'index, sans redistribution, et les index
+     * n'ont plus de cases vacantes. Le bottin ne peut plus être modifié par la suite.
+     * \pre Le bottin n'est pas déjà figé.
+     * \post estFige() est vrai et les recherches donnent les mêmes résultats qu'avant.
+     */
+    void figer();
+    /**
+     * \brief Indique si le bottin a été figé.
+     * \return Vrai si figer() a été appelé.
+     */
+    bool estFige() const;
+    /**
+     * \brief Retourne la façon dont les clés nom/prénom sont comparées.
+     * \return Le mode choisi à la construction.
+     */
+    ComparaisonNoms comparaisonNoms() const;
+    /**
+     * \brief Ajoute un filtre de Bloom devant l'index nom/prénom et devant l'index téléphone.
+     * \details Une clé absente est alors écartée, dans la plupart des cas, par un seul accès à une ligne
+     * de cache du filtre, sans sonder l'index. Les filtres suivent les ajouts et modifications; une
+     * suppression laisse ses bits allumés (simple faux positif), et un filtre plein est reconstruit
+     * deux fois plus grand.
+     * \param[in] p_bitsParCle Bits de filtre par entrée; 12 donne environ 0,5 % de faux positifs.
+     * \post filtresBloomActifs() est vrai et les recherches donnent les mêmes résultats qu'avant.
+     */
+    void activerFiltresBloom(size_t p_bitsParCle = 12);
+    /**
+     * \brief Indique si les filtres de Bloom sont actifs.
+     * \return Vrai si activerFiltresBloom() a été appelé.
+     */
+    bool filtresBloomActifs() const;
 
 private:
-    std::vector<Entree> m_tableauDesEntrees;
+    /**
+     * \brief Clé nom/prénom sous forme de vues sur des chaînes stockées ailleurs.
+     */
+    struct CleNomPrenom {
+        std::string_view m_nom;
+        std::string_view m_prenom;
+        bool operator==(const CleNomPrenom&) const = default;
+    };
+    /**
+     * \brief Foncteur de hachage à graine pour CleNomPrenom, exact ou normalisé.
+     * \details Les clés viennent des clients : sans la graine, on ne peut pas en fabriquer qui collisionnent.
+     */
+    struct HCleNomPrenom {
+        bool m_normaliser = false;
+        labTableHachage::HSipString m_exact;
+        labTableHachage::HSipStringNormalisee m_normalise;
+        size_t operator()(const CleNomPrenom& p_cle) const;
+        void regenererGraine();
+    };
+    /**
+     * \brief Foncteur d'égalité pour CleNomPrenom, cohérent avec HCleNomPrenom.
+     */
+    struct EgaliteCleNomPrenom {
+        bool m_normaliser = false;
+        bool operator()(const CleNomPrenom& p_a, const CleNomPrenom& p_b) const;
+    };
+    /**
+     * \brief Donne la clé nom/prénom d'une entrée à partir de son index, sans copie.
+     */
+    struct ExtracteurNomPrenom {
+        const StockageEntrees* m_entrees = nullptr;
+        CleNomPrenom operator()(size_t p_index) const {
+            return CleNomPrenom{m_entrees->nom(p_index), m_entrees->prenom(p_index)};
+        }
+    };
+    /**
+     * \brief Donne une colonne d'une entrée à partir de son index, sans copie.
+     */
+    template<typename TypeChamp, TypeChamp (StockageEntrees::* Champ)(size_t) const>
+    struct ExtracteurChamp {
+        const StockageEntrees* m_entrees = nullptr;
+        TypeChamp operator()(size_t p_index) const {
+            return (m_entrees->*Champ)(p_index);
+        }
+    };
+    typedef ExtracteurChamp<uint64_t, &StockageEntrees::telephoneFixe> ExtracteurTelephone;
+    typedef ExtracteurChamp<uint64_t, &StockageEntrees::cellulaire> ExtracteurCellulaire;
+    typedef ExtracteurChamp<std::string_view, &StockageEntrees::courriel> ExtracteurCourriel;
+    /**
+     * \brief Donne les premiers chiffres du téléphone fixe d'une entrée (indicatif, ou indicatif et central).
+     */
+    template<uint64_t Diviseur>
+    struct ExtracteurPrefixeTelephone {
+        const StockageEntrees* m_entrees = nullptr;
+        uint64_t operator()(size_t p_index) const {
+            return m_entrees->telephoneFixe(p_index) / Diviseur;
+        }
+    };
+    typedef ExtracteurPrefixeTelephone<10000000> ExtracteurIndicatif;
+    typedef ExtracteurPrefixeTelephone<10000> ExtracteurCentral;
+
+    // Les grands index sont placés sur des pages de 2 Mo (voir AllocateurPagesGeantes.h)
+    typedef labTableHachage::TableHachageIndex<CleNomPrenom, ExtracteurNomPrenom, HCleNomPrenom, EgaliteCleNomPrenom,
+                                               labTableHachage::AllocateurPagesGeantes<char> > IndexNomPrenom;
+    typedef labTableHachage::TableHachageIndex<uint64_t, ExtracteurTelephone, labTableHachage::HInt64,
+                                               std::equal_to<uint64_t>, labTableHachage::AllocateurPagesGeantes<char> > IndexTelephone;
+    typedef labTableHachage::TableHachageIndexFigee<CleNomPrenom, ExtracteurNomPrenom, HCleNomPrenom, EgaliteCleNomPrenom> IndexFigeNomPrenom;
+    typedef labTableHachage::TableHachageIndexFigee<uint64_t, ExtracteurTelephone, labTableHachage::HInt64> IndexFigeTelephone;
+    typedef labTableHachage::TableHachageMulti<uint64_t, ExtracteurCellulaire, labTableHachage::HInt64,
+                                               labTableHachage::AllocateurPagesGeantes<char> > IndexCellulaire;
+    typedef labTableHachage::TableHachageMulti<std::string_view, ExtracteurCourriel, labTableHachage::HSipString,
+                                               labTableHachage::AllocateurPagesGeantes<char> > IndexCourriel;
+    typedef labTableHachage::TableHachageMulti<uint64_t, ExtracteurIndicatif, labTableHachage::HInt64> IndexIndicatif;
+    typedef labTableHachage::TableHachageMulti<uint64_t, ExtracteurCentral, labTableHachage::HInt64> IndexCentral;
+
+    std::optional<size_t> _chercherNomPrenom(const CleNomPrenom& p_cle) const;
+    std::optional<size_t> _chercherTelephone(uint64_t p_telephoneFixe) const;
+    Entree _entree(size_t p_index) const;
+    void _executerParLots(size_t p_nombre, const std::function<void(size_t, size_t)>& p_fonction) const;
+    GroupeTravailleurs& _travailleurs() const;
+    void _insererIndexPrefixe(size_t p_index);
+    void _retirerIndexPrefixe(size_t p_index);
+    void _trierIndexPrefixe();
+    void _ecrireEntrees(std::ostream& p_sortie, OrdreExport p_ordre, std::string_view p_separateur) const;
+    std::string _texteNomPrenom(size_t p_index) const;
+    void _ajouterAuxFiltres(size_t p_index);
+    void _reconstruireFiltres();
+    bool _nomPrenomPeutExister(const CleNomPrenom& p_cle) const;
+    bool _telephonePeutExister(uint64_t p_telephoneFixe) const;
+
+    StockageEntrees m_tableauDesEntrees; /*!< Les entrées, stockées par colonnes */
+    std::vector<size_t> m_positionsLibres; /*!< Positions de m_tableauDesEntrees libérées par supprimer() */
+
+    IndexNomPrenom m_tableParNomPrenom; /*!< Index nom/prénom; les clés restent dans m_tableauDesEntrees */
+    IndexTelephone m_tableParTelephone; /*!< Index téléphone; les clés restent dans m_tableauDesEntrees */
+    IndexCellulaire m_tableParCellulaire; /*!< Index cellulaire, plusieurs entrées par numéro */
+    IndexCourriel m_tableParCourriel; /*!< Index courriel, plusieurs entrées par adresse */
+    IndexIndicatif m_tableParIndicatif; /*!< Entrées groupées par indicatif régional du téléphone fixe */
+    IndexCentral m_tableParCentral; /*!< Entrées groupées par indicatif et central du téléphone fixe */
+
+    std::vector<size_t> m_indexPrefixe; /*!< Index des entrées triés selon la clé « nom prénom » */
+    bool m_differerIndexPrefixe = false; /*!< Vrai pendant le chargement : l'index est trié une seule fois à la fin */
+    IndexTrigrammes m_indexTrigrammes; /*!< Trigrammes des clés « nom prénom », pour la recherche approximative */
+
+    static constexpr size_t SEUIL_PARALLELE = 16384; /*!< Taille de lot à partir de laquelle les fils sont utilisés */
+    static constexpr size_t TAILLE_BLOC_PARALLELE = 4096; /*!< Clés traitées par bloc dans un fil */
+    static constexpr size_t TAILLE_TAMPON_EXPORT = size_t(1) << 20; /*!< Octets formatés avant chaque écriture */
+    mutable std::once_flag m_creationTravailleurs;
+    mutable std::unique_ptr<GroupeTravailleurs> m_travailleurs; /*!< Créé au premier lot ou au premier grand index */
+
+    bool m_filtresActifs = false;
+    size_t m_bitsParCle = 12;
+    labTableHachage::FiltreBloom m_filtreNomPrenom; /*!< Hachages des clés nom/prénom, selon le foncteur de l'index */
+    labTableHachage::FiltreBloom m_filtreTelephone; /*!< Téléphones fixes compactés */
+    size_t m_grainesFiltreNomPrenom = 0; /*!< Graines tirées par l'index nom/prénom quand m_filtreNomPrenom a été construit */
 
-    labTableHachage::TableHachage<std::string, size_t, labTableHachage::HString1> m_tableParNomPrenom;
-    labTableHachage::TableHachage<std::string, size_t, labTableHachage::HString1> m_tableParTelephone;
+    bool m_estFige = false;
+    IndexFigeNomPrenom m_indexFigeNomPrenom;
+    IndexFigeTelephone m_indexFigeTelephone;
 };
 
 } // namespace TP3
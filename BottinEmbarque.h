@@ -0,0 +1,97 @@
+/**
+ * \file BottinEmbarque.h
+ * \brief Bottin en lecture seule construit à la compilation à partir d'un fichier embarqué.
+ *
+ * L'outil embarquer-bottin convertit un fichier au format de Bottin.txt en un
+ * en-tête déclarant un std::array constexpr d'EntreeEmbarquee et un
+ * BottinEmbarque constexpr construit sur ce tableau. Le compilateur valide
+ * chaque entrée, vérifie l'unicité des clés et remplit les deux tables à
+ * adressage ouvert : le programme n'a rien à lire ni à hacher au démarrage,
+ * et les textes comme les tables sont dans des pages en lecture seule,
+ * partagées par tous les processus qui exécutent le même binaire.
+ *
+ * Une entrée invalide ou une clé en double rend l'évaluation constante
+ * impossible : la compilation échoue sur la ligne du throw correspondant.
+ * Les grands fichiers peuvent demander d'augmenter la limite d'évaluation
+ * constante du compilateur (-fconstexpr-ops-limit avec GCC).
+ */
+#ifndef BOTTINEMBARQUE_H
+#define BOTTINEMBARQUE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "Bottin.h"
+
+namespace TP3 {
+
+/**
+ * \struct EntreeEmbarquee
+ * \brief Une ligne du fichier embarqué; les vues désignent des littéraux.
+ */
+struct EntreeEmbarquee {
+    std::string_view m_nom;
+    std::string_view m_prenom;
+    std::string_view m_telephoneFixe;
+    std::string_view m_cellulaire;
+    std::string_view m_courriel;
+};
+
+/**
+ * \class BottinEmbarque
+ * \brief Index nom/prénom et téléphone fixe construits à la compilation.
+ *
+ * Les recherches ont les mêmes signatures que celles de Bottin (en
+ * comparaison exacte des noms); les variantes chercherIndex* sont constexpr
+ * et peuvent servir dans un static_assert. Le tableau des entrées doit avoir
+ * une durée de stockage statique : le bottin n'en garde que l'adresse.
+ */
+template<size_t N>
+class BottinEmbarque {
+public:
+    constexpr explicit BottinEmbarque(const std::array<EntreeEmbarquee, N>& p_entrees);
+
+    Bottin::Entree trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const;
+    Bottin::Entree trouverAvecTelephone(const std::string& p_telephoneFixe) const;
+    std::optional<Bottin::Entree> chercherAvecNomPrenom(std::string_view p_nom, std::string_view p_prenom) const;
+    std::optional<Bottin::Entree> chercherAvecTelephone(std::string_view p_telephoneFixe) const;
+    Bottin::Entree reqEntree(size_t p_index) const;
+
+    constexpr std::optional<size_t> chercherIndexNomPrenom(std::string_view p_nom, std::string_view p_prenom) const;
+    constexpr std::optional<size_t> chercherIndexTelephone(std::string_view p_telephoneFixe) const;
+
+    constexpr size_t nombreEntrees() const;
+
+private:
+    static_assert(N < 0xFFFFFFFFu, "Trop d'entrées pour des cases de 32 bits");
+
+    /**
+     * \brief Cases par table : une puissance de 2 au moins double du nombre d'entrées
+     */
+    static constexpr size_t NB_CASES = [] {
+        size_t cases = 2;
+        while (cases < 2 * N) cases <<= 1;
+        return cases;
+    }();
+
+    const EntreeEmbarquee* m_entrees;
+    std::array<uint64_t, N> m_telephones; /*!< Téléphones fixes compactés */
+    std::array<uint32_t, NB_CASES> m_casesNoms; /*!< Index de l'entrée plus 1; 0 pour une case vide */
+    std::array<uint32_t, NB_CASES> m_casesTelephones;
+
+    static constexpr uint64_t _hacherNomPrenom(std::string_view p_nom, std::string_view p_prenom);
+    constexpr bool _estNomPrenom(size_t p_index, std::string_view p_nom, std::string_view p_prenom) const;
+    Bottin::Entree _entree(size_t p_index) const;
+};
+
+template<size_t N>
+BottinEmbarque(const std::array<EntreeEmbarquee, N>&) -> BottinEmbarque<N>;
+
+} // namespace TP3
+
+#include "BottinEmbarque.hpp"
+
+#endif // BOTTINEMBARQUE_H
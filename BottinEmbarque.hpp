@@ -0,0 +1,200 @@
+/**
+ * \file BottinEmbarque.hpp
+ * \brief Implémentation du bottin embarqué construit à la compilation
+ *
+ */
+#include <stdexcept>
+#include "ContratException.h"
+#include "FoncteurHachage.hpp"
+#include "StockageEntrees.h"
+#include "ValidateurEntree.h"
+
+namespace TP3 {
+
+/**
+ * \brief Construit les deux index sur un tableau d'entrées
+ *
+ * Chaque entrée est validée comme au chargement d'un Bottin, puis placée par
+ * sondage linéaire dans la table des noms et dans celle des téléphones fixes.
+ * Évalué à la compilation, un throw fait échouer la compilation.
+ *
+ * \param[in] p_entrees Les entrées, de durée de stockage statique
+ * \throw std::invalid_argument si une entrée est invalide ou si une clé est en double
+ */
+template<size_t N>
+constexpr BottinEmbarque<N>::BottinEmbarque(const std::array<EntreeEmbarquee, N>& p_entrees)
+    : m_entrees(p_entrees.data()), m_telephones{}, m_casesNoms{}, m_casesTelephones{} {
+    const labTableHachage::HInt64 hachageTelephone;
+    for (size_t i = 0; i < N; ++i) {
+        const EntreeEmbarquee& entree = p_entrees[i];
+        if (validerEntree(entree.m_nom, entree.m_prenom, entree.m_telephoneFixe,
+                          entree.m_cellulaire, entree.m_courriel) != ChampEntree::AUCUN) {
+            throw std::invalid_argument("Entrée embarquée invalide");
+        }
+        m_telephones[i] = StockageEntrees::compacterTelephone(entree.m_telephoneFixe);
+
+        size_t position = _hacherNomPrenom(entree.m_nom, entree.m_prenom) & (NB_CASES - 1);
+        while (m_casesNoms[position] != 0) {
+            if (_estNomPrenom(m_casesNoms[position] - 1, entree.m_nom, entree.m_prenom)) {
+                throw std::invalid_argument("Nom et prénom embarqués en double");
+            }
+            position = (position + 1) & (NB_CASES - 1);
+        }
+        m_casesNoms[position] = static_cast<uint32_t>(i + 1);
+
+        position = hachageTelephone(m_telephones[i]) & (NB_CASES - 1);
+        while (m_casesTelephones[position] != 0) {
+            if (m_telephones[m_casesTelephones[position] - 1] == m_telephones[i]) {
+                throw std::invalid_argument("Téléphone fixe embarqué en double");
+            }
+            position = (position + 1) & (NB_CASES - 1);
+        }
+        m_casesTelephones[position] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+/**
+ * \brief Recherche une entrée par nom et prénom
+ * \param[in] p_nom Nom de la personne
+ * \param[in] p_prenom Prénom de la personne
+ * \return L'entrée correspondante
+ * \pre Les paramètres ne doivent pas être vides
+ * \throw std::runtime_error si aucune entrée correspondante n'est trouvée
+ */
+template<size_t N>
+Bottin::Entree BottinEmbarque<N>::trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const {
+    PRECONDITION(!p_nom.empty() && "Le nom ne peut pas être vide");
+    PRECONDITION(!p_prenom.empty() && "Le prénom ne peut pas être vide");
+
+    const std::optional<size_t> index = chercherIndexNomPrenom(p_nom, p_prenom);
+    if (!index) {
+        throw std::runtime_error("Erreur : Le nom et prénom '" + p_nom + " " + p_prenom + "' n'existent pas dans le bottin.");
+    }
+    return _entree(*index);
+}
+
+/**
+ * \brief Recherche une entrée par numéro de téléphone fixe
+ * \param[in] p_telephoneFixe Numéro de téléphone fixe
+ * \return L'entrée correspondante
+ * \pre Le paramètre ne doit pas être vide
+ * \throw std::runtime_error si aucune entrée correspondante n'est trouvée
+ */
+template<size_t N>
+Bottin::Entree BottinEmbarque<N>::trouverAvecTelephone(const std::string& p_telephoneFixe) const {
+    PRECONDITION(!p_telephoneFixe.empty() && "Le numéro de téléphone fixe ne peut pas être vide.");
+
+    const std::optional<size_t> index = chercherIndexTelephone(p_telephoneFixe);
+    if (!index) {
+        throw std::runtime_error("Erreur : Le numéro de téléphone fixe '" + p_telephoneFixe + "' n'existe pas dans le bottin.");
+    }
+    return _entree(*index);
+}
+
+/**
+ * \brief Recherche une entrée par nom et prénom, sans exception
+ * \return L'entrée correspondante, ou rien si elle est absente
+ */
+template<size_t N>
+std::optional<Bottin::Entree> BottinEmbarque<N>::chercherAvecNomPrenom(std::string_view p_nom, std::string_view p_prenom) const {
+    const std::optional<size_t> index = chercherIndexNomPrenom(p_nom, p_prenom);
+    if (!index) {
+        return std::nullopt;
+    }
+    return _entree(*index);
+}
+
+/**
+ * \brief Recherche une entrée par numéro de téléphone fixe, sans exception
+ * \return L'entrée correspondante, ou rien si elle est absente
+ */
+template<size_t N>
+std::optional<Bottin::Entree> BottinEmbarque<N>::chercherAvecTelephone(std::string_view p_telephoneFixe) const {
+    const std::optional<size_t> index = chercherIndexTelephone(p_telephoneFixe);
+    if (!index) {
+        return std::nullopt;
+    }
+    return _entree(*index);
+}
+
+/**
+ * \brief Retourne l'entrée à un index donné
+ * \pre p_index < nombreEntrees()
+ */
+template<size_t N>
+Bottin::Entree BottinEmbarque<N>::reqEntree(size_t p_index) const {
+    PRECONDITION(p_index < N);
+    return _entree(p_index);
+}
+
+/**
+ * \brief Index de l'entrée ayant un nom et un prénom donnés (comparaison exacte)
+ * \return L'index de l'entrée, ou rien si elle est absente
+ */
+template<size_t N>
+constexpr std::optional<size_t> BottinEmbarque<N>::chercherIndexNomPrenom(std::string_view p_nom,
+                                                                          std::string_view p_prenom) const {
+    size_t position = _hacherNomPrenom(p_nom, p_prenom) & (NB_CASES - 1);
+    while (m_casesNoms[position] != 0) {
+        if (_estNomPrenom(m_casesNoms[position] - 1, p_nom, p_prenom)) {
+            return m_casesNoms[position] - 1;
+        }
+        position = (position + 1) & (NB_CASES - 1);
+    }
+    return std::nullopt;
+}
+
+/**
+ * \brief Index de l'entrée ayant un téléphone fixe donné
+ * \return L'index de l'entrée, ou rien si elle est absente ou si le numéro est invalide
+ */
+template<size_t N>
+constexpr std::optional<size_t> BottinEmbarque<N>::chercherIndexTelephone(std::string_view p_telephoneFixe) const {
+    if (!estTelephoneValide(p_telephoneFixe)) {
+        return std::nullopt;
+    }
+    const uint64_t telephone = StockageEntrees::compacterTelephone(p_telephoneFixe);
+    size_t position = labTableHachage::HInt64()(telephone) & (NB_CASES - 1);
+    while (m_casesTelephones[position] != 0) {
+        if (m_telephones[m_casesTelephones[position] - 1] == telephone) {
+            return m_casesTelephones[position] - 1;
+        }
+        position = (position + 1) & (NB_CASES - 1);
+    }
+    return std::nullopt;
+}
+
+template<size_t N>
+constexpr size_t BottinEmbarque<N>::nombreEntrees() const {
+    return N;
+}
+
+/**
+ * \brief FNV-1a sur « nom, séparateur, prénom », suivi du finaliseur de HInt64
+ */
+template<size_t N>
+constexpr uint64_t BottinEmbarque<N>::_hacherNomPrenom(std::string_view p_nom, std::string_view p_prenom) {
+    uint64_t total = 0xcbf29ce484222325ull;
+    for (const char c : p_nom) {
+        total = (total ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    total = (total ^ 0x1Fu) * 0x100000001b3ull;
+    for (const char c : p_prenom) {
+        total = (total ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return labTableHachage::HInt64()(total);
+}
+
+template<size_t N>
+constexpr bool BottinEmbarque<N>::_estNomPrenom(size_t p_index, std::string_view p_nom, std::string_view p_prenom) const {
+    return m_entrees[p_index].m_nom == p_nom && m_entrees[p_index].m_prenom == p_prenom;
+}
+
+template<size_t N>
+Bottin::Entree BottinEmbarque<N>::_entree(size_t p_index) const {
+    const EntreeEmbarquee& entree = m_entrees[p_index];
+    return Bottin::Entree(entree.m_nom, entree.m_prenom, std::string(entree.m_telephoneFixe),
+                          std::string(entree.m_cellulaire), entree.m_courriel);
+}
+
+} // namespace TP3
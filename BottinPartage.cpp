@@ -0,0 +1,378 @@
+/**
+ * \file BottinPartage.cpp
+ * \brief Implantation du bottin en mémoire partagée.
+ */
+#include "BottinPartage.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace TP3 {
+
+namespace {
+    [[noreturn]] void echecSysteme(const std::string& p_appel, const std::string& p_nom) {
+        throw std::runtime_error("Erreur : " + p_appel + " (" + p_nom + ") : " + std::strerror(errno));
+    }
+
+    constexpr uint64_t aligner(uint64_t p_position) {
+        return (p_position + 63) & ~uint64_t(63);
+    }
+
+    /**
+     * \brief Index figé construit en mémoire, avant sa copie dans le segment.
+     */
+    struct IndexConstruit {
+        labTableHachage::HachageParfaitMinimal m_fonction;
+        std::vector<uint32_t> m_cases; /*!< Index de l'entrée de chaque position */
+        std::vector<uint64_t> m_hachagesDebordement;
+        std::vector<uint32_t> m_debordement;
+    };
+
+    /**
+     * \brief Construit un index figé comme TableHachageIndexFigee.
+     * \param[in] p_paires Valeur de hachage et index de chaque entrée.
+     * \return La fonction parfaite sur les valeurs distinctes, et le débordement des valeurs répétées.
+     */
+    IndexConstruit construireIndex(std::vector<std::pair<uint64_t, uint32_t>> p_paires) {
+        IndexConstruit index;
+        if (p_paires.empty()) return index;
+        std::sort(p_paires.begin(), p_paires.end());
+
+        std::vector<uint64_t> hachages;
+        hachages.reserve(p_paires.size());
+        for (size_t i = 0; i < p_paires.size(); ++i) {
+            if (i > 0 && p_paires[i].first == p_paires[i - 1].first) {
+                index.m_debordement.push_back(p_paires[i].second);
+                index.m_hachagesDebordement.push_back(p_paires[i].first);
+            } else {
+                hachages.push_back(p_paires[i].first);
+            }
+        }
+        index.m_fonction.construire(hachages);
+
+        index.m_cases.resize(hachages.size());
+        for (size_t i = 0; i < p_paires.size(); ++i) {
+            if (i == 0 || p_paires[i].first != p_paires[i - 1].first) {
+                index.m_cases[index.m_fonction.position(p_paires[i].first)] = p_paires[i].second;
+            }
+        }
+        return index;
+    }
+}
+
+    /**
+     * \brief Projette en lecture seule un segment publié.
+     * \param[in] p_nom Nom du segment (par exemple "/bottin").
+     * \throw std::runtime_error si le segment n'existe pas, est incomplet ou d'un autre format.
+     */
+BottinPartage::BottinPartage(const std::string& p_nom)
+    : m_debut(nullptr), m_taille(0), m_enTete(nullptr), m_entrees(nullptr), m_textes(nullptr) {
+    const int fd = shm_open(p_nom.c_str(), O_RDONLY, 0);
+    if (fd < 0) echecSysteme("shm_open", p_nom);
+    struct stat etat{};
+    if (fstat(fd, &etat) < 0) {
+        close(fd);
+        echecSysteme("fstat", p_nom);
+    }
+    m_taille = static_cast<size_t>(etat.st_size);
+    if (m_taille < sizeof(EnTete)) {
+        close(fd);
+        throw std::runtime_error("Erreur : le segment '" + p_nom + "' est incomplet.");
+    }
+    void* projection = mmap(nullptr, m_taille, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (projection == MAP_FAILED) echecSysteme("mmap", p_nom);
+    m_debut = static_cast<const char*>(projection);
+    m_enTete = reinterpret_cast<const EnTete*>(m_debut);
+
+    const uint64_t magie = std::atomic_ref<uint64_t>(const_cast<uint64_t&>(m_enTete->m_magie)).load(std::memory_order_acquire);
+    if (magie != MAGIE || m_enTete->m_version != VERSION_FORMAT || m_enTete->m_taille != m_taille) {
+        munmap(projection, m_taille);
+        throw std::runtime_error("Erreur : le segment '" + p_nom + "' est incomplet ou d'un autre format.");
+    }
+    m_entrees = reinterpret_cast<const EntreePartagee*>(m_debut + m_enTete->m_positionEntrees);
+    m_textes = m_debut + m_enTete->m_positionTextes;
+}
+    /**
+     * \brief Libère la projection; le segment lui-même reste publié.
+     */
+BottinPartage::~BottinPartage() {
+    munmap(const_cast<char*>(m_debut), m_taille);
+}
+    /**
+     * \brief Construit un segment de mémoire partagée à partir d'un bottin.
+     * \details Un segment existant du même nom est d'abord retiré : les processus qui le projettent
+     * gardent l'ancienne version jusqu'à ce qu'ils rouvrent le segment. L'en-tête n'est marqué
+     * complet qu'une fois tout le contenu écrit.
+     * \param[in] p_bottin Le bottin à publier.
+     * \param[in] p_nom Nom du segment (par exemple "/bottin").
+     * \throw std::runtime_error si le segment ne peut pas être créé.
+     * \post BottinPartage(p_nom) donne les mêmes résultats de recherche que p_bottin.
+     */
+void BottinPartage::publier(const Bottin& p_bottin, const std::string& p_nom) {
+    const bool normaliser = p_bottin.comparaisonNoms() == Bottin::ComparaisonNoms::NORMALISEE;
+    const std::vector<size_t> indexes = p_bottin.trouverParPrefixe("", p_bottin.nombreEntrees());
+
+    // Entrées en ordre de clé, textes dans un seul bassin
+    std::vector<EntreePartagee> entrees;
+    entrees.reserve(indexes.size());
+    std::string textes;
+    std::vector<std::pair<uint64_t, uint32_t>> pairesNoms;
+    std::vector<std::pair<uint64_t, uint32_t>> pairesTelephones;
+    pairesNoms.reserve(indexes.size());
+    pairesTelephones.reserve(indexes.size());
+    for (size_t index : indexes) {
+        const Bottin::Entree entree = p_bottin.reqEntree(index);
+        EntreePartagee partagee{};
+        partagee.m_telephoneFixe = StockageEntrees::compacterTelephone(entree.m_telephoneFixe);
+        partagee.m_cellulaire = StockageEntrees::compacterTelephone(entree.m_cellulaire);
+        partagee.m_debutNom = textes.size();
+        partagee.m_longueurNom = static_cast<uint16_t>(entree.m_nom.size());
+        partagee.m_longueurPrenom = static_cast<uint16_t>(entree.m_prenom.size());
+        textes.append(entree.m_nom).append(entree.m_prenom);
+        partagee.m_debutCourriel = textes.size();
+        partagee.m_longueurCourriel = static_cast<uint16_t>(entree.m_courriel.size());
+        textes.append(entree.m_courriel);
+        const uint32_t position = static_cast<uint32_t>(entrees.size());
+        entrees.push_back(partagee);
+        pairesNoms.push_back({_hachageNomPrenom(entree.m_nom, entree.m_prenom, normaliser), position});
+        // Le numéro compacté est déjà une valeur distincte par téléphone
+        pairesTelephones.push_back({partagee.m_telephoneFixe, position});
+    }
+    PRECONDITION(entrees.size() < UINT32_MAX);
+    const IndexConstruit indexNoms = construireIndex(std::move(pairesNoms));
+    const IndexConstruit indexTelephones = construireIndex(std::move(pairesTelephones));
+
+    EnTete enTete{};
+    enTete.m_version = VERSION_FORMAT;
+    enTete.m_normalise = normaliser ? 1 : 0;
+    enTete.m_nbEntrees = entrees.size();
+    uint64_t fin = aligner(sizeof(EnTete));
+    auto reserver = [&fin](uint64_t p_octets) {
+        const uint64_t position = fin;
+        fin = aligner(fin + p_octets);
+        return position;
+    };
+    auto disposer = [&reserver](IndexFige& p_fige, const IndexConstruit& p_index) {
+        p_fige.m_graine = p_index.m_fonction.reqGraine();
+        p_fige.m_nbCles = p_index.m_cases.size();
+        p_fige.m_nbSeaux = p_index.m_fonction.reqDeplacements().size();
+        p_fige.m_nbDebordement = p_index.m_debordement.size();
+        p_fige.m_positionDeplacements = reserver(p_fige.m_nbSeaux * sizeof(uint32_t));
+        p_fige.m_positionCases = reserver(p_fige.m_nbCles * sizeof(uint32_t));
+        p_fige.m_positionHachagesDebordement = reserver(p_fige.m_nbDebordement * sizeof(uint64_t));
+        p_fige.m_positionDebordement = reserver(p_fige.m_nbDebordement * sizeof(uint32_t));
+    };
+    enTete.m_positionEntrees = reserver(entrees.size() * sizeof(EntreePartagee));
+    disposer(enTete.m_indexNoms, indexNoms);
+    disposer(enTete.m_indexTelephones, indexTelephones);
+    enTete.m_positionTextes = fin;
+    enTete.m_taille = enTete.m_positionTextes + textes.size();
+
+    shm_unlink(p_nom.c_str());
+    const int fd = shm_open(p_nom.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) echecSysteme("shm_open", p_nom);
+    if (ftruncate(fd, static_cast<off_t>(enTete.m_taille)) < 0) {
+        close(fd);
+        echecSysteme("ftruncate", p_nom);
+    }
+    void* projection = mmap(nullptr, enTete.m_taille, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (projection == MAP_FAILED) echecSysteme("mmap", p_nom);
+
+    char* debut = static_cast<char*>(projection);
+    std::memcpy(debut + enTete.m_positionEntrees, entrees.data(), entrees.size() * sizeof(EntreePartagee));
+    auto copier = [debut](const IndexFige& p_fige, const IndexConstruit& p_index) {
+        std::memcpy(debut + p_fige.m_positionDeplacements, p_index.m_fonction.reqDeplacements().data(),
+                    p_fige.m_nbSeaux * sizeof(uint32_t));
+        std::memcpy(debut + p_fige.m_positionCases, p_index.m_cases.data(), p_fige.m_nbCles * sizeof(uint32_t));
+        std::memcpy(debut + p_fige.m_positionHachagesDebordement, p_index.m_hachagesDebordement.data(),
+                    p_fige.m_nbDebordement * sizeof(uint64_t));
+        std::memcpy(debut + p_fige.m_positionDebordement, p_index.m_debordement.data(),
+                    p_fige.m_nbDebordement * sizeof(uint32_t));
+    };
+    copier(enTete.m_indexNoms, indexNoms);
+    copier(enTete.m_indexTelephones, indexTelephones);
+    std::memcpy(debut + enTete.m_positionTextes, textes.data(), textes.size());
+    std::memcpy(debut, &enTete, sizeof(enTete));
+    EnTete* enTetePartage = reinterpret_cast<EnTete*>(debut);
+    std::atomic_ref<uint64_t>(enTetePartage->m_magie).store(MAGIE, std::memory_order_release);
+    munmap(projection, enTete.m_taille);
+}
+    /**
+     * \brief Retire un segment publié; les projections existantes restent valides.
+     * \param[in] p_nom Nom du segment.
+     */
+void BottinPartage::retirer(const std::string& p_nom) {
+    shm_unlink(p_nom.c_str());
+}
+    /**
+     * \brief Recherche une entrée par nom et prénom.
+     * \param[in] p_nom Nom de la personne.
+     * \param[in] p_prenom Prénom de la personne.
+     * \return Une vue sur l'entrée correspondante.
+     * \throw std::runtime_error si aucune entrée correspondante n'est trouvée.
+     */
+Bottin::Entree BottinPartage::trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const {
+    std::optional<Bottin::Entree> entree = chercherAvecNomPrenom(p_nom, p_prenom);
+    if (!entree) {
+        throw std::runtime_error("Erreur : Le nom et prénom '" + p_nom + " " + p_prenom + "' n'existent pas dans le bottin.");
+    }
+    return std::move(*entree);
+}
+    /**
+     * \brief Recherche une entrée par numéro de téléphone fixe.
+     * \param[in] p_telephoneFixe Numéro de téléphone fixe.
+     * \return Une vue sur l'entrée correspondante.
+     * \throw std::runtime_error si aucune entrée correspondante n'est trouvée.
+     */
+Bottin::Entree BottinPartage::trouverAvecTelephone(const std::string& p_telephoneFixe) const {
+    std::optional<Bottin::Entree> entree = chercherAvecTelephone(p_telephoneFixe);
+    if (!entree) {
+        throw std::runtime_error("Erreur : Le numéro de téléphone fixe '" + p_telephoneFixe + "' n'existe pas dans le bottin.");
+    }
+    return std::move(*entree);
+}
+    /**
+     * \brief Recherche une entrée par nom et prénom, sans exception.
+     * \param[in] p_nom Nom de la personne.
+     * \param[in] p_prenom Prénom de la personne.
+     * \return Une vue sur l'entrée correspondante, ou rien si elle est absente.
+     */
+std::optional<Bottin::Entree> BottinPartage::chercherAvecNomPrenom(std::string_view p_nom, std::string_view p_prenom) const {
+    const bool normaliser = m_enTete->m_normalise != 0;
+    const std::optional<size_t> trouve = _chercher(m_enTete->m_indexNoms, _hachageNomPrenom(p_nom, p_prenom, normaliser),
+                                                   [&](const EntreePartagee& p_entree) {
+        if (normaliser) {
+            labTableHachage::EgaliteNormalisee egalite;
+            return egalite(_nom(p_entree), p_nom) && egalite(_prenom(p_entree), p_prenom);
+        }
+        return _nom(p_entree) == p_nom && _prenom(p_entree) == p_prenom;
+    });
+    if (!trouve) {
+        return std::nullopt;
+    }
+    return _entree(*trouve);
+}
+    /**
+     * \brief Recherche une entrée par numéro de téléphone fixe, sans exception.
+     * \param[in] p_telephoneFixe Numéro de téléphone fixe.
+     * \return Une vue sur l'entrée correspondante, ou rien si le numéro est absent ou mal formé.
+     */
+std::optional<Bottin::Entree> BottinPartage::chercherAvecTelephone(std::string_view p_telephoneFixe) const {
+    if (!estTelephoneValide(p_telephoneFixe)) {
+        return std::nullopt;
+    }
+    const uint64_t telephone = StockageEntrees::compacterTelephone(p_telephoneFixe);
+    const std::optional<size_t> trouve = _chercher(m_enTete->m_indexTelephones, telephone,
+                                                   [telephone](const EntreePartagee& p_entree) {
+        return p_entree.m_telephoneFixe == telephone;
+    });
+    if (!trouve) {
+        return std::nullopt;
+    }
+    return _entree(*trouve);
+}
+    /**
+     * \brief Retourne l'entrée à un index donné.
+     * \param[in] p_index Index dans [0, nombreEntrees()); les entrées sont en ordre de clé « nom prénom ».
+     * \return Une vue sur l'entrée.
+     * \pre L'index est inférieur à nombreEntrees().
+     */
+Bottin::Entree BottinPartage::reqEntree(size_t p_index) const {
+    PRECONDITION(p_index < m_enTete->m_nbEntrees && "L'index est invalide.");
+    return _entree(p_index);
+}
+    /**
+     * \brief Retourne le nombre d'entrées du segment.
+     * \return Le nombre d'entrées.
+     */
+size_t BottinPartage::nombreEntrees() const {
+    return static_cast<size_t>(m_enTete->m_nbEntrees);
+}
+    /**
+     * \brief Retourne la taille du segment projeté, en octets.
+     * \return La taille.
+     */
+size_t BottinPartage::taille() const {
+    return m_taille;
+}
+    /**
+     * \brief Vérifie l'entrée désignée par la fonction parfaite, puis le débordement de même hachage.
+     * \param[in] p_index L'index figé des noms ou des téléphones.
+     * \param[in] p_hachage Le hachage de la clé cherchée.
+     * \param[in] p_egalite Vrai si une entrée a la clé cherchée.
+     * \return L'index de l'entrée, ou rien si la clé est absente.
+     */
+template<typename Egalite>
+std::optional<size_t> BottinPartage::_chercher(const IndexFige& p_index, uint64_t p_hachage, Egalite p_egalite) const {
+    if (p_index.m_nbCles == 0) {
+        return std::nullopt;
+    }
+    const std::span<const uint32_t> deplacements(
+        reinterpret_cast<const uint32_t*>(m_debut + p_index.m_positionDeplacements), p_index.m_nbSeaux);
+    const uint32_t* cases = reinterpret_cast<const uint32_t*>(m_debut + p_index.m_positionCases);
+    const uint32_t candidat = cases[labTableHachage::HachageParfaitMinimal::position(
+        p_hachage, p_index.m_graine, deplacements, p_index.m_nbCles)];
+    if (p_egalite(m_entrees[candidat])) {
+        return candidat;
+    }
+    const uint64_t* hachages = reinterpret_cast<const uint64_t*>(m_debut + p_index.m_positionHachagesDebordement);
+    const uint64_t* finHachages = hachages + p_index.m_nbDebordement;
+    const uint32_t* debordement = reinterpret_cast<const uint32_t*>(m_debut + p_index.m_positionDebordement);
+    for (const uint64_t* hachage = std::lower_bound(hachages, finHachages, p_hachage);
+         hachage != finHachages && *hachage == p_hachage; ++hachage) {
+        const uint32_t index = debordement[hachage - hachages];
+        if (p_egalite(m_entrees[index])) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string_view BottinPartage::_nom(const EntreePartagee& p_entree) const {
+    return std::string_view(m_textes + p_entree.m_debutNom, p_entree.m_longueurNom);
+}
+
+std::string_view BottinPartage::_prenom(const EntreePartagee& p_entree) const {
+    return std::string_view(m_textes + p_entree.m_debutNom + p_entree.m_longueurNom, p_entree.m_longueurPrenom);
+}
+    /**
+     * \brief Construit la vue sur une entrée du segment.
+     * \param[in] p_index Index de l'entrée.
+     * \return La vue, avec ses téléphones formatés.
+     */
+Bottin::Entree BottinPartage::_entree(size_t p_index) const {
+    const EntreePartagee& entree = m_entrees[p_index];
+    return Bottin::Entree(_nom(entree), _prenom(entree),
+                          StockageEntrees::formaterTelephone(entree.m_telephoneFixe),
+                          StockageEntrees::formaterTelephone(entree.m_cellulaire),
+                          std::string_view(m_textes + entree.m_debutCourriel, entree.m_longueurCourriel));
+}
+    /**
+     * \brief Hache une clé nom/prénom, exactement ou après normalisation.
+     * \param[in] p_nom Le nom.
+     * \param[in] p_prenom Le prénom.
+     * \param[in] p_normaliser Vrai pour ignorer la casse et les accents.
+     * \return La valeur de hachage, la même dans tous les processus.
+     */
+uint64_t BottinPartage::_hachageNomPrenom(std::string_view p_nom, std::string_view p_prenom, bool p_normaliser) {
+    if (p_normaliser) {
+        labTableHachage::HStringNormalisee h;
+        return h(p_nom) ^ (h(p_prenom) * 0x9e3779b97f4a7c15ull);
+    }
+    labTableHachage::HString1 h;
+    return h(p_nom) ^ (h(p_prenom) * 0x9e3779b97f4a7c15ull);
+}
+
+} // namespace TP3
@@ -0,0 +1,116 @@
+/**
+ * \file BottinPartage.h
+ * \brief Bottin en lecture seule placé dans un segment de mémoire partagée POSIX.
+ *
+ * Un processus construit le segment à partir d'un Bottin (publier()); les
+ * autres l'ouvrent en lecture seule et y cherchent directement, sans copie ni
+ * chargement. Le segment ne contient que des positions relatives à son début,
+ * jamais de pointeurs ni de std::string : chaque processus peut le placer à
+ * une adresse différente.
+ *
+ * Disposition : un en-tête, le tableau des entrées (téléphones compactés,
+ * positions et longueurs des textes), deux index figés comme
+ * TableHachageIndexFigee (déplacements de la fonction parfaite, index de
+ * l'entrée de chaque position, puis débordement des valeurs de hachage
+ * répétées), puis le bassin des textes. Les clés nom/prénom sont comparées
+ * comme dans le Bottin source, exactement ou après normalisation.
+ */
+#ifndef BOTTINPARTAGE_H
+#define BOTTINPARTAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "Bottin.h"
+#include "HachageParfaitMinimal.h"
+
+namespace TP3 {
+
+/**
+ * \class BottinPartage
+ * \brief Projection en lecture seule d'un bottin publié en mémoire partagée.
+ *
+ * Les recherches ont les mêmes signatures que celles de Bottin; les vues des
+ * entrées retournées désignent le segment et restent valides tant que l'objet
+ * existe, même si le segment est republié entre-temps.
+ */
+class BottinPartage {
+public:
+    explicit BottinPartage(const std::string& p_nom);
+    ~BottinPartage();
+
+    BottinPartage(const BottinPartage&) = delete;
+    BottinPartage& operator=(const BottinPartage&) = delete;
+
+    static void publier(const Bottin& p_bottin, const std::string& p_nom);
+    static void retirer(const std::string& p_nom);
+
+    Bottin::Entree trouverAvecNomPrenom(const std::string& p_nom, const std::string& p_prenom) const;
+    Bottin::Entree trouverAvecTelephone(const std::string& p_telephoneFixe) const;
+    std::optional<Bottin::Entree> chercherAvecNomPrenom(std::string_view p_nom, std::string_view p_prenom) const;
+    std::optional<Bottin::Entree> chercherAvecTelephone(std::string_view p_telephoneFixe) const;
+    Bottin::Entree reqEntree(size_t p_index) const;
+
+    size_t nombreEntrees() const;
+    size_t taille() const;
+
+private:
+    static constexpr uint64_t MAGIE = 0x5041485354544f42ull; /*!< « BOTTSHAP », écrit en dernier */
+    static constexpr uint32_t VERSION_FORMAT = 2;
+
+    /**
+     * \brief Index figé d'une clé : une HachageParfaitMinimal copiée dans le segment.
+     */
+    struct IndexFige {
+        uint64_t m_graine; /*!< Graine de la fonction parfaite */
+        uint64_t m_nbCles; /*!< Valeurs de hachage distinctes; 0 pour un bottin vide */
+        uint64_t m_nbSeaux;
+        uint64_t m_nbDebordement; /*!< Entrées dont la valeur de hachage est répétée */
+        uint64_t m_positionDeplacements;
+        uint64_t m_positionCases; /*!< Index de l'entrée de chaque position */
+        uint64_t m_positionHachagesDebordement; /*!< En ordre croissant */
+        uint64_t m_positionDebordement;
+    };
+
+    struct EnTete {
+        uint64_t m_magie;
+        uint32_t m_version;
+        uint32_t m_normalise; /*!< 1 si les clés nom/prénom sont comparées normalisées */
+        uint64_t m_taille; /*!< Taille totale du segment */
+        uint64_t m_nbEntrees;
+        uint64_t m_positionEntrees;
+        uint64_t m_positionTextes;
+        IndexFige m_indexNoms;
+        IndexFige m_indexTelephones;
+    };
+
+    struct EntreePartagee {
+        uint64_t m_telephoneFixe;
+        uint64_t m_cellulaire;
+        uint64_t m_debutNom; /*!< Le prénom suit le nom dans le bassin */
+        uint64_t m_debutCourriel;
+        uint16_t m_longueurNom;
+        uint16_t m_longueurPrenom;
+        uint16_t m_longueurCourriel;
+    };
+
+    const char* m_debut; /*!< Début de la projection du segment */
+    size_t m_taille;
+    const EnTete* m_enTete;
+    const EntreePartagee* m_entrees;
+    const char* m_textes;
+
+    template<typename Egalite>
+    std::optional<size_t> _chercher(const IndexFige& p_index, uint64_t p_hachage, Egalite p_egalite) const;
+    std::string_view _nom(const EntreePartagee& p_entree) const;
+    std::string_view _prenom(const EntreePartagee& p_entree) const;
+    Bottin::Entree _entree(size_t p_index) const;
+
+    static uint64_t _hachageNomPrenom(std::string_view p_nom, std::string_view p_prenom, bool p_normaliser);
+};
+
+} // namespace TP3
+
+#endif // BOTTINPARTAGE_H
@@ -0,0 +1,158 @@
+/**
+ * \file BottinVersionne.cpp
+ * \brief Implantation du bottin rechargeable à chaud.
+ */
+#include "BottinVersionne.h"
+#include "ContratException.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace TP3 {
+
+    /**
+     * \brief Transfère l'inscription d'une lecture.
+     * \param[in,out] p_autre La lecture déplacée; elle ne désigne plus rien.
+     */
+BottinVersionne::Lecture::Lecture(Lecture&& p_autre) noexcept
+    : m_compteur(p_autre.m_compteur), m_instantane(p_autre.m_instantane) {
+    p_autre.m_compteur = nullptr;
+    p_autre.m_instantane = nullptr;
+}
+    /**
+     * \brief Termine la lecture : l'instantané peut être libéré s'il a été remplacé.
+     */
+BottinVersionne::Lecture::~Lecture() {
+    if (m_compteur != nullptr) {
+        m_compteur->fetch_sub(1, std::memory_order_release);
+    }
+}
+    /**
+     * \brief Constructeur.
+     * \param[in] p_initial Le bottin de la version 1.
+     * \pre p_initial n'est pas nul.
+     */
+BottinVersionne::BottinVersionne(std::unique_ptr<const Bottin> p_initial)
+    : m_courant(nullptr), m_epoque(0), m_rechargementEnCours(false) {
+    PRECONDITION(p_initial != nullptr);
+    m_courant.store(new Instantane{std::move(p_initial), 1});
+}
+    /**
+     * \brief Attend la fin d'un rechargement en cours puis libère l'instantané courant.
+     * \pre Aucune Lecture n'existe encore.
+     */
+BottinVersionne::~BottinVersionne() {
+    {
+        std::lock_guard<std::mutex> verrou(m_mutexRechargement);
+        if (m_fil.joinable()) m_fil.join();
+    }
+    delete m_courant.load();
+}
+    /**
+     * \brief Obtient l'instantané courant, sans verrou.
+     * \details Le lecteur s'inscrit dans la parité de l'époque courante; si l'époque a avancé
+     * entre sa lecture et l'inscription, il recommence dans la nouvelle parité.
+     * \return Une lecture sur l'instantané courant.
+     */
+BottinVersionne::Lecture BottinVersionne::lire() const {
+    const size_t numero = _numeroCompteur();
+    for (;;) {
+        const uint64_t epoque = m_epoque.load();
+        std::atomic<int64_t>& compteur = m_lecteurs[epoque & 1][numero].m_valeur;
+        compteur.fetch_add(1);
+        if (m_epoque.load() == epoque) {
+            return Lecture(&compteur, m_courant.load());
+        }
+        compteur.fetch_sub(1, std::memory_order_release);
+    }
+}
+    /**
+     * \brief Retourne le numéro de la version courante.
+     * \return La version, 1 pour le bottin initial et augmentée de 1 à chaque publication.
+     */
+uint64_t BottinVersionne::version() const {
+    return m_courant.load()->m_version;
+}
+    /**
+     * \brief Publie un nouveau bottin, puis libère l'ancien après la fin de ses lectures.
+     * \details L'appelant attend les lecteurs de l'ancienne version; les lecteurs, eux, ne sont jamais retardés.
+     * \param[in] p_nouveau Le nouveau bottin, qui ne sera plus modifié.
+     * \pre p_nouveau n'est pas nul.
+     * \post version() est augmentée de 1 et les nouvelles lectures voient p_nouveau.
+     */
+void BottinVersionne::publier(std::unique_ptr<const Bottin> p_nouveau) {
+    PRECONDITION(p_nouveau != nullptr);
+    std::lock_guard<std::mutex> verrou(m_mutexPublication);
+
+    const Instantane* ancien = m_courant.load();
+    m_courant.store(new Instantane{std::move(p_nouveau), ancien->m_version + 1});
+
+    // Un lecteur inscrit dans l'ancienne parité a pu lire l'ancien pointeur; les suivants
+    // s'inscrivent dans la nouvelle parité après l'échange et voient le nouveau.
+    const uint64_t epoque = m_epoque.fetch_add(1);
+    _attendreLecteurs(epoque & 1);
+    delete ancien;
+}
+    /**
+     * \brief Charge un nouveau bottin dans un fil d'arrière-plan puis le publie.
+     * \param[in] p_chemin Le fichier à charger.
+     * \param[in] p_preparer Appelée sur le nouveau bottin avant sa publication (figer(), filtres...).
+     * \return Faux si un rechargement est déjà en cours : la demande est alors ignorée.
+     */
+bool BottinVersionne::rechargerEnArrierePlan(const std::string& p_chemin, std::function<void(Bottin&)> p_preparer) {
+    std::lock_guard<std::mutex> verrou(m_mutexRechargement);
+    if (m_rechargementEnCours.exchange(true)) {
+        return false;
+    }
+    if (m_fil.joinable()) m_fil.join();
+    m_erreur = nullptr;
+    m_fil = std::thread([this, p_chemin, preparer = std::move(p_preparer)]() {
+        try {
+            std::ifstream fichier(p_chemin);
+            if (!fichier.is_open()) {
+                throw std::runtime_error("Erreur : impossible d'ouvrir le fichier '" + p_chemin + "'.");
+            }
+            auto nouveau = std::make_unique<Bottin>(fichier);
+            if (preparer) preparer(*nouveau);
+            publier(std::move(nouveau));
+        } catch (...) {
+            m_erreur = std::current_exception();
+        }
+        m_rechargementEnCours.store(false);
+    });
+    return true;
+}
+    /**
+     * \brief Attend la fin du dernier rechargement.
+     * \throw L'exception du rechargement s'il a échoué; la version courante est alors inchangée.
+     */
+void BottinVersionne::attendreRechargement() {
+    std::lock_guard<std::mutex> verrou(m_mutexRechargement);
+    if (m_fil.joinable()) m_fil.join();
+    if (m_erreur) {
+        std::exception_ptr erreur = m_erreur;
+        m_erreur = nullptr;
+        std::rethrow_exception(erreur);
+    }
+}
+    /**
+     * \brief Attend que tous les lecteurs inscrits dans une parité aient terminé.
+     * \param[in] p_parite La parité, 0 ou 1.
+     */
+void BottinVersionne::_attendreLecteurs(uint64_t p_parite) const {
+    for (const Compteur& compteur : m_lecteurs[p_parite]) {
+        while (compteur.m_valeur.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+    /**
+     * \brief Retourne le compteur attribué au fil appelant, pour répartir les inscriptions.
+     * \return Un numéro dans [0, NB_COMPTEURS).
+     */
+size_t BottinVersionne::_numeroCompteur() noexcept {
+    static std::atomic<size_t> prochain(0);
+    thread_local const size_t numero = prochain.fetch_add(1, std::memory_order_relaxed) % NB_COMPTEURS;
+    return numero;
+}
+
+} // namespace TP3
@@ -0,0 +1,105 @@
+/**
+ * \file BottinVersionne.h
+ * \brief Bottin rechargeable à chaud, par échange d'instantanés à la manière de RCU.
+ *
+ * Les lecteurs obtiennent l'instantané courant sans verrou : ils s'inscrivent
+ * dans un compteur de la parité de l'époque courante (compteurs répartis sur
+ * plusieurs lignes de cache selon le fil), lisent le pointeur publié et se
+ * désinscrivent à la fin de la lecture. Un rechargement construit le nouveau
+ * Bottin dans un fil d'arrière-plan, le publie par un échange atomique, fait
+ * avancer l'époque puis attend, toujours en arrière-plan, que les lecteurs de
+ * l'ancienne parité aient terminé avant de détruire l'ancien instantané. Les
+ * lecteurs ne sont jamais bloqués.
+ */
+#ifndef BOTTINVERSIONNE_H
+#define BOTTINVERSIONNE_H
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Bottin.h"
+
+namespace TP3 {
+
+/**
+ * \class BottinVersionne
+ * \brief Donne accès à la version courante d'un bottin qui peut être remplacée pendant les lectures.
+ */
+class BottinVersionne {
+private:
+    struct Instantane {
+        std::unique_ptr<const Bottin> m_bottin;
+        uint64_t m_version;
+    };
+
+public:
+    /**
+     * \class Lecture
+     * \brief Accès à un instantané; il reste valide tant que la Lecture existe.
+     * \details Une Lecture doit être courte : tant qu'elle existe, l'instantané
+     * remplacé qu'elle désigne ne peut pas être libéré.
+     */
+    class Lecture {
+    public:
+        Lecture(Lecture&& p_autre) noexcept;
+        Lecture(const Lecture&) = delete;
+        Lecture& operator=(const Lecture&) = delete;
+        Lecture& operator=(Lecture&&) = delete;
+        ~Lecture();
+
+        const Bottin& operator*() const { return *m_instantane->m_bottin; }
+        const Bottin* operator->() const { return m_instantane->m_bottin.get(); }
+        uint64_t version() const { return m_instantane->m_version; }
+
+    private:
+        friend class BottinVersionne;
+        Lecture(std::atomic<int64_t>* p_compteur, const Instantane* p_instantane) noexcept
+            : m_compteur(p_compteur), m_instantane(p_instantane) {}
+
+        std::atomic<int64_t>* m_compteur; /*!< Compteur où la lecture est inscrite, nul si déplacée */
+        const Instantane* m_instantane;
+    };
+
+    explicit BottinVersionne(std::unique_ptr<const Bottin> p_initial);
+    ~BottinVersionne();
+
+    BottinVersionne(const BottinVersionne&) = delete;
+    BottinVersionne& operator=(const BottinVersionne&) = delete;
+
+    Lecture lire() const;
+    uint64_t version() const;
+
+    void publier(std::unique_ptr<const Bottin> p_nouveau);
+    bool rechargerEnArrierePlan(const std::string& p_chemin,
+                                std::function<void(Bottin&)> p_preparer = std::function<void(Bottin&)>());
+    void attendreRechargement();
+
+private:
+    static constexpr size_t NB_COMPTEURS = 16; /*!< Compteurs de lecteurs par parité, un par ligne de cache */
+
+    struct alignas(64) Compteur {
+        std::atomic<int64_t> m_valeur{0};
+    };
+
+    std::atomic<const Instantane*> m_courant;
+    std::atomic<uint64_t> m_epoque;
+    mutable Compteur m_lecteurs[2][NB_COMPTEURS]; /*!< Lecteurs inscrits, par parité d'époque et par fil */
+
+    std::mutex m_mutexPublication; /*!< Sérialise les publications */
+    std::mutex m_mutexRechargement; /*!< Protège m_fil et m_erreur */
+    std::thread m_fil; /*!< Fil du rechargement en cours ou terminé */
+    std::atomic<bool> m_rechargementEnCours;
+    std::exception_ptr m_erreur; /*!< Erreur du dernier rechargement, relancée par attendreRechargement() */
+
+    void _attendreLecteurs(uint64_t p_parite) const;
+    static size_t _numeroCompteur() noexcept;
+};
+
+} // namespace TP3
+
+#endif // BOTTINVERSIONNE_H
@@ -0,0 +1,176 @@
+/**
+ * \file ClientBottin.cpp
+ * \brief Générateur de charge pour le serveur de bottin.
+ *
+ * Usage : client-bottin <socket> [fichier=Bottin.txt] [connexions=4] [requetes=100000] [profondeur=16]
+ *
+ * Chaque connexion garde jusqu'à « profondeur » requêtes en vol, tirées des
+ * noms et téléphones du fichier (une sur cinq par nom/prénom, les autres par
+ * téléphone). À la fin, le débit total et les quantiles de latence sont
+ * affichés.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "ProtocoleBottin.h"
+
+namespace {
+    using Horloge = std::chrono::steady_clock;
+    using namespace TP3;
+
+    struct Cle {
+        std::string m_nom;
+        std::string m_prenom;
+        std::string m_telephone;
+    };
+
+    std::vector<Cle> lireCles(const std::string& p_fichier) {
+        std::vector<Cle> cles;
+        std::ifstream fichier(p_fichier);
+        std::string ligne;
+        std::getline(fichier, ligne); // en-tête
+        while (std::getline(fichier, ligne)) {
+            std::stringstream ss(ligne);
+            std::string nomPrenom, telephone;
+            std::getline(ss, nomPrenom, '\t');
+            std::getline(ss, telephone, '\t');
+            const size_t virgule = nomPrenom.find(", ");
+            if (virgule == std::string::npos) continue;
+            cles.push_back(Cle{nomPrenom.substr(0, virgule), nomPrenom.substr(virgule + 2), telephone});
+        }
+        return cles;
+    }
+
+    bool toutEcrire(int p_fd, const std::string& p_tampon) {
+        size_t ecrits = 0;
+        while (ecrits < p_tampon.size()) {
+            const ssize_t n = send(p_fd, p_tampon.data() + ecrits, p_tampon.size() - ecrits, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            ecrits += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool toutLire(int p_fd, char* p_tampon, size_t p_taille) {
+        size_t lus = 0;
+        while (lus < p_taille) {
+            const ssize_t n = read(p_fd, p_tampon + lus, p_taille - lus);
+            if (n <= 0) return false;
+            lus += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * \brief Exécute les requêtes d'une connexion et retourne leurs latences, en microsecondes.
+     */
+    std::vector<double> executerConnexion(const std::string& p_socket, const std::vector<Cle>& p_cles,
+                                          size_t p_premiere, size_t p_requetes, size_t p_profondeur) {
+        std::vector<double> latences;
+        const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un adresse{};
+        adresse.sun_family = AF_UNIX;
+        std::strncpy(adresse.sun_path, p_socket.c_str(), sizeof(adresse.sun_path) - 1);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) < 0) {
+            std::cerr << "Erreur : connexion à " << p_socket << " impossible : " << std::strerror(errno) << std::endl;
+            if (fd >= 0) close(fd);
+            return latences;
+        }
+
+        std::vector<Horloge::time_point> envois(p_requetes);
+        latences.reserve(p_requetes);
+        size_t envoyees = 0;
+        std::string tampon;
+        std::string reponse;
+        while (latences.size() < p_requetes) {
+            // Compléter la fenêtre de requêtes en vol
+            tampon.clear();
+            while (envoyees < p_requetes && envoyees - latences.size() < p_profondeur) {
+                const Cle& cle = p_cles[(p_premiere + envoyees) % p_cles.size()];
+                protocole::Ecrivain ecrivain(tampon);
+                ecrivain.u32(static_cast<uint32_t>(envoyees));
+                if (envoyees % 5 == 0) {
+                    ecrivain.u8(static_cast<uint8_t>(protocole::TypeRequete::NOM_PRENOM));
+                    ecrivain.texte(cle.m_nom);
+                    ecrivain.texte(cle.m_prenom);
+                } else {
+                    ecrivain.u8(static_cast<uint8_t>(protocole::TypeRequete::TELEPHONE));
+                    ecrivain.texte(cle.m_telephone);
+                }
+                ecrivain.terminer();
+                envois[envoyees++] = Horloge::now();
+            }
+            if (!tampon.empty() && !toutEcrire(fd, tampon)) break;
+
+            uint32_t longueur;
+            if (!toutLire(fd, reinterpret_cast<char*>(&longueur), sizeof(longueur))) break;
+            reponse.resize(longueur);
+            if (!toutLire(fd, reponse.data(), longueur)) break;
+            protocole::Lecteur lecteur(reponse);
+            const uint32_t identifiant = lecteur.u32();
+            if (!lecteur.valide() || identifiant >= envoyees) break;
+            latences.push_back(std::chrono::duration<double, std::micro>(Horloge::now() - envois[identifiant]).count());
+        }
+        close(fd);
+        return latences;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage : " << argv[0]
+                  << " <socket> [fichier=Bottin.txt] [connexions=4] [requetes=100000] [profondeur=16]" << std::endl;
+        return 1;
+    }
+    const std::string socket = argv[1];
+    const std::string fichier = argc > 2 ? argv[2] : "Bottin.txt";
+    const size_t nbConnexions = argc > 3 ? std::stoul(argv[3]) : 4;
+    const size_t nbRequetes = argc > 4 ? std::stoul(argv[4]) : 100000;
+    const size_t profondeur = argc > 5 ? std::max<size_t>(1, std::stoul(argv[5])) : 16;
+
+    const std::vector<Cle> cles = lireCles(fichier);
+    if (cles.empty()) {
+        std::cerr << "Erreur : aucune clé lue dans " << fichier << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<double> > latencesParConnexion(nbConnexions);
+    std::vector<std::thread> fils;
+    const Horloge::time_point debut = Horloge::now();
+    for (size_t i = 0; i < nbConnexions; ++i) {
+        const size_t requetes = nbRequetes / nbConnexions + (i < nbRequetes % nbConnexions ? 1 : 0);
+        fils.emplace_back([&, i, requetes]() {
+            latencesParConnexion[i] = executerConnexion(socket, cles, i * 7919, requetes, profondeur);
+        });
+    }
+    for (std::thread& fil : fils) {
+        fil.join();
+    }
+    const double secondes = std::chrono::duration<double>(Horloge::now() - debut).count();
+
+    std::vector<double> latences;
+    for (const std::vector<double>& latencesConnexion : latencesParConnexion) {
+        latences.insert(latences.end(), latencesConnexion.begin(), latencesConnexion.end());
+    }
+    if (latences.empty()) {
+        std::cerr << "Erreur : aucune réponse reçue" << std::endl;
+        return 1;
+    }
+    std::sort(latences.begin(), latences.end());
+    auto quantile = [&latences](double p_q) { return latences[static_cast<size_t>(p_q * (latences.size() - 1))]; };
+
+    std::cout << "Réponses : " << latences.size() << " en " << secondes << " s" << std::endl;
+    std::cout << "Débit : " << latences.size() / secondes << " requêtes/s" << std::endl;
+    std::cout << "Latence (us) : p50 " << quantile(0.50) << ", p99 " << quantile(0.99)
+              << ", p99.9 " << quantile(0.999) << ", max " << latences.back() << std::endl;
+    return latences.size() == nbRequetes ? 0 : 1;
+}
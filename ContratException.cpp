@@ -89,3 +89,51 @@ PostconditionException::PostconditionException (const std::string& p_fichier, un
 InvariantException::InvariantException (const std::string& p_fichier, unsigned int p_ligne,
                                         const std::string& p_expression)
 : ContratException (p_fichier, p_ligne, p_expression, "ERREUR D'INVARIANT") { }
+
+
+/**
+ * \brief Lance une AssertionException; appelée par les macros seulement en cas d'échec
+ * \param p_fichier Le fichier source de la vérification
+ * \param p_ligne La ligne de la vérification
+ * \param p_expression Test logique qui a échoué
+ */
+void lancerAssertion (const char* p_fichier, unsigned int p_ligne, const char* p_expression)
+{
+  throw AssertionException (p_fichier, p_ligne, p_expression);
+}
+
+
+/**
+ * \brief Lance une PreconditionException; appelée par les macros seulement en cas d'échec
+ * \param p_fichier Le fichier source de la vérification
+ * \param p_ligne La ligne de la vérification
+ * \param p_expression Test logique qui a échoué
+ */
+void lancerPrecondition (const char* p_fichier, unsigned int p_ligne, const char* p_expression)
+{
+  throw PreconditionException (p_fichier, p_ligne, p_expression);
+}
+
+
+/**
+ * \brief Lance une PostconditionException; appelée par les macros seulement en cas d'échec
+ * \param p_fichier Le fichier source de la vérification
+ * \param p_ligne La ligne de la vérification
+ * \param p_expression Test logique qui a échoué
+ */
+void lancerPostcondition (const char* p_fichier, unsigned int p_ligne, const char* p_expression)
+{
+  throw PostconditionException (p_fichier, p_ligne, p_expression);
+}
+
+
+/**
+ * \brief Lance une InvariantException; appelée par les macros seulement en cas d'échec
+ * \param p_fichier Le fichier source de la vérification
+ * \param p_ligne La ligne de la vérification
+ * \param p_expression Test logique qui a échoué
+ */
+void lancerInvariant (const char* p_fichier, unsigned int p_ligne, const char* p_expression)
+{
+  throw InvariantException (p_fichier, p_ligne, p_expression);
+}
@@ -7,7 +7,18 @@
  * la sauvegarde des renseignements de l'erreur.  Cette classe et sa
  * hiérarchie sont intéressantes lors de l'utilisation des exceptions.
  *
- * En release, définir la constante NDEBUG pour désactiver les Macros
+ * Les macros sont vérifiées selon CONTRAT_NIVEAU :
+ *  - 0 : aucune vérification;
+ *  - 1 : vérifications peu coûteuses (PRECONDITION, POSTCONDITION, ASSERTION,
+ *        INVARIANT); défaut quand NDEBUG est défini;
+ *  - 2 : en plus, les vérifications d'audit (PRECONDITION_AUDIT, ...,
+ *        INVARIANTS()), qui sondent une table ou parcourent une structure;
+ *        défaut sans NDEBUG.
+ * Le niveau peut être choisi pour tout le projet (option CMake CONTRAT_NIVEAU)
+ * ou par unité de traduction en définissant CONTRAT_NIVEAU avant la première
+ * inclusion. Un même gabarit doit toutefois être compilé au même niveau dans
+ * tout le programme. Le chemin d'échec est une fonction froide hors ligne :
+ * une vérification réussie ne coûte qu'un test et un branchement prévu.
  *
  * <pre>
  * Classes:
@@ -105,32 +116,74 @@ public:
 };
 
 
+// --- Lancement des exceptions, hors ligne pour garder le chemin d'échec froid
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CONTRAT_FROID __attribute__((cold, noinline))
+#else
+#define CONTRAT_FROID
+#endif
+
+[[noreturn]] CONTRAT_FROID void lancerAssertion (const char* p_fichier, unsigned int p_ligne, const char* p_expression);
+[[noreturn]] CONTRAT_FROID void lancerPrecondition (const char* p_fichier, unsigned int p_ligne, const char* p_expression);
+[[noreturn]] CONTRAT_FROID void lancerPostcondition (const char* p_fichier, unsigned int p_ligne, const char* p_expression);
+[[noreturn]] CONTRAT_FROID void lancerInvariant (const char* p_fichier, unsigned int p_ligne, const char* p_expression);
+
+
 // --- Définition des macros de contrôle de la théorie du contrat
 
-#if !defined(NDEBUG)
-// --- Mode debug
+#ifndef CONTRAT_NIVEAU
+#if defined(NDEBUG)
+#define CONTRAT_NIVEAU 1
+#else
+#define CONTRAT_NIVEAU 2
+#endif
+#endif
+
+#define CONTRAT_VERIFIER(f, lancer) \
+      do { if (!(f)) [[unlikely]] lancer(__FILE__, __LINE__, #f); } while (false)
+// L'expression reste compilée, sans être évaluée, pour que les variables qu'elle utilise le restent aussi
+#define CONTRAT_IGNORER(f) \
+      do { if (false) { (void) (f); } } while (false)
+
+#if CONTRAT_NIVEAU >= 1
+// --- Vérifications peu coûteuses
+
+#define ASSERTION(f)     CONTRAT_VERIFIER(f, lancerAssertion)
+#define PRECONDITION(f)  CONTRAT_VERIFIER(f, lancerPrecondition)
+#define POSTCONDITION(f) CONTRAT_VERIFIER(f, lancerPostcondition)
+#define INVARIANT(f)     CONTRAT_VERIFIER(f, lancerInvariant)
+
+#else
+
+#define ASSERTION(f)     CONTRAT_IGNORER(f)
+#define PRECONDITION(f)  CONTRAT_IGNORER(f)
+#define POSTCONDITION(f) CONTRAT_IGNORER(f)
+#define INVARIANT(f)     CONTRAT_IGNORER(f)
+
+#endif  // --- if CONTRAT_NIVEAU >= 1
+
+#if CONTRAT_NIVEAU >= 2
+// --- Vérifications d'audit : sondages de table, parcours complets
 
 #define INVARIANTS() \
       verifieInvariant()
 
-#define ASSERTION(f)     \
-      if (!(f)) throw AssertionException(__FILE__,__LINE__, #f);
-#define PRECONDITION(f)  \
-      if (!(f)) throw PreconditionException(__FILE__, __LINE__, #f);
-#define POSTCONDITION(f) \
-      if (!(f)) throw PostconditionException(__FILE__, __LINE__, #f);
-#define INVARIANT(f)   \
-      if (!(f)) throw InvariantException(__FILE__,__LINE__, #f);
+#define ASSERTION_AUDIT(f)     CONTRAT_VERIFIER(f, lancerAssertion)
+#define PRECONDITION_AUDIT(f)  CONTRAT_VERIFIER(f, lancerPrecondition)
+#define POSTCONDITION_AUDIT(f) CONTRAT_VERIFIER(f, lancerPostcondition)
+#define INVARIANT_AUDIT(f)     CONTRAT_VERIFIER(f, lancerInvariant)
 
-// --- LE MODE RELEASE
 #else
 
-#define PRECONDITION(f);
-#define POSTCONDITION(f);
-#define INVARIANTS();
-#define INVARIANT(f);
-#define ASSERTION(f);
+#define INVARIANTS() \
+      do { } while (false)
+
+#define ASSERTION_AUDIT(f)     CONTRAT_IGNORER(f)
+#define PRECONDITION_AUDIT(f)  CONTRAT_IGNORER(f)
+#define POSTCONDITION_AUDIT(f) CONTRAT_IGNORER(f)
+#define INVARIANT_AUDIT(f)     CONTRAT_IGNORER(f)
 
-#endif  // --- if !defined (NDEBUG)
+#endif  // --- if CONTRAT_NIVEAU >= 2
 #endif  // --- ifndef CONTRATEXCEPTION_H_DEJA_INCLU
 
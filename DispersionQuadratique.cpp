@@ -0,0 +1,112 @@
+/**
+ * \file DispersionQuadratique.cpp
+ * \brief Implantation des outils communs aux tables à redistribution quadratique
+ *
+ */
+#include "DispersionQuadratique.h"
+#include <algorithm>
+#include "ContratException.h"
+
+namespace labTableHachage
+{
+namespace dispersion
+{
+
+/**
+ * \brief Déterminer si un entier est premier
+ * \param[in] p_entier L'entier à tester
+ * \return Bool indiquant si l'entier est premier
+ */
+bool estPremier(size_t p_entier)
+{
+    if (p_entier <= 1)
+    {
+        return false;
+    }
+    if (p_entier == 2)
+    { // le seul nombre premier pair
+        return true;
+    }
+    if (p_entier % 2 == 0)
+    { // sinon, ce n'est pas un nombre premier
+        return false;
+    }
+
+    // Borne entière : la racine en float est inexacte au-delà de 2^24
+    for (size_t diviseur = 3; diviseur <= p_entier / diviseur; diviseur += 2)
+    {
+        if (p_entier % diviseur == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Retourner le prochain nombre premier à partir d'un certain entier
+ * \param[in] p_entier Entier de départ
+ * \return Le plus petit nombre premier impair d'au moins p_entier
+ */
+size_t prochainPremier(size_t p_entier)
+{
+    if (p_entier % 2 == 0)
+    {
+        p_entier++;
+    }
+    while (!estPremier(p_entier))
+    {
+        p_entier += 2;
+    }
+    return p_entier;
+}
+
+/**
+ * \brief Choisir la taille du prochain rehachage
+ *
+ * \param[in] p_taille Le nombre de cases
+ * \param[in] p_cardinalite Le nombre de cases occupées
+ * \param[in] p_nbEffaces Le nombre de cases effacées
+ * \return La taille actuelle si les cases effacées sont au moins aussi nombreuses
+ *         que les occupées (le rehachage les purge), sinon le premier suivant le double
+ */
+size_t tailleRehachage(size_t p_taille, size_t p_cardinalite, size_t p_nbEffaces)
+{
+    return p_nbEffaces >= p_cardinalite ? p_taille : prochainPremier(2 * p_taille);
+}
+
+} // Fin du namespace dispersion
+
+/**
+ * \brief Ajouter les insertions comptées ailleurs, par exemple par un fil de rehachage
+ * \param[in] p_autres Les statistiques à ajouter
+ */
+void StatistiquesCollisions::fusionner(const StatistiquesCollisions & p_autres)
+{
+    m_nInsertions += p_autres.m_nInsertions;
+    m_nCollisions += p_autres.m_nCollisions;
+    m_maximumCollisionUneInsertion = std::max(m_maximumCollisionUneInsertion, p_autres.m_maximumCollisionUneInsertion);
+}
+
+/**
+ * \brief Remettre les compteurs à zéro, au début d'un rehachage
+ */
+void StatistiquesCollisions::reinitialiser()
+{
+    *this = StatistiquesCollisions();
+}
+
+/**
+ * \brief Calcule les statistiques du nombre moyen de collisions par insertion.
+ * \pre Au moins une insertion a été comptée
+ */
+void StatistiquesCollisions::statistiques(double& p_ratio, size_t& p_nbCollisions,
+                                          size_t& p_maximumCollisionUneInsertion) const
+{
+    PRECONDITION(m_nInsertions > 0);
+    p_ratio = (double) (m_nCollisions) / (double) (m_nInsertions);
+    p_nbCollisions = m_nCollisions;
+    p_maximumCollisionUneInsertion = m_maximumCollisionUneInsertion;
+}
+
+} //Fin du namespace
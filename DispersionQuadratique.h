@@ -0,0 +1,172 @@
+/**
+ * \file DispersionQuadratique.h
+ * \brief Outils communs aux tables à redistribution quadratique.
+ *
+ *	Tailles premières, taux de remplissage, séquence de sondage, fragment de
+ *	la valeur de hachage et statistiques de collisions : TableHachage,
+ *	TableHachageIndex et TableHachageMulti partagent ces règles.
+ *
+ */
+
+#ifndef DISPERSIONQUADRATIQUE_H_
+#define DISPERSIONQUADRATIQUE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace labTableHachage
+{
+namespace dispersion
+{
+
+static const size_t TAUX_MAX = 50; /*!< Taux de remplissage maximum (en %), cases effacées comprises */
+static const size_t SEUIL_REHACHAGE_PARALLELE = 1 << 16; /*!< Éléments à partir desquels le rehachage est réparti entre des travailleurs */
+static const size_t TAILLE_BLOC_REHACHAGE = 1 << 14; /*!< Cases de l'ancien tableau par bloc d'un rehachage réparti */
+static const size_t SEUIL_COLLISIONS_GRAINE = 64; /*!< Collisions d'une insertion au-delà desquelles la graine est changée */
+
+bool estPremier(size_t p_entier);
+size_t prochainPremier(size_t p_entier);
+
+/**
+ * \brief Nombre de cases occupées ou effacées à partir duquel une table doit être rehachée
+ *
+ * \param[in] p_taille Le nombre de cases de la table
+ * \return Le plus petit n tel que n * 100 >= TAUX_MAX * p_taille, sans produit qui puisse déborder
+ */
+inline size_t seuilRemplissage(size_t p_taille)
+{
+    return p_taille / 100 * TAUX_MAX + (p_taille % 100 * TAUX_MAX + 99) / 100;
+}
+
+/**
+ * \brief Déterminer si une table doit être rehachée
+ *
+ * Les cases effacées comptent : sans elles, une suite d'insertions et de
+ * retraits finirait par ne laisser aucune case vacante pour arrêter le sondage.
+ *
+ * \param[in] p_taille Le nombre de cases
+ * \param[in] p_cardinalite Le nombre de cases occupées
+ * \param[in] p_nbEffaces Le nombre de cases effacées
+ */
+inline bool doitEtreRehachee(size_t p_taille, size_t p_cardinalite, size_t p_nbEffaces)
+{
+    return p_cardinalite + p_nbEffaces >= seuilRemplissage(p_taille);
+}
+
+size_t tailleRehachage(size_t p_taille, size_t p_cardinalite, size_t p_nbEffaces);
+
+/**
+ * \brief Tirer une nouvelle graine pour un foncteur de hachage, s'il en a une
+ *
+ * Une table qui l'appelle après une insertion de plus de SEUIL_COLLISIONS_GRAINE
+ * collisions doit ensuite se rehacher : des clefs fabriquées pour collisionner
+ * sous l'ancienne graine sont dispersées par la nouvelle.
+ *
+ * \param[in,out] p_hachage Le foncteur de la table
+ * \return Vrai si le foncteur a regenererGraine()
+ */
+template<class FoncteurHachage>
+bool regenererGraine(FoncteurHachage & p_hachage)
+{
+    if constexpr (requires { p_hachage.regenererGraine(); })
+    {
+        p_hachage.regenererGraine();
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/**
+ * \brief Fragment de 32 bits conservé dans une case avec l'index d'une entrée
+ * \param[in] p_valeurHachee La valeur de hachage complète
+ * \return Les 32 bits de poids faible repliés sur ceux de poids fort
+ */
+inline uint32_t fragment(size_t p_valeurHachee)
+{
+    const uint64_t valeur = static_cast<uint64_t>(p_valeurHachee);
+    return static_cast<uint32_t>(valeur ^ (valeur >> 32));
+}
+
+/**
+ * \class Sondage
+ *
+ * \brief Séquence des positions sondées pour une valeur de hachage
+ *
+ *  La position de départ est la valeur modulo la taille, puis le i-ème essai
+ *  est à (départ + i * i) modulo la taille. Avec une taille première et un
+ *  taux de remplissage d'au plus 50 %, une case libre est toujours atteinte.
+ */
+class Sondage
+{
+public:
+    Sondage(size_t p_valeurHachee, size_t p_taille) :
+    m_depart(p_valeurHachee % p_taille), m_position(m_depart), m_essai(0), m_taille(p_taille)
+    {
+    }
+
+    size_t position() const
+    {
+        return m_position;
+    }
+
+    /**
+     * \brief Nombre de positions déjà écartées (collisions)
+     */
+    size_t collisions() const
+    {
+        return m_essai;
+    }
+
+    void suivant()
+    {
+        ++m_essai;
+        m_position = (m_depart + m_essai * m_essai) % m_taille;
+    }
+
+private:
+    size_t m_depart;
+    size_t m_position;
+    size_t m_essai;
+    size_t m_taille;
+};
+
+} // Fin du namespace dispersion
+
+/**
+ * \class StatistiquesCollisions
+ *
+ * \brief Collisions subies par les insertions d'une table depuis son dernier rehachage
+ */
+class StatistiquesCollisions
+{
+public:
+    /**
+     * \brief Compter une insertion
+     * \param[in] p_nbCollisions Le nombre de collisions subies par l'insertion
+     */
+    void compter(size_t p_nbCollisions)
+    {
+        ++m_nInsertions;
+        m_nCollisions += p_nbCollisions;
+        if (p_nbCollisions > m_maximumCollisionUneInsertion)
+        {
+            m_maximumCollisionUneInsertion = p_nbCollisions;
+        }
+    }
+
+    void fusionner(const StatistiquesCollisions & p_autres);
+    void reinitialiser();
+    void statistiques(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const;
+
+private:
+    size_t m_nInsertions = 0; /*!< Nombre d'insertions au total*/
+    size_t m_nCollisions = 0; /*!< Le nombre de collisions au total*/
+    size_t m_maximumCollisionUneInsertion = 0; /*!< Le nombre maximal de collisions au pour une insertion*/
+};
+
+} //Fin du namespace
+
+#endif
@@ -0,0 +1,388 @@
+/**
+ * \file DonneesSynthetiques.cpp
+ * \brief Implantation du générateur de bottins synthétiques.
+ */
+#include "DonneesSynthetiques.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace TP3 {
+
+namespace {
+    const char* const NOMS_COURANTS[] = {
+        "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis", "Rodriguez", "Martinez",
+        "Hernandez", "Lopez", "Gonzalez", "Wilson", "Anderson", "Thomas", "Taylor", "Moore", "Jackson", "Martin",
+        "Lee", "Perez", "Thompson", "White", "Harris", "Sanchez", "Clark", "Ramirez", "Lewis", "Robinson",
+        "Walker", "Young", "Allen", "King", "Wright", "Scott", "Torres", "Nguyen", "Hill", "Flores",
+        "Green", "Adams", "Nelson", "Baker", "Hall", "Rivera", "Campbell", "Mitchell", "Carter", "Roberts",
+        "Tremblay", "Gagnon", "Roy", "Cote", "Bouchard", "Gauthier", "Morin", "Lavoie", "Fortin", "Gagne",
+        "Ouellet", "Pelletier", "Belanger", "Levesque", "Bergeron", "Leblanc", "Paquette", "Girard", "Simard", "Boucher",
+        "Chen", "Wang", "Li", "Zhang", "Liu", "Yang", "Huang", "Zhao", "Wu", "Zhou",
+        "Kim", "Park", "Choi", "Tanaka", "Suzuki", "Sato", "Patel", "Shah", "Singh", "Kumar",
+        "Abbott", "Abplanalp", "Acevedo", "Acredolo", "Majdoub", "Okafor", "Mensah", "Haddad", "Nasser", "Kowalski"
+    };
+
+    const char* const PRENOMS_COURANTS[] = {
+        "James", "Mary", "Robert", "Patricia", "John", "Jennifer", "Michael", "Linda", "David", "Elizabeth",
+        "William", "Barbara", "Richard", "Susan", "Joseph", "Jessica", "Thomas", "Sarah", "Charles", "Karen",
+        "Daniel", "Lisa", "Matthew", "Nancy", "Anthony", "Betty", "Mark", "Sandra", "Steven", "Ashley",
+        "Jean", "Marie", "Pierre", "Louise", "Francois", "Julie", "Mathieu", "Isabelle", "Olivier", "Catherine",
+        "Wei", "Mei", "Jun", "Yuki", "Hiro", "Aiko", "Min", "Ji", "Ravi", "Priya",
+        "Ahmed", "Fatima", "Omar", "Layla", "Fares", "Amina", "Kwame", "Ama", "Chen", "Ursula",
+        "Hans", "Myriam", "Curt", "Carl", "Helene", "Sofia", "Lucas", "Emma", "Noah", "Olivia"
+    };
+
+    const char* const SYLLABES[] = {
+        "ber", "lan", "mor", "tis", "va", "den", "ko", "ri", "sa", "mel", "gar", "ton", "vi", "lo", "chen",
+        "na", "dal", "ru", "fer", "ha", "lin", "mo", "quin", "sel", "tra", "wen", "zel", "ba", "cor", "du",
+        "ei", "ga", "jo", "ki", "mu", "pe", "sto", "ul", "ya", "bran"
+    };
+
+    const char* const DOMAINES_COURANTS[] = {
+        "gmail.com", "outlook.com", "yahoo.com", "hotmail.com", "icloud.com", "ulaval.ca", "ucdavis.edu",
+        "ucop.edu", "videotron.ca", "bell.net", "proton.me", "umontreal.ca", "mcgill.ca", "ucr.edu"
+    };
+
+    const char* const SUFFIXES_DOMAINES[] = {".com", ".ca", ".org", ".net", ".edu"};
+
+    constexpr size_t TAILLE_BASSIN_NOMS = 20000;
+    constexpr size_t TAILLE_BASSIN_PRENOMS = 3000;
+    constexpr size_t NOMBRE_RECENTS = 4096; /*!< Entrées dont on peut tirer un quasi-doublon */
+    constexpr size_t NUMEROS_PAR_INDICATIF = 800 * 10000; /*!< Centraux 200 à 999, lignes 0000 à 9999 */
+    constexpr int ESSAIS_INDICATIF_ZIPF = 16; /*!< Numéros déjà pris avant de tirer l'indicatif uniformément */
+    constexpr size_t TAILLE_TAMPON = 1 << 20;
+
+    /**
+     * \brief Générateur splitmix64 : petit, rapide et identique sur toutes les plateformes.
+     */
+    class Aleatoire {
+    public:
+        explicit Aleatoire(uint64_t p_graine) : m_etat(p_graine) {}
+
+        uint64_t suivant() {
+            uint64_t z = (m_etat += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+        /**
+         * \brief Entier uniforme dans [0, p_borne), par multiplication (biais négligeable)
+         */
+        size_t entier(size_t p_borne) {
+            return static_cast<size_t>((static_cast<unsigned __int128>(suivant()) * p_borne) >> 64);
+        }
+        /**
+         * \brief Réel uniforme dans [0, 1)
+         */
+        double reel() {
+            return static_cast<double>(suivant() >> 11) * 0x1.0p-53;
+        }
+
+    private:
+        uint64_t m_etat;
+    };
+
+    /**
+     * \brief Loi de Zipf sur les rangs [0, n) : le rang k a un poids 1 / (k + 1)^s.
+     */
+    class LoiZipf {
+    public:
+        LoiZipf(size_t p_n, double p_exposant) : m_cumul(p_n) {
+            double somme = 0;
+            for (size_t k = 0; k < p_n; ++k) {
+                somme += 1.0 / std::pow(static_cast<double>(k + 1), p_exposant);
+                m_cumul[k] = somme;
+            }
+            for (double& valeur : m_cumul) {
+                valeur /= somme;
+            }
+        }
+
+        size_t tirer(Aleatoire& p_aleatoire) const {
+            const auto position = std::upper_bound(m_cumul.begin(), m_cumul.end(), p_aleatoire.reel());
+            return std::min<size_t>(position - m_cumul.begin(), m_cumul.size() - 1);
+        }
+
+    private:
+        std::vector<double> m_cumul;
+    };
+
+    /**
+     * \brief Ensemble d'entiers non nuls à adressage ouvert, pour vérifier l'unicité sans allouer par clé.
+     */
+    class EnsembleEntiers {
+    public:
+        explicit EnsembleEntiers(size_t p_capacite) {
+            size_t taille = 16;
+            while (taille < 2 * p_capacite) taille <<= 1;
+            m_cases.assign(taille, 0);
+        }
+
+        /**
+         * \return Faux si la valeur était déjà présente
+         */
+        bool inserer(uint64_t p_valeur) {
+            const size_t masque = m_cases.size() - 1;
+            size_t position = static_cast<size_t>((p_valeur * 0x9e3779b97f4a7c15ull) >> 20) & masque;
+            while (m_cases[position] != 0) {
+                if (m_cases[position] == p_valeur) return false;
+                position = (position + 1) & masque;
+            }
+            m_cases[position] = p_valeur;
+            return true;
+        }
+
+    private:
+        std::vector<uint64_t> m_cases;
+    };
+
+    char minuscule(char p_c) {
+        return (p_c >= 'A' && p_c <= 'Z') ? static_cast<char>(p_c - 'A' + 'a') : p_c;
+    }
+
+    /**
+     * \brief Empreinte de la clé nom/prénom sans la casse, jamais nulle
+     */
+    uint64_t empreinteCle(std::string_view p_nom, std::string_view p_prenom) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : p_nom) h = (h ^ static_cast<unsigned char>(minuscule(c))) * 0x100000001b3ull;
+        h = (h ^ '\t') * 0x100000001b3ull;
+        for (char c : p_prenom) h = (h ^ static_cast<unsigned char>(minuscule(c))) * 0x100000001b3ull;
+        return h == 0 ? 1 : h;
+    }
+
+    std::string nomInvente(Aleatoire& p_aleatoire, size_t p_minSyllabes) {
+        std::string nom;
+        const size_t nbSyllabes = p_minSyllabes + p_aleatoire.entier(2);
+        for (size_t i = 0; i < nbSyllabes; ++i) {
+            nom += SYLLABES[p_aleatoire.entier(std::size(SYLLABES))];
+        }
+        nom[0] = static_cast<char>(nom[0] - 'a' + 'A');
+        return nom;
+    }
+
+    /**
+     * \brief Bassin de p_taille noms distincts : les noms courants d'abord (rangs les plus fréquents), puis des noms inventés
+     */
+    template<size_t N>
+    std::vector<std::string> bassin(const char* const (&p_courants)[N], size_t p_taille, Aleatoire& p_aleatoire) {
+        std::vector<std::string> noms(std::begin(p_courants), std::end(p_courants));
+        std::unordered_set<std::string> vus(noms.begin(), noms.end());
+        while (noms.size() < p_taille) {
+            std::string nom = nomInvente(p_aleatoire, 2);
+            if (vus.insert(nom).second) noms.push_back(std::move(nom));
+        }
+        return noms;
+    }
+
+    std::vector<std::string> domaines(size_t p_nombre, Aleatoire& p_aleatoire) {
+        std::vector<std::string> resultat(std::begin(DOMAINES_COURANTS), std::end(DOMAINES_COURANTS));
+        resultat.resize(std::min(resultat.size(), p_nombre));
+        std::unordered_set<std::string> vus(resultat.begin(), resultat.end());
+        while (resultat.size() < p_nombre) {
+            std::string domaine = nomInvente(p_aleatoire, 2);
+            domaine[0] = minuscule(domaine[0]);
+            domaine += SUFFIXES_DOMAINES[p_aleatoire.entier(std::size(SUFFIXES_DOMAINES))];
+            if (vus.insert(domaine).second) resultat.push_back(std::move(domaine));
+        }
+        return resultat;
+    }
+
+    /**
+     * \brief Indicatifs régionaux distincts de la forme NXX, sauf N11
+     */
+    std::vector<unsigned> indicatifs(size_t p_nombre, Aleatoire& p_aleatoire) {
+        std::vector<unsigned> resultat;
+        std::vector<bool> pris(1000, false);
+        while (resultat.size() < p_nombre) {
+            const unsigned indicatif = static_cast<unsigned>(200 + p_aleatoire.entier(800));
+            if (indicatif % 100 == 11 || pris[indicatif]) continue;
+            pris[indicatif] = true;
+            resultat.push_back(indicatif);
+        }
+        return resultat;
+    }
+
+    /**
+     * \brief Numéro complet à 10 chiffres dans un indicatif donné
+     */
+    uint64_t numero(unsigned p_indicatif, Aleatoire& p_aleatoire) {
+        const uint64_t central = 200 + p_aleatoire.entier(800);
+        const uint64_t ligne = p_aleatoire.entier(10000);
+        return static_cast<uint64_t>(p_indicatif) * 10000000 + central * 10000 + ligne;
+    }
+
+    void ajouterTelephone(std::string& p_tampon, uint64_t p_numero) {
+        char texte[15] = "(ddd) ddd-dddd";
+        const int positions[10] = {1, 2, 3, 6, 7, 8, 10, 11, 12, 13};
+        for (int i = 9; i >= 0; --i) {
+            texte[positions[i]] = static_cast<char>('0' + p_numero % 10);
+            p_numero /= 10;
+        }
+        p_tampon.append(texte, 14);
+    }
+
+    /**
+     * \brief Altère une lettre minuscule d'un mot, comme une faute de frappe; la majuscule initiale est gardée
+     * \return Faux si le mot est trop court pour être altéré
+     */
+    bool alterer(std::string& p_mot, Aleatoire& p_aleatoire) {
+        const size_t longueur = p_mot.find(' ') == std::string::npos ? p_mot.size() : p_mot.find(' ');
+        if (longueur < 3) return false;
+        const size_t i = 1 + p_aleatoire.entier(longueur - 1);
+        switch (p_aleatoire.entier(4)) {
+            case 0:
+                if (i + 1 >= longueur) return false;
+                std::swap(p_mot[i], p_mot[i + 1]);
+                break;
+            case 1:
+                if (longueur < 4) return false;
+                p_mot.erase(i, 1);
+                break;
+            case 2:
+                p_mot.insert(i, 1, p_mot[i]);
+                break;
+            default:
+                p_mot[i] = static_cast<char>('a' + p_aleatoire.entier(26));
+                break;
+        }
+        return true;
+    }
+
+    void ajouterCourriel(std::string& p_tampon, const std::string& p_nom, const std::string& p_prenom,
+                         const std::string& p_domaine, Aleatoire& p_aleatoire) {
+        const size_t finPrenom = std::min(p_prenom.find(' '), p_prenom.size());
+        switch (p_aleatoire.entier(3)) {
+            case 0:
+                p_tampon += minuscule(p_prenom[0]);
+                break;
+            case 1:
+                for (size_t i = 0; i < finPrenom; ++i) p_tampon += minuscule(p_prenom[i]);
+                p_tampon += '.';
+                break;
+            default:
+                break;
+        }
+        for (char c : p_nom) p_tampon += minuscule(c);
+        if (p_aleatoire.entier(4) == 0) {
+            p_tampon += static_cast<char>('0' + p_aleatoire.entier(10));
+            p_tampon += static_cast<char>('0' + p_aleatoire.entier(10));
+        }
+        p_tampon += '@';
+        p_tampon += p_domaine;
+    }
+}
+
+    /**
+     * \brief Écrit un bottin synthétique au format de Bottin.txt.
+     * \param[out] p_sortie Le flux où écrire le fichier.
+     * \param[in] p_parametres Taille, graine et lois du fichier.
+     * \pre Au moins un domaine et entre 1 et 700 indicatifs.
+     * \pre Les indicatifs suffisent aux téléphones fixes uniques, à moitié remplis au plus; quelle que
+     * soit l'asymétrie, les indicatifs favoris épuisés se déversent sur les autres.
+     * \post p_parametres.m_lignes entrées valides, de clés nom/prénom et de téléphones fixes uniques, sont écrites.
+     */
+void genererDonnees(std::ostream& p_sortie, const ParametresDonnees& p_parametres) {
+    PRECONDITION(p_parametres.m_nombreDomaines >= 1);
+    PRECONDITION(p_parametres.m_nombreIndicatifs >= 1 && p_parametres.m_nombreIndicatifs <= 700);
+    PRECONDITION(p_parametres.m_lignes <= p_parametres.m_nombreIndicatifs * NUMEROS_PAR_INDICATIF / 2);
+
+    Aleatoire aleatoire(p_parametres.m_graine);
+    const std::vector<std::string> noms = bassin(NOMS_COURANTS, TAILLE_BASSIN_NOMS, aleatoire);
+    const std::vector<std::string> prenoms = bassin(PRENOMS_COURANTS, TAILLE_BASSIN_PRENOMS, aleatoire);
+    const std::vector<std::string> lesDomaines = domaines(p_parametres.m_nombreDomaines, aleatoire);
+    const std::vector<unsigned> lesIndicatifs = indicatifs(p_parametres.m_nombreIndicatifs, aleatoire);
+
+    const LoiZipf loiNoms(noms.size(), p_parametres.m_asymetrieNoms);
+    const LoiZipf loiPrenoms(prenoms.size(), p_parametres.m_asymetrieNoms);
+    const LoiZipf loiDomaines(lesDomaines.size(), p_parametres.m_asymetrieDomaines);
+    const LoiZipf loiIndicatifs(lesIndicatifs.size(), p_parametres.m_asymetrieIndicatifs);
+
+    EnsembleEntiers clesPrises(p_parametres.m_lignes);
+    EnsembleEntiers telephonesPris(p_parametres.m_lignes);
+    std::vector<std::pair<std::string, std::string> > recents;
+    recents.reserve(NOMBRE_RECENTS);
+
+    std::string tampon = std::to_string(p_parametres.m_lignes) + "\n";
+    tampon.reserve(TAILLE_TAMPON + 256);
+    std::string nom, prenom;
+    for (size_t ligne = 0; ligne < p_parametres.m_lignes; ++ligne) {
+        // Clé nom/prénom : un quasi-doublon d'une entrée récente, sinon un tirage; en cas de
+        // conflit, une initiale puis un numéro départagent
+        bool trouve = false;
+        if (!recents.empty() && aleatoire.reel() < p_parametres.m_tauxQuasiDoublons) {
+            for (int essai = 0; essai < 8 && !trouve; ++essai) {
+                const auto& source = recents[aleatoire.entier(recents.size())];
+                nom = source.first;
+                prenom = source.second;
+                if (alterer(aleatoire.entier(2) == 0 ? nom : prenom, aleatoire)) {
+                    trouve = clesPrises.inserer(empreinteCle(nom, prenom));
+                }
+            }
+        }
+        for (int essai = 0; !trouve; ++essai) {
+            if (essai < 4) {
+                nom = noms[loiNoms.tirer(aleatoire)];
+                prenom = prenoms[loiPrenoms.tirer(aleatoire)];
+                if (aleatoire.entier(5) < 2) {
+                    prenom += ' ';
+                    prenom += static_cast<char>('A' + aleatoire.entier(26));
+                }
+            } else if (essai < 12) {
+                prenom += ' ';
+                prenom += static_cast<char>('A' + aleatoire.entier(26));
+            } else {
+                prenom += ' ';
+                prenom += std::to_string(aleatoire.entier(1000000));
+            }
+            trouve = clesPrises.inserer(empreinteCle(nom, prenom));
+        }
+        if (recents.size() < NOMBRE_RECENTS) {
+            recents.emplace_back(nom, prenom);
+        } else {
+            recents[ligne % NOMBRE_RECENTS] = {nom, prenom};
+        }
+
+        // Les indicatifs favoris finissent par s'épuiser : après quelques numéros déjà pris,
+        // l'indicatif est tiré uniformément, et la moitié au moins des numéros restent libres
+        uint64_t fixe = 0;
+        for (int essai = 0;; ++essai) {
+            const size_t indicatif = essai < ESSAIS_INDICATIF_ZIPF ? loiIndicatifs.tirer(aleatoire)
+                                                                  : aleatoire.entier(lesIndicatifs.size());
+            fixe = numero(lesIndicatifs[indicatif], aleatoire);
+            if (telephonesPris.inserer(fixe)) {
+                break;
+            }
+        }
+        // Le cellulaire partage d'habitude l'indicatif du fixe; il n'a pas à être unique
+        const unsigned indicatifFixe = static_cast<unsigned>(fixe / 10000000);
+        const uint64_t cellulaire = numero(aleatoire.entier(10) < 7 ? indicatifFixe
+                                           : lesIndicatifs[loiIndicatifs.tirer(aleatoire)], aleatoire);
+
+        tampon += nom;
+        tampon += ", ";
+        tampon += prenom;
+        tampon += '\t';
+        ajouterTelephone(tampon, fixe);
+        tampon += '\t';
+        ajouterTelephone(tampon, cellulaire);
+        tampon += '\t';
+        ajouterCourriel(tampon, nom, prenom, lesDomaines[loiDomaines.tirer(aleatoire)], aleatoire);
+        tampon += '\n';
+
+        if (tampon.size() >= TAILLE_TAMPON) {
+            p_sortie.write(tampon.data(), static_cast<std::streamsize>(tampon.size()));
+            tampon.clear();
+        }
+    }
+    p_sortie.write(tampon.data(), static_cast<std::streamsize>(tampon.size()));
+    p_sortie.flush();
+}
+
+} // namespace TP3
@@ -0,0 +1,47 @@
+/**
+ * \file DonneesSynthetiques.h
+ * \brief Génération reproductible de fichiers de bottin synthétiques.
+ *
+ * Le fichier produit a le format de Bottin.txt : une ligne d'en-tête donnant
+ * le nombre d'entrées, puis « Nom, Prénom », téléphone fixe, cellulaire et
+ * courriel séparés par des tabulations. Les noms, prénoms, domaines de
+ * courriel et indicatifs régionaux suivent des lois de Zipf d'exposants
+ * réglables (0 pour une loi uniforme); une part des entrées sont des
+ * quasi-doublons d'entrées récentes (lettres inversées, omises, doublées ou
+ * remplacées). Les clés nom/prénom sont uniques même après normalisation
+ * (casse) et les téléphones fixes sont uniques : le fichier se charge
+ * dans un Bottin, en comparaison exacte comme normalisée.
+ *
+ * Le générateur pseudo-aléatoire et les lois sont implantés ici plutôt que
+ * pris de <random>, dont les distributions varient d'une bibliothèque
+ * standard à l'autre : une même graine donne le même fichier partout.
+ */
+#ifndef DONNEESSYNTHETIQUES_H
+#define DONNEESSYNTHETIQUES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace TP3 {
+
+/**
+ * \struct ParametresDonnees
+ * \brief Paramètres d'un fichier synthétique.
+ */
+struct ParametresDonnees {
+    size_t m_lignes = 1000000;
+    uint64_t m_graine = 42;
+    double m_asymetrieNoms = 1.0; /*!< Exposant de Zipf des noms et des prénoms */
+    size_t m_nombreDomaines = 200;
+    double m_asymetrieDomaines = 1.2;
+    size_t m_nombreIndicatifs = 60; /*!< Indicatifs régionaux distincts, au plus 700 */
+    double m_asymetrieIndicatifs = 0.8;
+    double m_tauxQuasiDoublons = 0.02; /*!< Part des entrées dérivées d'une entrée récente */
+};
+
+void genererDonnees(std::ostream& p_sortie, const ParametresDonnees& p_parametres);
+
+} // namespace TP3
+
+#endif // DONNEESSYNTHETIQUES_H
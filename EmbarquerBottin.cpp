@@ -0,0 +1,126 @@
+/**
+ * \file EmbarquerBottin.cpp
+ * \brief Convertit un fichier de bottin en en-tête C++ pour BottinEmbarque.
+ *
+ * Usage : embarquer-bottin <entree.txt> <sortie.h> [identifiant]
+ *
+ * Le fichier d'entrée a le format de Bottin.txt (en-tête, puis « Nom, Prénom »,
+ * téléphone fixe, cellulaire et courriel séparés par des tabulations). L'en-tête
+ * produit déclare, dans TP3::embarque, le tableau constexpr ENTREES_<identifiant>
+ * et le BottinEmbarque constexpr <identifiant> (BOTTIN_EMBARQUE par défaut).
+ * La validation des entrées et l'unicité des clés sont vérifiées par le
+ * compilateur en construisant le bottin.
+ */
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Ligne {
+        std::string m_nom;
+        std::string m_prenom;
+        std::string m_telephoneFixe;
+        std::string m_cellulaire;
+        std::string m_courriel;
+    };
+
+    /**
+     * \brief Écrit un littéral de chaîne; les octets non imprimables ou non ASCII sont en octal
+     */
+    void ecrireLitteral(std::ostream& p_sortie, const std::string& p_texte) {
+        p_sortie << '"';
+        for (const char c : p_texte) {
+            const unsigned char octet = static_cast<unsigned char>(c);
+            if (octet < 0x20 || octet >= 0x7F || c == '"' || c == '\\' || c == '?') {
+                char echappement[5];
+                std::snprintf(echappement, sizeof(echappement), "\\%03o", octet);
+                p_sortie << echappement;
+            } else {
+                p_sortie << c;
+            }
+        }
+        p_sortie << '"';
+    }
+
+    std::vector<Ligne> lireBottin(std::istream& p_entree) {
+        std::vector<Ligne> lignes;
+        std::string ligne;
+        std::getline(p_entree, ligne); // en-tête
+        while (std::getline(p_entree, ligne)) {
+            if (ligne.empty()) {
+                continue;
+            }
+            std::stringstream ss(ligne);
+            std::string nomPrenom;
+            Ligne resultat;
+            std::getline(ss, nomPrenom, '\t');
+            std::getline(ss, resultat.m_telephoneFixe, '\t');
+            std::getline(ss, resultat.m_cellulaire, '\t');
+            std::getline(ss, resultat.m_courriel, '\t');
+
+            const size_t pos = nomPrenom.find(',');
+            if (pos != std::string::npos) {
+                resultat.m_nom = nomPrenom.substr(0, pos);
+                resultat.m_prenom = nomPrenom.substr(pos + 2);
+            } else {
+                resultat.m_nom = nomPrenom;
+            }
+            lignes.push_back(std::move(resultat));
+        }
+        return lignes;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "Usage : " << argv[0] << " <entree.txt> <sortie.h> [identifiant]" << std::endl;
+        return 1;
+    }
+    const std::string identifiant = argc > 3 ? argv[3] : "BOTTIN_EMBARQUE";
+
+    std::ifstream entree(argv[1]);
+    if (!entree.is_open()) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier '" << argv[1] << "'." << std::endl;
+        return 1;
+    }
+    const std::vector<Ligne> lignes = lireBottin(entree);
+    if (lignes.empty()) {
+        std::cerr << "Erreur : aucune entrée dans '" << argv[1] << "'." << std::endl;
+        return 1;
+    }
+
+    std::ostringstream texte;
+    texte << "// Généré par embarquer-bottin à partir de " << argv[1] << " : ne pas modifier.\n"
+          << "#pragma once\n"
+          << "#include \"BottinEmbarque.h\"\n\n"
+          << "namespace TP3::embarque {\n\n"
+          << "inline constexpr std::array<EntreeEmbarquee, " << lignes.size() << "> ENTREES_" << identifiant
+          << " = {{\n";
+    for (const Ligne& ligne : lignes) {
+        texte << "    {";
+        ecrireLitteral(texte, ligne.m_nom);
+        texte << ", ";
+        ecrireLitteral(texte, ligne.m_prenom);
+        texte << ", ";
+        ecrireLitteral(texte, ligne.m_telephoneFixe);
+        texte << ", ";
+        ecrireLitteral(texte, ligne.m_cellulaire);
+        texte << ", ";
+        ecrireLitteral(texte, ligne.m_courriel);
+        texte << "},\n";
+    }
+    texte << "}};\n\n"
+          << "inline constexpr BottinEmbarque " << identifiant << "(ENTREES_" << identifiant << ");\n\n"
+          << "} // namespace TP3::embarque\n";
+
+    std::ofstream sortie(argv[2], std::ios::binary);
+    sortie << texte.str();
+    if (!sortie) {
+        std::cerr << "Erreur : écriture incomplète dans '" << argv[2] << "'." << std::endl;
+        return 1;
+    }
+    return 0;
+}
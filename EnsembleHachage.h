@@ -0,0 +1,85 @@
+/**
+ * \file EnsembleHachage.h
+ * \brief Classe définissant un ensemble de clefs sur une table de hachage.
+ *
+ *	Résolution des collisions par redistribution quadratique.
+ *
+ */
+
+#ifndef ENSEMBLEHACHAGE_H_
+#define ENSEMBLEHACHAGE_H_
+
+#include <memory>
+#include <ostream>
+#include "TableHachage.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \class EnsembleHachage
+ *
+ * \brief Ensemble de clefs distinctes, sans élément associé
+ *
+ *  L'ensemble est une TableHachage dont l'élément est un type vide : grâce à
+ *  [[no_unique_address]], les cases ne contiennent que la clef et son état.
+ *  Le sondage, le rehachage (parallèle compris) et les statistiques sont ceux
+ *  de la table. Les opérations ensemblistes parcourent séquentiellement le
+ *  tableau de cases d'un opérande et sondent l'autre; le résultat est
+ *  dimensionné d'avance et n'est jamais rehaché en cours de route.
+ *
+ * TypeClef : le type des clefs
+ * FoncteurHachage: foncteur de hachage
+ * Allocateur : allocateur du tableau des cases
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur = std::allocator<char> >
+class EnsembleHachage
+{
+public:
+
+    explicit EnsembleHachage(size_t = 100);
+
+    bool inserer(const TypeClef &);
+    template<typename Iterateur>
+    size_t insererPlusieurs(Iterateur, Iterateur);
+    void enlever(const TypeClef &);
+
+    bool contient(const TypeClef &) const;
+    size_t taille() const;
+    void vider();
+    void reserver(size_t);
+
+    EnsembleHachage unionAvec(const EnsembleHachage &) const;
+    EnsembleHachage intersection(const EnsembleHachage &) const;
+    EnsembleHachage difference(const EnsembleHachage &) const;
+
+    void statistiques(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const;
+
+    template<typename Fonction>
+    void parcourir(Fonction) const;
+
+    void asgTravailleurs(TP3::GroupeTravailleurs *);
+
+private:
+
+    /**
+     * \class Vide
+     * \brief Élément de la table sous-jacente : n'occupe aucun octet dans les cases
+     */
+    class Vide
+    {
+    public:
+        bool operator==(const Vide &) const = default;
+        friend std::ostream& operator<<(std::ostream & p_out, const Vide &)
+        {
+            return p_out;
+        }
+    };
+
+    TableHachage<TypeClef, Vide, FoncteurHachage, Allocateur> m_table; /*!< Les clefs */
+};
+} //Fin du namespace
+
+#include "EnsembleHachage.hpp"
+
+#endif
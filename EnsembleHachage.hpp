@@ -0,0 +1,238 @@
+/**
+ * \file EnsembleHachage.hpp
+ * \brief Implémentation des opérateurs de la classe ensemble de hachage
+ *
+ */
+#include <iterator>
+#include "ContratException.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Constructeur
+ *
+ * \param[in] p_taille La taille initiale du tableau des cases
+ * \post L'ensemble est vide
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::EnsembleHachage(size_t p_taille) :
+m_table(p_taille)
+{
+}
+
+/**
+ * \brief Ajouter une clef à l'ensemble si elle n'y est pas déjà
+ *
+ * \param[in] p_clef La clef à ajouter
+ * \return Vrai si la clef a été ajoutée, faux si elle était déjà présente
+ * \post La clef est dans l'ensemble
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+bool EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::inserer(const TypeClef & p_clef)
+{
+    const bool ajoutee = m_table.insererSiAbsent(p_clef, Vide());
+
+    POSTCONDITION_AUDIT(contient(p_clef));
+    return ajoutee;
+}
+
+/**
+ * \brief Ajouter les clefs d'une séquence
+ *
+ * Si la longueur de la séquence est connue d'avance (itérateurs avant),
+ * l'ensemble est agrandi une seule fois avant les insertions.
+ *
+ * \param[in] p_debut Début de la séquence
+ * \param[in] p_fin Fin de la séquence
+ * \return Le nombre de clefs ajoutées (les doublons ne comptent pas)
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+template<typename Iterateur>
+size_t EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::insererPlusieurs(Iterateur p_debut, Iterateur p_fin)
+{
+    if constexpr (std::forward_iterator<Iterateur>)
+    {
+        m_table.reserver(static_cast<size_t>(std::distance(p_debut, p_fin)));
+    }
+    size_t ajoutees = 0;
+    for (; p_debut != p_fin; ++p_debut)
+    {
+        if (m_table.insererSiAbsent(*p_debut, Vide()))
+        {
+            ++ajoutees;
+        }
+    }
+    return ajoutees;
+}
+
+/**
+ * \brief Retirer une clef de l'ensemble
+ *
+ * \param[in] p_clef La clef à retirer
+ * \pre La clef est dans l'ensemble
+ * \post La clef n'est plus dans l'ensemble
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+void EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::enlever(const TypeClef & p_clef)
+{
+    m_table.enlever(p_clef);
+}
+
+/**
+ * \brief Déterminer si une clef est dans l'ensemble
+ * \post L'ensemble est inchangé
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+bool EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::contient(const TypeClef & p_clef) const
+{
+    return m_table.contient(p_clef);
+}
+
+/**
+ * \brief Retourner le nombre de clefs
+ * \post L'ensemble est inchangé
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+size_t EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::taille() const
+{
+    return m_table.taille();
+}
+
+/**
+ * \brief Vider l'ensemble
+ * \post L'ensemble est vide
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+void EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::vider()
+{
+    m_table.vider();
+}
+
+/**
+ * \brief Agrandir l'ensemble d'avance pour p_nombre clefs nouvelles
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+void EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::reserver(size_t p_nombre)
+{
+    m_table.reserver(p_nombre);
+}
+
+/**
+ * \brief Retourner l'union de deux ensembles
+ *
+ * Le résultat part d'une copie du plus grand ensemble; le plus petit est
+ * parcouru et ses clefs absentes y sont ajoutées.
+ *
+ * \param[in] p_autre L'autre ensemble
+ * \return Les clefs présentes dans l'un ou l'autre ensemble
+ * \post Les deux ensembles sont inchangés
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>
+EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::unionAvec(const EnsembleHachage & p_autre) const
+{
+    const bool ceciPlusGrand = taille() >= p_autre.taille();
+    const EnsembleHachage & grand = ceciPlusGrand ? *this : p_autre;
+    const EnsembleHachage & petit = ceciPlusGrand ? p_autre : *this;
+
+    EnsembleHachage resultat(grand);
+    resultat.reserver(petit.taille());
+    petit.parcourir([&resultat](const TypeClef & p_clef)
+    {
+        resultat.inserer(p_clef);
+    });
+    return resultat;
+}
+
+/**
+ * \brief Retourner l'intersection de deux ensembles
+ *
+ * Le plus petit ensemble est parcouru; chacune de ses clefs est cherchée
+ * dans le plus grand.
+ *
+ * \param[in] p_autre L'autre ensemble
+ * \return Les clefs présentes dans les deux ensembles
+ * \post Les deux ensembles sont inchangés
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>
+EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::intersection(const EnsembleHachage & p_autre) const
+{
+    const bool ceciPlusGrand = taille() >= p_autre.taille();
+    const EnsembleHachage & grand = ceciPlusGrand ? *this : p_autre;
+    const EnsembleHachage & petit = ceciPlusGrand ? p_autre : *this;
+
+    EnsembleHachage resultat;
+    resultat.reserver(petit.taille());
+    petit.parcourir([&resultat, &grand](const TypeClef & p_clef)
+    {
+        if (grand.contient(p_clef))
+        {
+            resultat.m_table.inserer(p_clef, Vide());
+        }
+    });
+    return resultat;
+}
+
+/**
+ * \brief Retourner la différence de deux ensembles
+ *
+ * \param[in] p_autre L'ensemble dont les clefs sont retirées
+ * \return Les clefs de cet ensemble absentes de p_autre
+ * \post Les deux ensembles sont inchangés
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>
+EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::difference(const EnsembleHachage & p_autre) const
+{
+    EnsembleHachage resultat;
+    resultat.reserver(taille());
+    parcourir([&resultat, &p_autre](const TypeClef & p_clef)
+    {
+        if (!p_autre.contient(p_clef))
+        {
+            resultat.m_table.inserer(p_clef, Vide());
+        }
+    });
+    return resultat;
+}
+
+/**
+ * \brief Retourner les statistiques de collision de la table sous-jacente
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+void EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::statistiques(double& p_ratio, size_t& p_nbCollisions,
+                                                                          size_t& p_maximumCollisionUneInsertion) const
+{
+    m_table.statistiques(p_ratio, p_nbCollisions, p_maximumCollisionUneInsertion);
+}
+
+/**
+ * \brief Appliquer une fonction à chaque clef, dans l'ordre des cases
+ *
+ * \param[in] p_fonction Fonction appelée avec chaque clef
+ * \post L'ensemble est inchangé
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+template<typename Fonction>
+void EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::parcourir(Fonction p_fonction) const
+{
+    m_table.parcourir([&p_fonction](const TypeClef & p_clef, const Vide &)
+    {
+        p_fonction(p_clef);
+    });
+}
+
+/**
+ * \brief Assigner les travailleurs qui rehachent les grands ensembles
+ *
+ * \param[in] p_travailleurs Le groupe, qui doit survivre à l'ensemble, ou nullptr
+ */
+template<typename TypeClef, class FoncteurHachage, class Allocateur>
+void EnsembleHachage<TypeClef, FoncteurHachage, Allocateur>::asgTravailleurs(TP3::GroupeTravailleurs * p_travailleurs)
+{
+    m_table.asgTravailleurs(p_travailleurs);
+}
+
+} // Fin du namespace
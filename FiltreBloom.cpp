@@ -0,0 +1,75 @@
+/**
+ * \file FiltreBloom.cpp
+ * \brief Implantation du filtre de Bloom par blocs
+ *
+ */
+#include "FiltreBloom.h"
+#include <algorithm>
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Constructeur
+ * \param[in] p_capacite Nombre de valeurs prévu
+ * \param[in] p_bitsParCle Bits de filtre par valeur prévue; 12 donne environ 0,5 % de faux positifs
+ * \post Le filtre est vide et a au moins un bloc
+ */
+FiltreBloom::FiltreBloom(size_t p_capacite, size_t p_bitsParCle) :
+m_blocs(std::max<size_t>(1, (p_capacite * p_bitsParCle + 511) / 512), Bloc{}),
+m_capacite(p_capacite), m_nbElements(0)
+{
+}
+
+/**
+ * \brief Ajoute une valeur de hachage
+ * \param[in] p_hachage La valeur de hachage de la clef
+ * \post peutContenir(p_hachage) est vrai
+ */
+void FiltreBloom::ajouter(uint64_t p_hachage) noexcept
+{
+    const uint64_t h = _finaliser(p_hachage);
+    Bloc & bloc = m_blocs[_bloc(h)];
+    const uint32_t bas = static_cast<uint32_t>(h);
+    for (size_t i = 0; i < MOTS_PAR_BLOC; ++i)
+    {
+        bloc.m_mots[i] |= _masque(bas, i);
+    }
+    ++m_nbElements;
+}
+
+/**
+ * \brief Retire toutes les valeurs en gardant la taille du filtre
+ * \post nombreElements() est nul
+ */
+void FiltreBloom::vider()
+{
+    std::fill(m_blocs.begin(), m_blocs.end(), Bloc{});
+    m_nbElements = 0;
+}
+
+/**
+ * \brief Retourne le nombre de valeurs ajoutées
+ */
+size_t FiltreBloom::nombreElements() const
+{
+    return m_nbElements;
+}
+
+/**
+ * \brief Retourne le nombre de valeurs prévu à la construction
+ */
+size_t FiltreBloom::capacite() const
+{
+    return m_capacite;
+}
+
+/**
+ * \brief Retourne la mémoire occupée par les blocs, en octets
+ */
+size_t FiltreBloom::memoire() const
+{
+    return m_blocs.size() * sizeof(Bloc);
+}
+
+} //Fin du namespace
@@ -0,0 +1,111 @@
+/**
+ * \file FiltreBloom.h
+ * \brief Filtre de Bloom par blocs, construit sur des valeurs de hachage.
+ *
+ * Chaque valeur choisit un bloc de 512 bits (une ligne de cache) et y allume
+ * un bit dans chacun des huit mots de 64 bits. Une requête ne touche donc
+ * qu'une ligne de cache, au prix d'un taux de faux positifs un peu plus élevé
+ * qu'un filtre classique de même taille (environ 0,5 % à 12 bits par clef,
+ * 1 % à 10 bits).
+ *
+ */
+#ifndef FILTREBLOOM_H
+#define FILTREBLOOM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace labTableHachage
+{
+
+/**
+ * \class FiltreBloom
+ *
+ * \brief Répond « peut-être présente » ou « sûrement absente » pour une valeur de hachage.
+ *
+ * Le filtre ne permet pas de retirer une valeur : un retrait laisse ses bits
+ * allumés et ne cause que des faux positifs. Au-delà de sa capacité, le taux
+ * de faux positifs augmente; le propriétaire le reconstruit plus grand.
+ */
+class FiltreBloom
+{
+public:
+    explicit FiltreBloom(size_t p_capacite = 0, size_t p_bitsParCle = 12);
+
+    void ajouter(uint64_t p_hachage) noexcept;
+
+    /**
+     * \brief Indique si une valeur a pu être ajoutée
+     * \param[in] p_hachage La valeur de hachage de la clef
+     * \return Faux si la valeur n'a sûrement jamais été ajoutée
+     */
+    bool peutContenir(uint64_t p_hachage) const noexcept
+    {
+        const uint64_t h = _finaliser(p_hachage);
+        const Bloc & bloc = m_blocs[_bloc(h)];
+        const uint32_t bas = static_cast<uint32_t>(h);
+        for (size_t i = 0; i < MOTS_PAR_BLOC; ++i)
+        {
+            if ((bloc.m_mots[i] & _masque(bas, i)) == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void vider();
+
+    size_t nombreElements() const;
+    size_t capacite() const;
+    size_t memoire() const;
+
+private:
+    static constexpr size_t MOTS_PAR_BLOC = 8; /*!< 8 mots de 64 bits : une ligne de cache */
+
+    /**
+     * \brief Un bloc de 512 bits, aligné sur une ligne de cache
+     */
+    struct alignas(64) Bloc
+    {
+        uint64_t m_mots[MOTS_PAR_BLOC];
+    };
+
+    std::vector<Bloc> m_blocs;
+    size_t m_capacite; /*!< Nombre de valeurs prévu à la construction */
+    size_t m_nbElements; /*!< Nombre d'ajouts, retraits du propriétaire non compris */
+
+    /**
+     * \brief Choisit le bloc avec les 32 bits forts (réduction par multiplication)
+     */
+    size_t _bloc(uint64_t p_hachage) const noexcept
+    {
+        return static_cast<size_t>(((p_hachage >> 32) * m_blocs.size()) >> 32);
+    }
+
+    /**
+     * \brief Bit du mot p_mot : les 6 bits forts du produit des 32 bits faibles par un sel impair
+     */
+    static uint64_t _masque(uint32_t p_bas, size_t p_mot) noexcept
+    {
+        static constexpr uint32_t SELS[MOTS_PAR_BLOC] = {
+            0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+            0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+        return uint64_t(1) << ((p_bas * SELS[p_mot]) >> 26);
+    }
+
+    /**
+     * \brief Finaliseur de splitmix64 : les foncteurs de hachage des chaînes dispersent mal leurs bits forts
+     */
+    static uint64_t _finaliser(uint64_t z) noexcept
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+};
+
+} //Fin du namespace
+
+#endif
@@ -18,14 +18,24 @@
 #ifndef FONCTEURHACHAGE_H
 #define FONCTEURHACHAGE_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
 namespace labTableHachage {
 /**
  * \class HString1
  * \brief Foncteur de hachage pour des string
+ *
+ * La clef est reçue comme std::string_view : une std::string, une chaîne C ou une
+ * vue sur une chaîne stockée ailleurs donnent toutes la même valeur.
  */
 class HString1 {
 public:
-	size_t operator()(const std::string & p_clef) const {
+	size_t operator()(std::string_view p_clef) const {
 		size_t total = 0;
 		int nPremiers = 18;
 		size_t premiers[18] = { 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
@@ -45,7 +55,7 @@ private:
  */
 class HString2 {
 public:
-	size_t operator()(const std::string & p_clef) const {
+	size_t operator()(std::string_view p_clef) const {
 		size_t total = 5381;
 		for (size_t i = 0; i < p_clef.size(); ++i) {
 			total = total * 33 ^ p_clef[i];
@@ -54,6 +64,107 @@ public:
 	}
 };
 
+/**
+ * \class LecteurNormalise
+ * \brief Parcourt une chaîne UTF-8 en produisant ses octets normalisés, sans copie
+ *
+ * Les lettres ASCII sont mises en minuscules et les lettres accentuées du
+ * bloc Latin-1 (U+00C0 à U+00FF) ainsi que « Œ/œ » sont ramenées à leur
+ * lettre de base minuscule (« É » donne « e », « Æ » donne « ae »). Les
+ * autres octets sont rendus tels quels. La normalisation se fait au fil de la
+ * lecture : ni le hachage ni la comparaison n'allouent de chaîne.
+ */
+class LecteurNormalise {
+public:
+	explicit LecteurNormalise(std::string_view p_texte) :
+			m_texte(p_texte), m_position(0), m_enAttente(0) {
+	}
+
+	/**
+	 * \brief Retourne le prochain octet normalisé
+	 * \return L'octet (0 à 255), ou -1 à la fin de la chaîne
+	 */
+	int suivant() {
+		if (m_enAttente != 0) {
+			const int c = m_enAttente;
+			m_enAttente = 0;
+			return c;
+		}
+		if (m_position >= m_texte.size()) {
+			return -1;
+		}
+		const unsigned char c = static_cast<unsigned char>(m_texte[m_position++]);
+		if (c < 0x80) {
+			return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+		}
+		if (m_position < m_texte.size()) {
+			const unsigned char d = static_cast<unsigned char>(m_texte[m_position]);
+			const char* plie = nullptr;
+			if (c == 0xC3 && d >= 0x80 && d <= 0xBF) {
+				plie = LATIN1[d - 0x80];
+			} else if (c == 0xC5 && (d == 0x92 || d == 0x93)) {
+				plie = "oe";
+			}
+			if (plie != nullptr) {
+				++m_position;
+				m_enAttente = static_cast<unsigned char>(plie[1]);
+				return static_cast<unsigned char>(plie[0]);
+			}
+		}
+		return c;
+	}
+
+private:
+	std::string_view m_texte;
+	size_t m_position;
+	int m_enAttente; /*!< Second octet d'un pliage sur deux lettres (« ae », « oe », ...), 0 sinon */
+
+	/**
+	 * \brief Pliage de U+00C0 à U+00FF (second octet UTF-8 0x80 à 0xBF); nullptr si le caractère n'est pas une lettre
+	 */
+	static constexpr const char* LATIN1[64] = {
+		"a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+		"d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "ss",
+		"a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+		"d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "y" };
+};
+
+/**
+ * \class HStringNormalisee
+ * \brief Foncteur de hachage pour des string, insensible à la casse et aux accents
+ *
+ * Même calcul que HString2, appliqué aux octets produits par LecteurNormalise.
+ */
+class HStringNormalisee {
+public:
+	size_t operator()(std::string_view p_clef) const {
+		size_t total = 5381;
+		LecteurNormalise lecteur(p_clef);
+		for (int c = lecteur.suivant(); c >= 0; c = lecteur.suivant()) {
+			total = total * 33 ^ static_cast<size_t>(c);
+		}
+		return total;
+	}
+};
+
+/**
+ * \class EgaliteNormalisee
+ * \brief Foncteur d'égalité pour des string, cohérent avec HStringNormalisee
+ */
+class EgaliteNormalisee {
+public:
+	bool operator()(std::string_view p_a, std::string_view p_b) const {
+		LecteurNormalise lecteurA(p_a);
+		LecteurNormalise lecteurB(p_b);
+		int a, b;
+		do {
+			a = lecteurA.suivant();
+			b = lecteurB.suivant();
+		} while (a == b && a >= 0);
+		return a == b;
+	}
+};
+
 /**
  * \class HInt1
  * \brief Foncteur de hachage pour des int
@@ -78,5 +189,185 @@ public:
 		return total;
 	}
 };
+/**
+ * \class HInt64
+ * \brief Foncteur de hachage pour des entiers de 64 bits
+ *
+ * Finaliseur de splitmix64 : des clefs voisines (numéros de téléphone compactés,
+ * par exemple) donnent des valeurs bien dispersées sur tous les bits.
+ */
+class HInt64 {
+public:
+	constexpr size_t operator()(uint64_t p_clef) const {
+		uint64_t total = p_clef;
+		total = (total ^ (total >> 30)) * 0xbf58476d1ce4e5b9ull;
+		total = (total ^ (total >> 27)) * 0x94d049bb133111ebull;
+		return static_cast<size_t>(total ^ (total >> 31));
+	}
+};
+
+/**
+ * \brief SipHash à C rondes de compression et D rondes de finalisation
+ *
+ * SipHash-1-3 (C = 1, D = 3) sert aux foncteurs à graine; SipHash-2-4 est la
+ * variante de référence, dont les vecteurs de test valident l'implantation.
+ * Les mots sont lus en petit-boutiste quel que soit l'ordre de la machine.
+ *
+ * \param[in] p_k0 Premiers 64 bits de la clé secrète
+ * \param[in] p_k1 Derniers 64 bits de la clé secrète
+ * \param[in] p_donnees Les octets à hacher
+ * \return La valeur de hachage de 64 bits
+ */
+template<int C, int D>
+inline uint64_t sipHash(uint64_t p_k0, uint64_t p_k1, std::string_view p_donnees) {
+	uint64_t v0 = p_k0 ^ 0x736f6d6570736575ull;
+	uint64_t v1 = p_k1 ^ 0x646f72616e646f6dull;
+	uint64_t v2 = p_k0 ^ 0x6c7967656e657261ull;
+	uint64_t v3 = p_k1 ^ 0x7465646279746573ull;
+	const auto rotation = [](uint64_t p_x, int p_b) { return (p_x << p_b) | (p_x >> (64 - p_b)); };
+	const auto ronde = [&]() {
+		v0 += v1; v1 = rotation(v1, 13); v1 ^= v0; v0 = rotation(v0, 32);
+		v2 += v3; v3 = rotation(v3, 16); v3 ^= v2;
+		v0 += v3; v3 = rotation(v3, 21); v3 ^= v0;
+		v2 += v1; v1 = rotation(v1, 17); v1 ^= v2; v2 = rotation(v2, 32);
+	};
+	const auto lire = [&p_donnees](size_t p_debut, size_t p_nombre) {
+		uint64_t mot = 0;
+		for (size_t i = 0; i < p_nombre; ++i) {
+			mot |= static_cast<uint64_t>(static_cast<unsigned char>(p_donnees[p_debut + i])) << (8 * i);
+		}
+		return mot;
+	};
+
+	const size_t finMots = p_donnees.size() & ~static_cast<size_t>(7);
+	for (size_t i = 0; i < finMots; i += 8) {
+		const uint64_t mot = lire(i, 8);
+		v3 ^= mot;
+		for (int r = 0; r < C; ++r) ronde();
+		v0 ^= mot;
+	}
+	const uint64_t dernier = (static_cast<uint64_t>(p_donnees.size()) << 56) | lire(finMots, p_donnees.size() - finMots);
+	v3 ^= dernier;
+	for (int r = 0; r < C; ++r) ronde();
+	v0 ^= dernier;
+
+	v2 ^= 0xff;
+	for (int r = 0; r < D; ++r) ronde();
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/**
+ * \brief Tire une graine de 64 bits imprévisible de l'extérieur
+ *
+ * Une base est lue une fois par processus dans std::random_device; chaque
+ * appel la combine avec un compteur et la passe au finaliseur de splitmix64.
+ * Deux appels ne donnent jamais la même graine et aucune valeur de hachage
+ * n'est exposée : un appelant ne peut pas deviner les graines des tables.
+ */
+inline uint64_t tirerGraine() {
+	static const uint64_t base = [] {
+		std::random_device alea;
+		return (static_cast<uint64_t>(alea()) << 32) ^ alea();
+	}();
+	static std::atomic<uint64_t> compteur(0);
+	uint64_t total = base + compteur.fetch_add(1, std::memory_order_relaxed) * 0x9e3779b97f4a7c15ull;
+	total = (total ^ (total >> 30)) * 0xbf58476d1ce4e5b9ull;
+	total = (total ^ (total >> 27)) * 0x94d049bb133111ebull;
+	return total ^ (total >> 31);
+}
+
+/**
+ * \class HSipString
+ * \brief Foncteur de hachage à graine pour des clefs de source non fiable
+ *
+ * SipHash-1-3 avec une clé de 128 bits tirée à la construction : sans la
+ * connaître, on ne peut pas fabriquer de clefs qui collisionnent. Les tables
+ * qui trouvent regenererGraine() en tirent une nouvelle et se rehachent
+ * lorsqu'une insertion subit trop de collisions.
+ */
+class HSipString {
+public:
+	HSipString() : m_k0(tirerGraine()), m_k1(tirerGraine()) {
+	}
+	HSipString(uint64_t p_k0, uint64_t p_k1) : m_k0(p_k0), m_k1(p_k1) {
+	}
+	size_t operator()(std::string_view p_clef) const {
+		return static_cast<size_t>(sipHash<1, 3>(m_k0, m_k1, p_clef));
+	}
+	void regenererGraine() {
+		m_k0 = tirerGraine();
+		m_k1 = tirerGraine();
+	}
+private:
+	uint64_t m_k0; /*!< Clé secrète, premiers 64 bits */
+	uint64_t m_k1; /*!< Clé secrète, derniers 64 bits */
+};
+
+/**
+ * \class HSipStringNormalisee
+ * \brief Foncteur de hachage à graine, insensible à la casse et aux accents
+ *
+ * SipHash-1-3 des octets produits par LecteurNormalise, cohérent avec
+ * EgaliteNormalisee. Les clefs courtes sont normalisées dans un tampon local;
+ * seules celles de plus de 64 octets allouent une chaîne.
+ */
+class HSipStringNormalisee {
+public:
+	HSipStringNormalisee() : m_k0(tirerGraine()), m_k1(tirerGraine()) {
+	}
+	HSipStringNormalisee(uint64_t p_k0, uint64_t p_k1) : m_k0(p_k0), m_k1(p_k1) {
+	}
+	size_t operator()(std::string_view p_clef) const {
+		// Le texte normalisé n'est jamais plus long : « Æ » (deux octets UTF-8) donne « ae »
+		char tampon[64];
+		std::string longue;
+		char* debut = tampon;
+		if (p_clef.size() > sizeof(tampon)) {
+			longue.resize(p_clef.size());
+			debut = longue.data();
+		}
+		size_t taille = 0;
+		LecteurNormalise lecteur(p_clef);
+		for (int c = lecteur.suivant(); c >= 0; c = lecteur.suivant()) {
+			debut[taille++] = static_cast<char>(c);
+		}
+		return static_cast<size_t>(sipHash<1, 3>(m_k0, m_k1, std::string_view(debut, taille)));
+	}
+	void regenererGraine() {
+		m_k0 = tirerGraine();
+		m_k1 = tirerGraine();
+	}
+private:
+	uint64_t m_k0; /*!< Clé secrète, premiers 64 bits */
+	uint64_t m_k1; /*!< Clé secrète, derniers 64 bits */
+};
+
+/**
+ * \class HSipInt64
+ * \brief Foncteur de hachage à graine pour des entiers de 64 bits
+ *
+ * Même principe que HSipString, sur les 8 octets de l'entier.
+ */
+class HSipInt64 {
+public:
+	HSipInt64() : m_k0(tirerGraine()), m_k1(tirerGraine()) {
+	}
+	HSipInt64(uint64_t p_k0, uint64_t p_k1) : m_k0(p_k0), m_k1(p_k1) {
+	}
+	size_t operator()(uint64_t p_clef) const {
+		char octets[8];
+		for (int i = 0; i < 8; ++i) {
+			octets[i] = static_cast<char>(p_clef >> (8 * i));
+		}
+		return static_cast<size_t>(sipHash<1, 3>(m_k0, m_k1, std::string_view(octets, 8)));
+	}
+	void regenererGraine() {
+		m_k0 = tirerGraine();
+		m_k1 = tirerGraine();
+	}
+private:
+	uint64_t m_k0; /*!< Clé secrète, premiers 64 bits */
+	uint64_t m_k1; /*!< Clé secrète, derniers 64 bits */
+};
 } // Fin namespace
 #endif /* FONCTEURHACHAGE_H */
@@ -0,0 +1,83 @@
+/**
+ * \file GenerateurBottin.cpp
+ * \brief Écrit un bottin synthétique pour les essais de charge et de recherche.
+ *
+ * Usage : generateur-bottin [--lignes 1000000] [--graine 42] [--sortie fichier|-]
+ *         [--asymetrie-noms 1.0] [--domaines 200] [--asymetrie-domaines 1.2]
+ *         [--indicatifs 60] [--asymetrie-indicatifs 0.8] [--quasi-doublons 0.02]
+ *
+ * Sans --sortie (ou avec « - »), le fichier est écrit sur la sortie standard.
+ * Une même graine et les mêmes paramètres donnent toujours le même fichier
+ * (voir DonneesSynthetiques.h).
+ */
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "DonneesSynthetiques.h"
+
+namespace {
+    void afficherUsage(const char* p_programme) {
+        std::cerr << "Usage : " << p_programme
+                  << " [--lignes N] [--graine G] [--sortie fichier|-] [--asymetrie-noms S]"
+                     " [--domaines D] [--asymetrie-domaines S] [--indicatifs I]"
+                     " [--asymetrie-indicatifs S] [--quasi-doublons T]" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    TP3::ParametresDonnees parametres;
+    std::string sortie = "-";
+    try {
+        for (int i = 1; i < argc; i += 2) {
+            if (i + 1 >= argc) {
+                afficherUsage(argv[0]);
+                return 1;
+            }
+            const std::string option = argv[i];
+            const std::string valeur = argv[i + 1];
+            if (option == "--lignes") parametres.m_lignes = std::stoull(valeur);
+            else if (option == "--graine") parametres.m_graine = std::stoull(valeur);
+            else if (option == "--sortie") sortie = valeur;
+            else if (option == "--asymetrie-noms") parametres.m_asymetrieNoms = std::stod(valeur);
+            else if (option == "--domaines") parametres.m_nombreDomaines = std::stoull(valeur);
+            else if (option == "--asymetrie-domaines") parametres.m_asymetrieDomaines = std::stod(valeur);
+            else if (option == "--indicatifs") parametres.m_nombreIndicatifs = std::stoull(valeur);
+            else if (option == "--asymetrie-indicatifs") parametres.m_asymetrieIndicatifs = std::stod(valeur);
+            else if (option == "--quasi-doublons") parametres.m_tauxQuasiDoublons = std::stod(valeur);
+            else {
+                afficherUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        afficherUsage(argv[0]);
+        return 1;
+    }
+
+    const auto debut = std::chrono::steady_clock::now();
+    try {
+        if (sortie == "-") {
+            std::ios::sync_with_stdio(false);
+            TP3::genererDonnees(std::cout, parametres);
+        } else {
+            std::ofstream fichier(sortie, std::ios::binary);
+            if (!fichier.is_open()) {
+                std::cerr << "Erreur : impossible d'ouvrir le fichier '" << sortie << "'." << std::endl;
+                return 1;
+            }
+            TP3::genererDonnees(fichier, parametres);
+            if (!fichier) {
+                std::cerr << "Erreur : écriture incomplète dans '" << sortie << "'." << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+    const double secondes = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+    std::cerr << parametres.m_lignes << " entrées générées en " << secondes << " s (graine "
+              << parametres.m_graine << ")" << std::endl;
+    return 0;
+}
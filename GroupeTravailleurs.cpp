@@ -0,0 +1,131 @@
+/**
+ * \file GroupeTravailleurs.cpp
+ * \brief Implantation du groupe de fils d'exécution.
+ */
+#include "GroupeTravailleurs.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace TP3 {
+
+    /**
+     * \brief Démarre les fils d'exécution.
+     * \param[in] p_nombre Nombre de fils; au moins un fil est créé.
+     */
+GroupeTravailleurs::GroupeTravailleurs(size_t p_nombre)
+    : m_travailleurs(), m_taches(), m_mutex(), m_condition(), m_arret(false) {
+    const size_t nombre = p_nombre == 0 ? 1 : p_nombre;
+    m_travailleurs.reserve(nombre);
+    for (size_t i = 0; i < nombre; ++i) {
+        m_travailleurs.emplace_back(&GroupeTravailleurs::_boucle, this);
+    }
+}
+    /**
+     * \brief Termine les tâches déjà soumises puis arrête les fils.
+     */
+GroupeTravailleurs::~GroupeTravailleurs() {
+    {
+        std::lock_guard<std::mutex> verrou(m_mutex);
+        m_arret = true;
+    }
+    m_condition.notify_all();
+    for (std::thread& travailleur : m_travailleurs) {
+        travailleur.join();
+    }
+}
+    /**
+     * \brief Ajoute une tâche à la file; elle sera exécutée par le premier fil libre.
+     * \param[in] p_tache La tâche.
+     */
+void GroupeTravailleurs::soumettre(std::function<void()> p_tache) {
+    {
+        std::lock_guard<std::mutex> verrou(m_mutex);
+        PRECONDITION(!m_arret);
+        m_taches.push_back(std::move(p_tache));
+    }
+    m_condition.notify_one();
+}
+    /**
+     * \brief Applique une fonction à tous les blocs de [0, p_nombre) et attend la fin.
+     * \details L'appelant traite lui aussi des blocs : l'appel progresse même si tous les fils sont occupés.
+     * La première exception levée par un bloc est relancée dans l'appelant.
+     * \param[in] p_nombre Taille de l'intervalle.
+     * \param[in] p_tailleBloc Nombre d'éléments par bloc.
+     * \param[in] p_fonction Fonction appelée avec (début, fin) de chaque bloc.
+     * \pre p_tailleBloc est positif.
+     */
+void GroupeTravailleurs::executerEnParallele(size_t p_nombre, size_t p_tailleBloc,
+                                             const std::function<void(size_t, size_t)>& p_fonction) {
+    PRECONDITION(p_tailleBloc > 0);
+
+    const size_t nbBlocs = (p_nombre + p_tailleBloc - 1) / p_tailleBloc;
+    if (nbBlocs <= 1) {
+        if (p_nombre > 0) p_fonction(0, p_nombre);
+        return;
+    }
+
+    std::atomic<size_t> prochainBloc(0);
+    std::mutex mutexFin;
+    std::condition_variable conditionFin;
+    size_t aidesActifs = 0;
+    std::exception_ptr erreur;
+
+    auto traiterBlocs = [&]() {
+        for (size_t bloc = prochainBloc.fetch_add(1); bloc < nbBlocs; bloc = prochainBloc.fetch_add(1)) {
+            const size_t debut = bloc * p_tailleBloc;
+            const size_t fin = std::min(debut + p_tailleBloc, p_nombre);
+            try {
+                p_fonction(debut, fin);
+            } catch (...) {
+                std::lock_guard<std::mutex> verrou(mutexFin);
+                if (!erreur) erreur = std::current_exception();
+            }
+        }
+    };
+
+    const size_t nbAides = std::min(m_travailleurs.size(), nbBlocs - 1);
+    aidesActifs = nbAides;
+    for (size_t i = 0; i < nbAides; ++i) {
+        soumettre([&]() {
+            traiterBlocs();
+            std::lock_guard<std::mutex> verrou(mutexFin);
+            if (--aidesActifs == 0) conditionFin.notify_one();
+        });
+    }
+    traiterBlocs();
+
+    std::unique_lock<std::mutex> verrou(mutexFin);
+    conditionFin.wait(verrou, [&aidesActifs]() { return aidesActifs == 0; });
+    if (erreur) {
+        std::rethrow_exception(erreur);
+    }
+}
+    /**
+     * \brief Retourne le nombre de fils d'exécution.
+     * \return Le nombre de fils.
+     */
+size_t GroupeTravailleurs::nombreTravailleurs() const {
+    return m_travailleurs.size();
+}
+    /**
+     * \brief Boucle d'un fil : exécuter les tâches jusqu'à l'arrêt et l'épuisement de la file.
+     */
+void GroupeTravailleurs::_boucle() {
+    for (;;) {
+        std::function<void()> tache;
+        {
+            std::unique_lock<std::mutex> verrou(m_mutex);
+            m_condition.wait(verrou, [this]() { return m_arret || !m_taches.empty(); });
+            if (m_taches.empty()) {
+                return;
+            }
+            tache = std::move(m_taches.front());
+            m_taches.pop_front();
+        }
+        tache();
+    }
+}
+
+} // namespace TP3
@@ -0,0 +1,52 @@
+/**
+ * \file GroupeTravailleurs.h
+ * \brief Groupe de fils d'exécution partagés par les traitements en lot.
+ *
+ * Les fils sont créés une fois et attendent des tâches dans une file. Une
+ * boucle parallèle découpe un intervalle en blocs que les fils, et l'appelant
+ * lui-même, se partagent jusqu'à épuisement.
+ */
+#ifndef GROUPETRAVAILLEURS_H
+#define GROUPETRAVAILLEURS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TP3 {
+
+/**
+ * \class GroupeTravailleurs
+ * \brief Réserve de fils d'exécution avec file de tâches et boucle parallèle.
+ */
+class GroupeTravailleurs {
+public:
+    explicit GroupeTravailleurs(size_t p_nombre = std::thread::hardware_concurrency());
+    ~GroupeTravailleurs();
+
+    GroupeTravailleurs(const GroupeTravailleurs&) = delete;
+    GroupeTravailleurs& operator=(const GroupeTravailleurs&) = delete;
+
+    void soumettre(std::function<void()> p_tache);
+    void executerEnParallele(size_t p_nombre, size_t p_tailleBloc,
+                             const std::function<void(size_t, size_t)>& p_fonction);
+
+    size_t nombreTravailleurs() const;
+
+private:
+    std::vector<std::thread> m_travailleurs; /*!< Les fils d'exécution */
+    std::deque<std::function<void()> > m_taches; /*!< Tâches en attente */
+    std::mutex m_mutex; /*!< Protège m_taches et m_arret */
+    std::condition_variable m_condition; /*!< Réveille les fils lorsqu'une tâche arrive */
+    bool m_arret; /*!< Vrai lorsque les fils doivent se terminer */
+
+    void _boucle();
+};
+
+} // namespace TP3
+
+#endif // GROUPETRAVAILLEURS_H
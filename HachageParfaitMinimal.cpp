@@ -0,0 +1,169 @@
+/**
+ * \file HachageParfaitMinimal.cpp
+ * \brief Implantation de la fonction de hachage parfaite minimale
+ *
+ */
+#include "HachageParfaitMinimal.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <numeric>
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Constructeur par défaut
+ *
+ * La fonction est vide; elle doit être construite avant d'être utilisée.
+ */
+HachageParfaitMinimal::HachageParfaitMinimal() :
+m_nbCles(0), m_graine(0), m_deplacements()
+{
+}
+
+/**
+ * \brief Construire la fonction sur un ensemble de valeurs de hachage
+ *
+ * Si aucun déplacement ne convient à un seau, la construction recommence
+ * avec une autre graine globale.
+ *
+ * \param[in] p_hachages Les valeurs de hachage des clefs
+ * \pre Les valeurs sont distinctes et il y en a au moins une
+ * \pre Il y a moins de 2^31 valeurs
+ * \post position() associe chaque valeur à une position distincte de [0, taille())
+ */
+void HachageParfaitMinimal::construire(const std::vector<uint64_t> & p_hachages)
+{
+    PRECONDITION(!p_hachages.empty());
+    PRECONDITION(p_hachages.size() < POSITION_DIRECTE);
+
+    m_nbCles = p_hachages.size();
+    m_graine = 0;
+    while (!_essayerConstruire(p_hachages))
+    {
+        ++m_graine;
+    }
+}
+
+/**
+ * \brief Une tentative de construction avec la graine courante
+ * \param[in] p_hachages Les valeurs de hachage des clefs
+ * \return Vrai si tous les seaux ont reçu un déplacement
+ */
+bool HachageParfaitMinimal::_essayerConstruire(const std::vector<uint64_t> & p_hachages)
+{
+    const size_t nbSeaux = std::max<size_t>(1, m_nbCles / CLEFS_PAR_SEAU);
+    m_deplacements.assign(nbSeaux, 0);
+
+    // Tri par dénombrement des valeurs selon leur seau
+    std::vector<uint32_t> debut(nbSeaux + 1, 0);
+    for (uint64_t h : p_hachages)
+    {
+        ++debut[_melanger(h, m_graine) % nbSeaux + 1];
+    }
+    std::partial_sum(debut.begin(), debut.end(), debut.begin());
+    std::vector<uint64_t> parSeau(m_nbCles);
+    std::vector<uint32_t> curseur(debut.begin(), debut.end() - 1);
+    for (uint64_t h : p_hachages)
+    {
+        parSeau[curseur[_melanger(h, m_graine) % nbSeaux]++] = h;
+    }
+
+    // Les gros seaux sont placés en premier, quand la table est encore peu remplie
+    std::vector<uint32_t> ordre(nbSeaux);
+    std::iota(ordre.begin(), ordre.end(), 0);
+    std::sort(ordre.begin(), ordre.end(), [&debut](uint32_t a, uint32_t b)
+    {
+        return debut[a + 1] - debut[a] > debut[b + 1] - debut[b];
+    });
+
+    std::vector<uint8_t> occupe(m_nbCles, 0);
+    std::vector<size_t> positions;
+    size_t prochainLibre = 0;
+    for (uint32_t seau : ordre)
+    {
+        const size_t taille = debut[seau + 1] - debut[seau];
+        if (taille == 0)
+        {
+            break;
+        }
+        if (taille == 1)
+        {
+            while (occupe[prochainLibre])
+            {
+                ++prochainLibre;
+            }
+            occupe[prochainLibre] = 1;
+            m_deplacements[seau] = POSITION_DIRECTE | static_cast<uint32_t>(prochainLibre);
+            continue;
+        }
+
+        bool place = false;
+        for (uint32_t d = 0; d < ESSAIS_MAX && !place; ++d)
+        {
+            positions.clear();
+            place = true;
+            for (size_t i = debut[seau]; i < debut[seau + 1]; ++i)
+            {
+                const size_t p = _melanger(parSeau[i], m_graine + d + 1) % m_nbCles;
+                if (occupe[p] || std::find(positions.begin(), positions.end(), p) != positions.end())
+                {
+                    place = false;
+                    break;
+                }
+                positions.push_back(p);
+            }
+            if (place)
+            {
+                for (size_t p : positions)
+                {
+                    occupe[p] = 1;
+                }
+                m_deplacements[seau] = d;
+            }
+        }
+        if (!place)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Retourner le nombre de valeurs sur lesquelles la fonction a été construite
+ * \return Le nombre de positions
+ */
+size_t HachageParfaitMinimal::taille() const
+{
+    return m_nbCles;
+}
+
+/**
+ * \brief Retourner la graine globale retenue par la construction
+ * \return La graine
+ */
+uint64_t HachageParfaitMinimal::reqGraine() const
+{
+    return m_graine;
+}
+
+/**
+ * \brief Retourner le déplacement (ou la position directe) de chaque seau
+ * \return Les déplacements
+ */
+const std::vector<uint32_t> & HachageParfaitMinimal::reqDeplacements() const
+{
+    return m_deplacements;
+}
+
+/**
+ * \brief Retourner la mémoire occupée par les déplacements, en octets
+ * \return La taille du tableau des déplacements
+ */
+size_t HachageParfaitMinimal::memoire() const
+{
+    return m_deplacements.size() * sizeof(uint32_t);
+}
+
+} //Fin du namespace
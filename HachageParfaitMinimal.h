@@ -0,0 +1,112 @@
+/**
+ * \file HachageParfaitMinimal.h
+ * \brief Fonction de hachage parfaite minimale construite sur des valeurs de hachage.
+ *
+ * Construction de type CHD (« compress, hash and displace ») : les clefs sont
+ * réparties dans des seaux, puis chaque seau reçoit un déplacement qui envoie
+ * toutes ses clefs dans des positions libres de [0, n). Les seaux d'une seule
+ * clef reçoivent directement leur position. Une requête coûte donc deux
+ * mélanges et un accès au tableau des déplacements.
+ *
+ */
+#ifndef HACHAGEPARFAITMINIMAL_H
+#define HACHAGEPARFAITMINIMAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace labTableHachage
+{
+
+/**
+ * \class HachageParfaitMinimal
+ *
+ * \brief Associe chacune de n valeurs de hachage distinctes à une position unique de [0, n).
+ *
+ * La fonction ne stocke pas les valeurs : une valeur qui ne faisait pas partie
+ * de l'ensemble de construction reçoit une position quelconque. Il revient au
+ * propriétaire de vérifier la clef trouvée à cette position.
+ *
+ * La fonction tient dans sa graine, son nombre de clefs et ses déplacements :
+ * copiés ailleurs (un segment partagé, par exemple), ils suffisent à la
+ * version statique de position().
+ */
+class HachageParfaitMinimal
+{
+public:
+    HachageParfaitMinimal();
+
+    void construire(const std::vector<uint64_t> & p_hachages);
+
+    /**
+     * \brief Retourne la position associée à une valeur de hachage
+     * \param[in] p_hachage La valeur de hachage de la clef
+     * \pre La fonction a été construite sur au moins une valeur
+     * \return Une position dans [0, taille())
+     */
+    size_t position(uint64_t p_hachage) const noexcept
+    {
+        return position(p_hachage, m_graine, m_deplacements, m_nbCles);
+    }
+
+    /**
+     * \brief Retourne la position associée à une valeur de hachage, d'après une copie de la fonction
+     * \param[in] p_hachage La valeur de hachage de la clef
+     * \param[in] p_graine La graine de la fonction (reqGraine())
+     * \param[in] p_deplacements Ses déplacements (reqDeplacements())
+     * \param[in] p_nbCles Son nombre de clefs (taille())
+     * \pre La fonction copiée a été construite sur au moins une valeur
+     * \return Une position dans [0, p_nbCles)
+     */
+    static size_t position(uint64_t p_hachage, uint64_t p_graine, std::span<const uint32_t> p_deplacements,
+                           size_t p_nbCles) noexcept
+    {
+        const uint32_t deplacement = p_deplacements[_melanger(p_hachage, p_graine) % p_deplacements.size()];
+        if (deplacement & POSITION_DIRECTE)
+        {
+            return deplacement & ~POSITION_DIRECTE;
+        }
+        return _melanger(p_hachage, p_graine + deplacement + 1) % p_nbCles;
+    }
+
+    size_t taille() const;
+    size_t memoire() const;
+    uint64_t reqGraine() const;
+    const std::vector<uint32_t> & reqDeplacements() const;
+
+private:
+    static constexpr uint32_t POSITION_DIRECTE = 0x80000000u; /*!< Bit indiquant que le déplacement est une position */
+    static constexpr size_t CLEFS_PAR_SEAU = 2; /*!< Nombre moyen de clefs par seau */
+    static constexpr uint32_t ESSAIS_MAX = 1u << 20; /*!< Déplacements essayés avant de changer de graine */
+
+    size_t m_nbCles; /*!< Le nombre de valeurs de hachage */
+    uint64_t m_graine; /*!< Graine globale, changée si la construction échoue */
+    std::vector<uint32_t> m_deplacements; /*!< Déplacement (ou position directe) de chaque seau */
+
+    bool _essayerConstruire(const std::vector<uint64_t> & p_hachages);
+
+    /**
+     * \brief Mélange une valeur de hachage avec une graine
+     */
+    static uint64_t _melanger(uint64_t p_hachage, uint64_t p_graine) noexcept
+    {
+        uint64_t z = p_hachage ^ _finaliser(0x9e3779b97f4a7c15ull * (p_graine + 1));
+        return _finaliser(z);
+    }
+
+    /**
+     * \brief Finaliseur de splitmix64
+     */
+    static uint64_t _finaliser(uint64_t z) noexcept
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+};
+
+} //Fin du namespace
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * \file IndexTrigrammes.cpp
+ * \brief Implantation de l'index inversé de trigrammes.
+ */
+#include "IndexTrigrammes.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <numeric>
+
+namespace TP3 {
+
+namespace {
+    const std::vector<uint32_t> LISTE_VIDE;
+}
+    /**
+     * \brief Constructeur par défaut : un index vide.
+     */
+IndexTrigrammes::IndexTrigrammes()
+    : m_listeParTrigramme(), m_listes() {
+}
+    /**
+     * \brief Ajoute une entrée aux listes de chacun de ses trigrammes.
+     * \param[in] p_index Index de l'entrée.
+     * \param[in] p_texte Texte de l'entrée, avant normalisation.
+     * \pre L'index tient sur 32 bits.
+     */
+void IndexTrigrammes::ajouter(size_t p_index, std::string_view p_texte) {
+    PRECONDITION(p_index <= UINT32_MAX);
+
+    const uint32_t index = static_cast<uint32_t>(p_index);
+    for (int trigramme : _trigrammes(normaliser(p_texte))) {
+        if (!m_listeParTrigramme.contient(trigramme)) {
+            m_listeParTrigramme.inserer(trigramme, static_cast<int>(m_listes.size()));
+            m_listes.emplace_back();
+        }
+        std::vector<uint32_t>& liste = m_listes[m_listeParTrigramme.element(trigramme)];
+        // Les entrées arrivent presque toujours en ordre croissant; une position réutilisée s'insère à sa place
+        if (liste.empty() || liste.back() < index) {
+            liste.push_back(index);
+        } else {
+            liste.insert(std::lower_bound(liste.begin(), liste.end(), index), index);
+        }
+    }
+}
+    /**
+     * \brief Retire une entrée des listes de ses trigrammes.
+     * \param[in] p_index Index de l'entrée.
+     * \param[in] p_texte Le texte avec lequel l'entrée a été ajoutée.
+     */
+void IndexTrigrammes::retirer(size_t p_index, std::string_view p_texte) {
+    const uint32_t index = static_cast<uint32_t>(p_index);
+    for (int trigramme : _trigrammes(normaliser(p_texte))) {
+        PRECONDITION_AUDIT(m_listeParTrigramme.contient(trigramme));
+        std::vector<uint32_t>& liste = m_listes[m_listeParTrigramme.element(trigramme)];
+        auto position = std::lower_bound(liste.begin(), liste.end(), index);
+        ASSERTION(position != liste.end() && *position == index);
+        liste.erase(position);
+    }
+}
+    /**
+     * \brief Retourne les entrées qui partagent assez de trigrammes avec la requête.
+     * \details Toute entrée à une distance d'édition d'au plus p_distanceMax de la requête est retournée
+     * (sauf pour une requête si courte que le seuil tombe à zéro : un trigramme commun est alors exigé).
+     * Les candidats doivent encore être vérifiés avec distanceBornee().
+     * \param[in] p_requete Le texte cherché, avant normalisation.
+     * \param[in] p_distanceMax Distance d'édition maximale tolérée.
+     * \return Les index candidats, en ordre croissant.
+     */
+std::vector<size_t> IndexTrigrammes::candidats(std::string_view p_requete, size_t p_distanceMax) const {
+    const std::vector<int> trigrammes = _trigrammes(normaliser(p_requete));
+    const size_t n = trigrammes.size();
+    const size_t seuil = n > 3 * p_distanceMax ? n - 3 * p_distanceMax : 1;
+
+    std::vector<const std::vector<uint32_t>*> listes;
+    listes.reserve(n);
+    for (int trigramme : trigrammes) {
+        listes.push_back(_liste(trigramme));
+    }
+    std::sort(listes.begin(), listes.end(), [](const std::vector<uint32_t>* p_a, const std::vector<uint32_t>* p_b) {
+        return p_a->size() < p_b->size();
+    });
+
+    // Un candidat figure forcément dans l'une des n - seuil + 1 listes les plus courtes
+    const size_t nbParcourues = n - seuil + 1;
+    std::vector<uint32_t> fusion;
+    for (size_t i = 0; i < nbParcourues && i < n; ++i) {
+        fusion.insert(fusion.end(), listes[i]->begin(), listes[i]->end());
+    }
+    std::sort(fusion.begin(), fusion.end());
+
+    std::vector<size_t> resultats;
+    for (size_t debut = 0; debut < fusion.size();) {
+        const uint32_t index = fusion[debut];
+        size_t fin = debut;
+        while (fin < fusion.size() && fusion[fin] == index) {
+            ++fin;
+        }
+        size_t communs = fin - debut;
+        for (size_t i = nbParcourues; i < n && communs < seuil && communs + (n - i) >= seuil; ++i) {
+            if (std::binary_search(listes[i]->begin(), listes[i]->end(), index)) {
+                ++communs;
+            }
+        }
+        if (communs >= seuil) {
+            resultats.push_back(index);
+        }
+        debut = fin;
+    }
+    return resultats;
+}
+    /**
+     * \brief Retourne le nombre de trigrammes distincts indexés.
+     * \return Le nombre de listes.
+     */
+size_t IndexTrigrammes::nombreTrigrammes() const {
+    return m_listeParTrigramme.taille();
+}
+    /**
+     * \brief Normalise un texte : minuscules ASCII et lettres accentuées ramenées à leur base.
+     * \param[in] p_texte Le texte UTF-8.
+     * \return Le texte normalisé.
+     */
+std::string IndexTrigrammes::normaliser(std::string_view p_texte) {
+    std::string texte;
+    texte.reserve(p_texte.size());
+    labTableHachage::LecteurNormalise lecteur(p_texte);
+    for (int c = lecteur.suivant(); c >= 0; c = lecteur.suivant()) {
+        texte.push_back(static_cast<char>(c));
+    }
+    return texte;
+}
+    /**
+     * \brief Distance d'édition (Levenshtein) entre deux textes, calculée jusqu'à une borne.
+     * \details Le calcul s'arrête dès qu'une ligne entière de la matrice dépasse la borne.
+     * \param[in] p_a Premier texte.
+     * \param[in] p_b Second texte.
+     * \param[in] p_distanceMax La borne.
+     * \return La distance, ou p_distanceMax + 1 si elle dépasse la borne.
+     */
+size_t IndexTrigrammes::distanceBornee(std::string_view p_a, std::string_view p_b, size_t p_distanceMax) {
+    if (p_a.size() > p_b.size()) {
+        std::swap(p_a, p_b);
+    }
+    if (p_b.size() - p_a.size() > p_distanceMax) {
+        return p_distanceMax + 1;
+    }
+    std::vector<size_t> precedente(p_a.size() + 1);
+    std::vector<size_t> courante(p_a.size() + 1);
+    std::iota(precedente.begin(), precedente.end(), 0);
+
+    for (size_t j = 1; j <= p_b.size(); ++j) {
+        courante[0] = j;
+        size_t minimumLigne = j;
+        for (size_t i = 1; i <= p_a.size(); ++i) {
+            const size_t substitution = precedente[i - 1] + (p_a[i - 1] == p_b[j - 1] ? 0 : 1);
+            courante[i] = std::min({precedente[i] + 1, courante[i - 1] + 1, substitution});
+            minimumLigne = std::min(minimumLigne, courante[i]);
+        }
+        if (minimumLigne > p_distanceMax) {
+            return p_distanceMax + 1;
+        }
+        precedente.swap(courante);
+    }
+    return std::min(precedente[p_a.size()], p_distanceMax + 1);
+}
+    /**
+     * \brief Découpe un texte normalisé en trigrammes distincts, bordés de '$'.
+     * \param[in] p_texteNormalise Le texte normalisé.
+     * \return Les trigrammes (trois octets dans un int), triés et sans doublon.
+     */
+std::vector<int> IndexTrigrammes::_trigrammes(std::string_view p_texteNormalise) {
+    std::vector<int> trigrammes;
+    if (p_texteNormalise.empty()) {
+        return trigrammes;
+    }
+    const std::string borde = "$$" + std::string(p_texteNormalise) + "$";
+    trigrammes.reserve(borde.size() - 2);
+    for (size_t i = 0; i + 2 < borde.size(); ++i) {
+        trigrammes.push_back(static_cast<int>(static_cast<unsigned char>(borde[i])) << 16
+                             | static_cast<int>(static_cast<unsigned char>(borde[i + 1])) << 8
+                             | static_cast<int>(static_cast<unsigned char>(borde[i + 2])));
+    }
+    std::sort(trigrammes.begin(), trigrammes.end());
+    trigrammes.erase(std::unique(trigrammes.begin(), trigrammes.end()), trigrammes.end());
+    return trigrammes;
+}
+    /**
+     * \brief Retourne la liste d'un trigramme, vide s'il n'est pas indexé.
+     */
+const std::vector<uint32_t>* IndexTrigrammes::_liste(int p_trigramme) const {
+    if (!m_listeParTrigramme.contient(p_trigramme)) {
+        return &LISTE_VIDE;
+    }
+    return &m_listes[m_listeParTrigramme.element(p_trigramme)];
+}
+
+} // namespace TP3
@@ -0,0 +1,57 @@
+/**
+ * \file IndexTrigrammes.h
+ * \brief Index inversé de trigrammes pour la recherche approximative de noms.
+ *
+ * Chaque texte est normalisé (casse et accents, voir LecteurNormalise) puis
+ * découpé en trigrammes, bordés de '$' pour que le début et la fin du texte
+ * comptent. Une TableHachage associe chaque trigramme à sa liste (triée) des
+ * index d'entrées qui le contiennent.
+ *
+ * Une opération d'édition détruit au plus trois trigrammes : un texte à une
+ * distance d'au plus k de la requête partage donc au moins t = n - 3k de ses
+ * n trigrammes distincts. Il apparaît alors forcément dans l'une des
+ * n - t + 1 listes les plus courtes; seules ces listes sont parcourues, les
+ * autres ne servent qu'à compter par recherche dichotomique.
+ */
+#ifndef INDEXTRIGRAMMES_H
+#define INDEXTRIGRAMMES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "TableHachage.h"
+#include "FoncteurHachage.hpp"
+
+namespace TP3 {
+
+/**
+ * \class IndexTrigrammes
+ * \brief Associe chaque trigramme normalisé aux index des entrées qui le contiennent.
+ */
+class IndexTrigrammes {
+public:
+    IndexTrigrammes();
+
+    void ajouter(size_t p_index, std::string_view p_texte);
+    void retirer(size_t p_index, std::string_view p_texte);
+
+    std::vector<size_t> candidats(std::string_view p_requete, size_t p_distanceMax) const;
+
+    size_t nombreTrigrammes() const;
+
+    static std::string normaliser(std::string_view p_texte);
+    static size_t distanceBornee(std::string_view p_a, std::string_view p_b, size_t p_distanceMax);
+
+private:
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2> m_listeParTrigramme; /*!< Trigramme vers le numéro de sa liste */
+    std::vector<std::vector<uint32_t> > m_listes; /*!< Index des entrées de chaque trigramme, en ordre croissant */
+
+    static std::vector<int> _trigrammes(std::string_view p_texteNormalise);
+    const std::vector<uint32_t>* _liste(int p_trigramme) const;
+};
+
+} // namespace TP3
+
+#endif // INDEXTRIGRAMMES_H
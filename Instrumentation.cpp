@@ -0,0 +1,309 @@
+/**
+ * \file Instrumentation.cpp
+ * \brief Implantation des mesures par phase et de la lecture des compteurs matériels
+ *
+ */
+#include "Instrumentation.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace labTableHachage
+{
+
+std::atomic<uint32_t> Instrumentation::s_periode(1024);
+Instrumentation::Cumul Instrumentation::s_cumuls[static_cast<size_t>(Phase::NOMBRE_PHASES)];
+
+namespace
+{
+    constexpr size_t NB_COMPTEURS = 3;
+
+    constexpr uint64_t CONFIGURATIONS[NB_COMPTEURS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    /**
+     * \brief Groupe de compteurs matériels du fil courant, ouvert au premier usage
+     *
+     * Le premier compteur qui s'ouvre mène le groupe : une seule lecture
+     * retourne tous les compteurs ouverts, dans leur ordre d'ouverture.
+     */
+    class CompteursFil
+    {
+    public:
+        CompteursFil() : m_meneur(-1), m_nbOuverts(0)
+        {
+            for (size_t i = 0; i < NB_COMPTEURS; ++i)
+            {
+                m_fds[i] = -1;
+                m_ordre[i] = NB_COMPTEURS;
+            }
+            for (size_t i = 0; i < NB_COMPTEURS; ++i)
+            {
+                perf_event_attr attributs;
+                std::memset(&attributs, 0, sizeof(attributs));
+                attributs.size = sizeof(attributs);
+                attributs.type = PERF_TYPE_HARDWARE;
+                attributs.config = CONFIGURATIONS[i];
+                attributs.disabled = m_meneur < 0 ? 1 : 0;
+                attributs.exclude_kernel = 1;
+                attributs.exclude_hv = 1;
+                attributs.read_format = PERF_FORMAT_GROUP;
+                const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attributs, 0, -1, m_meneur, 0));
+                if (fd < 0)
+                {
+                    continue;
+                }
+                if (m_meneur < 0)
+                {
+                    m_meneur = fd;
+                }
+                m_fds[i] = fd;
+                m_ordre[m_nbOuverts++] = i;
+            }
+            if (m_meneur >= 0)
+            {
+                ioctl(m_meneur, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+
+        ~CompteursFil()
+        {
+            for (int fd : m_fds)
+            {
+                if (fd >= 0)
+                {
+                    close(fd);
+                }
+            }
+        }
+
+        bool disponibles() const
+        {
+            return m_meneur >= 0;
+        }
+
+        /**
+         * \brief Lit les compteurs du groupe
+         * \param[out] p_valeurs Les valeurs, indexées comme CONFIGURATIONS; 0 pour un compteur non ouvert
+         * \return Faux si le groupe n'a pas pu être lu
+         */
+        bool lire(uint64_t (&p_valeurs)[NB_COMPTEURS]) const
+        {
+            if (m_meneur < 0)
+            {
+                return false;
+            }
+            uint64_t tampon[1 + NB_COMPTEURS];
+            const ssize_t lus = read(m_meneur, tampon, sizeof(tampon));
+            if (lus < static_cast<ssize_t>(sizeof(uint64_t) * (1 + m_nbOuverts)) || tampon[0] != m_nbOuverts)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < NB_COMPTEURS; ++i)
+            {
+                p_valeurs[i] = 0;
+            }
+            for (size_t i = 0; i < m_nbOuverts; ++i)
+            {
+                p_valeurs[m_ordre[i]] = tampon[1 + i];
+            }
+            return true;
+        }
+
+    private:
+        int m_fds[NB_COMPTEURS];
+        int m_meneur;
+        size_t m_ordre[NB_COMPTEURS]; /*!< Index dans CONFIGURATIONS de chaque valeur lue */
+        size_t m_nbOuverts;
+    };
+
+    const CompteursFil & compteursFil()
+    {
+        thread_local const CompteursFil compteurs;
+        return compteurs;
+    }
+
+    uint64_t maintenantNanosecondes()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+#if INSTRUMENTATION_ACTIVE
+    /**
+     * \brief Écrit les cumuls à la sortie du programme si BOTTIN_INSTRUMENTATION donne un chemin
+     */
+    struct EcritureALaSortie
+    {
+        ~EcritureALaSortie()
+        {
+            const char * chemin = std::getenv("BOTTIN_INSTRUMENTATION");
+            if (chemin == nullptr || *chemin == '\0')
+            {
+                return;
+            }
+            std::ofstream sortie(chemin);
+            if (sortie.is_open())
+            {
+                Instrumentation::ecrireJson(sortie);
+            }
+        }
+    } ecritureALaSortie;
+#endif
+}
+
+/**
+ * \brief Indique si les compteurs matériels peuvent être lus dans le fil courant
+ * \return Faux si perf_event_open est refusé; seul le temps est alors mesuré
+ */
+bool Instrumentation::compteursDisponibles()
+{
+    return compteursFil().disponibles();
+}
+
+/**
+ * \brief Retourne le cumul d'une phase
+ * \param[in] p_phase La phase
+ * \return Le cumul, mis à jour par les mesures en cours dans les autres fils
+ */
+const Instrumentation::Cumul & Instrumentation::cumul(Phase p_phase)
+{
+    return s_cumuls[static_cast<size_t>(p_phase)];
+}
+
+/**
+ * \brief Remet tous les cumuls à zéro
+ * \post Une mesure en cours dans un autre fil peut encore s'ajouter au cumul remis à zéro
+ */
+void Instrumentation::reinitialiser()
+{
+    for (Cumul & cumul : s_cumuls)
+    {
+        cumul.m_echantillons.store(0, std::memory_order_relaxed);
+        cumul.m_nanosecondes.store(0, std::memory_order_relaxed);
+        cumul.m_echantillonsCompteurs.store(0, std::memory_order_relaxed);
+        cumul.m_cycles.store(0, std::memory_order_relaxed);
+        cumul.m_defautsCache.store(0, std::memory_order_relaxed);
+        cumul.m_erreursBranchement.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * \brief Écrit les cumuls de toutes les phases en JSON
+ * \param[out] p_sortie Le flux de sortie
+ */
+void Instrumentation::ecrireJson(std::ostream & p_sortie)
+{
+    p_sortie << "{\"instrumentation\": " << (INSTRUMENTATION_ACTIVE ? "true" : "false")
+            << ", \"compteursMateriels\": " << (compteursDisponibles() ? "true" : "false")
+            << ", \"periodeEchantillonnage\": " << periodeEchantillonnage()
+            << ", \"phases\": {";
+    for (size_t i = 0; i < static_cast<size_t>(Phase::NOMBRE_PHASES); ++i)
+    {
+        const Cumul & c = s_cumuls[i];
+        const uint64_t echantillons = c.m_echantillons.load(std::memory_order_relaxed);
+        const uint64_t nanosecondes = c.m_nanosecondes.load(std::memory_order_relaxed);
+        p_sortie << (i == 0 ? "" : ", ") << '"' << nomPhase(static_cast<Phase>(i)) << "\": {"
+                << "\"echantillons\": " << echantillons
+                << ", \"nanosecondes\": " << nanosecondes
+                << ", \"nanosecondesParEchantillon\": " << (echantillons == 0 ? 0 : nanosecondes / echantillons)
+                << ", \"echantillonsCompteurs\": " << c.m_echantillonsCompteurs.load(std::memory_order_relaxed)
+                << ", \"cycles\": " << c.m_cycles.load(std::memory_order_relaxed)
+                << ", \"defautsCache\": " << c.m_defautsCache.load(std::memory_order_relaxed)
+                << ", \"erreursBranchement\": " << c.m_erreursBranchement.load(std::memory_order_relaxed)
+                << '}';
+    }
+    p_sortie << "}}\n";
+    p_sortie.flush();
+}
+
+/**
+ * \brief Retourne la période d'échantillonnage des phases fréquentes
+ * \return Un appel sur combien est mesuré, dans chaque fil
+ */
+uint32_t Instrumentation::periodeEchantillonnage()
+{
+    return s_periode.load(std::memory_order_relaxed);
+}
+
+/**
+ * \brief Change la période d'échantillonnage des phases fréquentes
+ * \param[in] p_periode Un appel sur p_periode est mesuré; 1 (ou 0) pour tous
+ * \post Chaque fil adopte la nouvelle période après sa prochaine mesure
+ */
+void Instrumentation::asgPeriodeEchantillonnage(uint32_t p_periode)
+{
+    s_periode.store(p_periode == 0 ? 1 : p_periode, std::memory_order_relaxed);
+}
+
+/**
+ * \brief Retourne le nom d'une phase, tel qu'écrit dans le JSON
+ * \param[in] p_phase La phase
+ * \return Le nom
+ */
+const char * Instrumentation::nomPhase(Phase p_phase)
+{
+    switch (p_phase)
+    {
+        case Phase::TABLE_REHACHAGE:
+            return "table_rehachage";
+        case Phase::TABLE_SONDAGE:
+            return "table_sondage";
+        case Phase::BOTTIN_CHARGEMENT:
+            return "bottin_chargement";
+        case Phase::BOTTIN_TRI_PREFIXES:
+            return "bottin_tri_prefixes";
+        default:
+            return "inconnue";
+    }
+}
+
+/**
+ * \brief Commence une mesure
+ * \param[in] p_phase La phase à laquelle la mesure sera ajoutée
+ * \param[in] p_mesurer Faux pour un appel non échantillonné : rien n'est lu ni cumulé
+ */
+MesurePhase::MesurePhase(Phase p_phase, bool p_mesurer) noexcept :
+m_phase(p_phase), m_mesurer(p_mesurer), m_debut()
+{
+    if (m_mesurer)
+    {
+        m_debut.m_nanosecondes = maintenantNanosecondes();
+        m_debut.m_compteursLus = compteursFil().lire(m_debut.m_compteurs);
+    }
+}
+
+/**
+ * \brief Termine la mesure et l'ajoute au cumul de sa phase
+ */
+MesurePhase::~MesurePhase()
+{
+    if (!m_mesurer)
+    {
+        return;
+    }
+    Lecture fin;
+    fin.m_compteursLus = m_debut.m_compteursLus && compteursFil().lire(fin.m_compteurs);
+    fin.m_nanosecondes = maintenantNanosecondes();
+
+    Instrumentation::Cumul & cumul = Instrumentation::s_cumuls[static_cast<size_t>(m_phase)];
+    cumul.m_echantillons.fetch_add(1, std::memory_order_relaxed);
+    cumul.m_nanosecondes.fetch_add(fin.m_nanosecondes - m_debut.m_nanosecondes, std::memory_order_relaxed);
+    if (fin.m_compteursLus)
+    {
+        cumul.m_echantillonsCompteurs.fetch_add(1, std::memory_order_relaxed);
+        cumul.m_cycles.fetch_add(fin.m_compteurs[0] - m_debut.m_compteurs[0], std::memory_order_relaxed);
+        cumul.m_defautsCache.fetch_add(fin.m_compteurs[1] - m_debut.m_compteurs[1], std::memory_order_relaxed);
+        cumul.m_erreursBranchement.fetch_add(fin.m_compteurs[2] - m_debut.m_compteurs[2], std::memory_order_relaxed);
+    }
+}
+
+} // namespace labTableHachage
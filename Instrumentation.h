@@ -0,0 +1,148 @@
+/**
+ * \file Instrumentation.h
+ * \brief Mesure optionnelle du temps et des compteurs matériels par phase.
+ *
+ * Les phases chaudes (rehachage, sondage des tables, chargement du bottin) sont
+ * entourées d'une mesure à portée : à la construction, on lit l'horloge et les
+ * compteurs matériels du fil (cycles, défauts de cache, erreurs de prédiction
+ * de branchement, via perf_event_open); à la destruction, on ajoute les écarts
+ * au cumul de la phase. Les cumuls peuvent être écrits en JSON sur demande, ou
+ * à la sortie du programme si la variable d'environnement
+ * BOTTIN_INSTRUMENTATION donne un chemin de fichier.
+ *
+ * Compilée seulement si INSTRUMENTATION_ACTIVE vaut 1 (option CMake
+ * INSTRUMENTATION); sinon les macros MESURER_PHASE ne produisent rien. Les
+ * phases fréquentes (un sondage par recherche) ne sont mesurées qu'une fois
+ * sur periodeEchantillonnage() par fil : les autres appels ne coûtent qu'un
+ * décompte local. Les phases imbriquées sont mesurées de façon inclusive.
+ * Si le noyau refuse perf_event_open (perf_event_paranoid, conteneur), seul
+ * le temps est mesuré et le JSON l'indique.
+ */
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#ifndef INSTRUMENTATION_ACTIVE
+#define INSTRUMENTATION_ACTIVE 0
+#endif
+
+namespace labTableHachage
+{
+
+/**
+ * \enum Phase
+ * \brief Les phases mesurées, chacune avec son propre cumul.
+ */
+enum class Phase
+{
+    TABLE_REHACHAGE, /*!< rehacher() des tables de hachage */
+    TABLE_SONDAGE, /*!< _trouverPositionClef() des tables de hachage, échantillonnée */
+    BOTTIN_CHARGEMENT, /*!< Lecture et insertion de toutes les lignes du fichier */
+    BOTTIN_TRI_PREFIXES, /*!< Tri de l'index des préfixes à la fin du chargement */
+    NOMBRE_PHASES
+};
+
+/**
+ * \class Instrumentation
+ * \brief Cumuls par phase, partagés par tous les fils.
+ */
+class Instrumentation
+{
+public:
+    /**
+     * \brief Cumul d'une phase; une ligne de cache par phase
+     */
+    struct alignas(64) Cumul
+    {
+        std::atomic<uint64_t> m_echantillons{0}; /*!< Mesures cumulées */
+        std::atomic<uint64_t> m_nanosecondes{0};
+        std::atomic<uint64_t> m_echantillonsCompteurs{0}; /*!< Mesures où les compteurs ont été lus */
+        std::atomic<uint64_t> m_cycles{0};
+        std::atomic<uint64_t> m_defautsCache{0};
+        std::atomic<uint64_t> m_erreursBranchement{0};
+    };
+
+    static bool compteursDisponibles();
+    static const Cumul & cumul(Phase p_phase);
+    static void reinitialiser();
+    static void ecrireJson(std::ostream & p_sortie);
+
+    static uint32_t periodeEchantillonnage();
+    static void asgPeriodeEchantillonnage(uint32_t p_periode);
+
+    static const char * nomPhase(Phase p_phase);
+
+    /**
+     * \brief Décide si l'appel courant d'une phase fréquente est mesuré
+     * \return Vrai une fois sur periodeEchantillonnage() appels, par fil
+     */
+    static bool echantillonner() noexcept
+    {
+        thread_local uint32_t restants = 0;
+        if (restants != 0)
+        {
+            --restants;
+            return false;
+        }
+        restants = s_periode.load(std::memory_order_relaxed) - 1;
+        return true;
+    }
+
+private:
+    static std::atomic<uint32_t> s_periode;
+    static Cumul s_cumuls[static_cast<size_t>(Phase::NOMBRE_PHASES)];
+
+    friend class MesurePhase;
+};
+
+/**
+ * \class MesurePhase
+ * \brief Mesure à portée : ajoute au cumul d'une phase le temps et les compteurs écoulés.
+ */
+class MesurePhase
+{
+public:
+    explicit MesurePhase(Phase p_phase, bool p_mesurer = true) noexcept;
+    ~MesurePhase();
+
+    MesurePhase(const MesurePhase &) = delete;
+    MesurePhase & operator=(const MesurePhase &) = delete;
+
+    /**
+     * \brief Valeurs lues au début ou à la fin d'une mesure
+     */
+    struct Lecture
+    {
+        uint64_t m_nanosecondes;
+        uint64_t m_compteurs[3]; /*!< Cycles, défauts de cache, erreurs de branchement */
+        bool m_compteursLus;
+    };
+
+private:
+    Phase m_phase;
+    bool m_mesurer;
+    Lecture m_debut;
+};
+
+} // namespace labTableHachage
+
+#define INSTRUMENTATION_CONCATENER2(a, b) a##b
+#define INSTRUMENTATION_CONCATENER(a, b) INSTRUMENTATION_CONCATENER2(a, b)
+
+#if INSTRUMENTATION_ACTIVE
+#define MESURER_PHASE(phase) \
+      labTableHachage::MesurePhase INSTRUMENTATION_CONCATENER(mesurePhase_, __LINE__)(phase)
+#define MESURER_PHASE_ECHANTILLONNEE(phase) \
+      labTableHachage::MesurePhase INSTRUMENTATION_CONCATENER(mesurePhase_, __LINE__)( \
+              phase, labTableHachage::Instrumentation::echantillonner())
+#else
+#define MESURER_PHASE(phase) do { } while (false)
+#define MESURER_PHASE_ECHANTILLONNEE(phase) do { } while (false)
+#endif
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,439 @@
+/**
+ * \file JournalBottin.cpp
+ * \brief Implantation du journal des modifications d'un bottin.
+ */
+#include "JournalBottin.h"
+#include "ProtocoleBottin.h"
+#include "ContratException.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace TP3 {
+
+namespace {
+    constexpr char MAGIE[4] = {'B', 'O', 'T', 'J'};
+    constexpr uint64_t FNV_DEPART = 0xcbf29ce484222325ull;
+
+    [[noreturn]] void echecSysteme(const std::string& p_appel, const std::string& p_chemin) {
+        throw std::runtime_error("Erreur : " + p_appel + " (" + p_chemin + ") : " + std::strerror(errno));
+    }
+
+    /**
+     * \brief FNV-1a sur 64 bits, poursuivi à partir d'un état pour traiter un fichier par morceaux.
+     */
+    uint64_t empreinte(std::string_view p_octets, uint64_t p_etat = FNV_DEPART) {
+        for (unsigned char c : p_octets) {
+            p_etat = (p_etat ^ c) * 0x100000001b3ull;
+        }
+        return p_etat;
+    }
+
+    uint64_t empreinteFichier(const std::string& p_chemin) {
+        std::ifstream fichier(p_chemin, std::ios::binary);
+        uint64_t etat = FNV_DEPART;
+        char morceau[1 << 16];
+        while (fichier.read(morceau, sizeof(morceau)) || fichier.gcount() > 0) {
+            etat = empreinte(std::string_view(morceau, static_cast<size_t>(fichier.gcount())), etat);
+        }
+        return etat;
+    }
+
+    uint32_t sommeControle(std::string_view p_octets) {
+        const uint64_t h = empreinte(p_octets);
+        return static_cast<uint32_t>(h ^ (h >> 32));
+    }
+
+    std::string lireFichier(const std::string& p_chemin) {
+        std::ifstream fichier(p_chemin, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(fichier), std::istreambuf_iterator<char>());
+    }
+
+    void ecrireTout(int p_fd, std::string_view p_octets, const std::string& p_chemin) {
+        while (!p_octets.empty()) {
+            const ssize_t ecrits = write(p_fd, p_octets.data(), p_octets.size());
+            if (ecrits < 0) {
+                if (errno == EINTR) continue;
+                echecSysteme("write", p_chemin);
+            }
+            p_octets.remove_prefix(static_cast<size_t>(ecrits));
+        }
+    }
+
+    /**
+     * \brief Écrit un fichier complet et le synchronise sur disque, sans le rendre visible.
+     */
+    void ecrireFichierSynchronise(const std::string& p_chemin, std::string_view p_contenu) {
+        const int fd = open(p_chemin.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) echecSysteme("open", p_chemin);
+        try {
+            ecrireTout(fd, p_contenu, p_chemin);
+            if (fsync(fd) < 0) echecSysteme("fsync", p_chemin);
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+        close(fd);
+    }
+
+    /**
+     * \brief Synchronise le répertoire d'un fichier, pour rendre durable un renommage.
+     */
+    void synchroniserRepertoire(const std::string& p_chemin) {
+        const size_t barre = p_chemin.find_last_of('/');
+        const std::string repertoire = barre == std::string::npos ? "." : (barre == 0 ? "/" : p_chemin.substr(0, barre));
+        const int fd = open(repertoire.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) echecSysteme("open", repertoire);
+        fsync(fd);
+        close(fd);
+    }
+
+    std::string enTete(uint64_t p_empreinteBase, uint32_t p_version) {
+        std::string resultat(MAGIE, sizeof(MAGIE));
+        resultat.append(reinterpret_cast<const char*>(&p_version), sizeof(p_version));
+        resultat.append(reinterpret_cast<const char*>(&p_empreinteBase), sizeof(p_empreinteBase));
+        return resultat;
+    }
+
+    /**
+     * \brief Nombre de textes d'un enregistrement selon son type, 0 pour un type inconnu.
+     */
+    size_t nombreTextes(uint8_t p_type) {
+        switch (p_type) {
+            case 1: return 5; // AJOUT
+            case 2: return 2; // SUPPRESSION
+            case 3: return 7; // MODIFICATION
+            default: return 0;
+        }
+    }
+}
+
+    /**
+     * \brief Ouvre le journal et le rejoue sur le bottin.
+     * \param[in,out] p_bottin Le bottin, chargé du fichier de base.
+     * \param[in] p_cheminBase Le fichier de base (TSV) d'où le bottin a été chargé.
+     * \param[in] p_cheminJournal Le fichier de journal, créé s'il n'existe pas.
+     * \param[in] p_seuilCompaction Taille du journal, en octets, au-delà de laquelle une modification
+     * déclenche un compactage; 0 pour ne jamais compacter automatiquement.
+     * \pre Le bottin n'est pas figé.
+     * \throw std::runtime_error si un fichier ne peut pas être lu ou écrit.
+     * \post Les modifications durables du journal sont appliquées au bottin.
+     */
+JournalBottin::JournalBottin(Bottin& p_bottin, const std::string& p_cheminBase, const std::string& p_cheminJournal,
+                             size_t p_seuilCompaction)
+    : m_bottin(p_bottin), m_cheminBase(p_cheminBase), m_cheminJournal(p_cheminJournal),
+      m_seuilCompaction(p_seuilCompaction), m_fd(-1), m_nombreRejoues(0), m_mutexBottin(), m_mutexJournal(),
+      m_conditionDurable(), m_tampon(), m_dernierConsigne(0), m_dernierDurable(0), m_ecritureEnCours(false),
+      m_tailleJournal(0), m_erreurEcriture() {
+    PRECONDITION(!p_bottin.estFige() && "Un bottin figé ne peut pas être modifié");
+    _ouvrir();
+}
+    /**
+     * \brief Ferme le journal; toutes les modifications retournées sont déjà durables.
+     */
+JournalBottin::~JournalBottin() {
+    if (m_fd >= 0) close(m_fd);
+}
+    /**
+     * \brief Ajoute une entrée au bottin et consigne l'ajout.
+     * \details Mêmes paramètres et préconditions que Bottin::ajouter(); une précondition non respectée
+     * n'est pas consignée.
+     * \throw std::runtime_error si le journal ne peut pas être écrit : l'entrée est ajoutée au bottin
+     * mais l'ajout n'est pas durable.
+     * \post L'ajout survivra à un redémarrage.
+     */
+void JournalBottin::ajouter(const std::string& p_nom, const std::string& p_prenom,
+                            const std::string& p_telephoneFixe, const std::string& p_cellulaire,
+                            const std::string& p_courriel) {
+    uint64_t numero;
+    {
+        std::lock_guard<std::mutex> verrou(m_mutexBottin);
+        m_bottin.ajouter(p_nom, p_prenom, p_telephoneFixe, p_cellulaire, p_courriel);
+        numero = _consigner(TypeModification::AJOUT, {p_nom, p_prenom, p_telephoneFixe, p_cellulaire, p_courriel});
+    }
+    _attendreDurable(numero);
+    _compacterSiNecessaire();
+}
+    /**
+     * \brief Supprime une entrée du bottin et consigne la suppression.
+     * \details Mêmes paramètres et préconditions que Bottin::supprimer().
+     * \throw std::runtime_error si le journal ne peut pas être écrit.
+     * \post La suppression survivra à un redémarrage.
+     */
+void JournalBottin::supprimer(const std::string& p_nom, const std::string& p_prenom) {
+    uint64_t numero;
+    {
+        std::lock_guard<std::mutex> verrou(m_mutexBottin);
+        m_bottin.supprimer(p_nom, p_prenom);
+        numero = _consigner(TypeModification::SUPPRESSION, {p_nom, p_prenom});
+    }
+    _attendreDurable(numero);
+    _compacterSiNecessaire();
+}
+    /**
+     * \brief Modifie une entrée du bottin et consigne la modification.
+     * \details Mêmes paramètres et préconditions que Bottin::modifier().
+     * \throw std::runtime_error si le journal ne peut pas être écrit.
+     * \post La modification survivra à un redémarrage.
+     */
+void JournalBottin::modifier(const std::string& p_nom, const std::string& p_prenom,
+                             const std::string& p_nouveauNom, const std::string& p_nouveauPrenom,
+                             const std::string& p_telephoneFixe, const std::string& p_cellulaire,
+                             const std::string& p_courriel) {
+    uint64_t numero;
+    {
+        std::lock_guard<std::mutex> verrou(m_mutexBottin);
+        m_bottin.modifier(p_nom, p_prenom, p_nouveauNom, p_nouveauPrenom, p_telephoneFixe, p_cellulaire, p_courriel);
+        numero = _consigner(TypeModification::MODIFICATION, {p_nom, p_prenom, p_nouveauNom, p_nouveauPrenom,
+                                                             p_telephoneFixe, p_cellulaire, p_courriel});
+    }
+    _attendreDurable(numero);
+    _compacterSiNecessaire();
+}
+    /**
+     * \brief Réécrit le fichier de base à partir du bottin et recommence un journal vide.
+     * \details Les deux fichiers sont écrits à côté puis renommés; un arrêt à n'importe quel moment
+     * laisse une base et un journal qui, rejoués, redonnent le bottin.
+     * \throw std::runtime_error si un fichier ne peut pas être écrit.
+     * \post tailleJournal() ne compte plus que l'en-tête.
+     */
+void JournalBottin::compacter() {
+    std::lock_guard<std::mutex> verrou(m_mutexBottin);
+    _compacter();
+}
+    /**
+     * \brief Retourne la taille du journal, en octets.
+     * \return La taille du fichier, enregistrements en attente d'écriture compris.
+     */
+size_t JournalBottin::tailleJournal() const {
+    std::lock_guard<std::mutex> verrou(m_mutexJournal);
+    return m_tailleJournal;
+}
+    /**
+     * \brief Retourne le nombre d'enregistrements rejoués à l'ouverture.
+     * \return Le nombre de modifications appliquées au bottin par le constructeur.
+     */
+size_t JournalBottin::nombreRejoues() const {
+    return m_nombreRejoues;
+}
+    /**
+     * \brief Rejoue le journal existant s'il correspond à la base, sinon en commence un nouveau.
+     * \details Un journal d'une autre base est renommé avec le suffixe « .perime » plutôt que supprimé.
+     */
+void JournalBottin::_ouvrir() {
+    const uint64_t empreinteBase = empreinteFichier(m_cheminBase);
+    const std::string contenu = lireFichier(m_cheminJournal);
+
+    const bool valide = contenu.size() >= TAILLE_EN_TETE
+                        && contenu.compare(0, TAILLE_EN_TETE, enTete(empreinteBase, VERSION_FORMAT)) == 0;
+    if (!contenu.empty() && !valide) {
+        const std::string perime = m_cheminJournal + ".perime";
+        if (std::rename(m_cheminJournal.c_str(), perime.c_str()) != 0) echecSysteme("rename", m_cheminJournal);
+    }
+
+    if (valide) {
+        const size_t fin = _rejouer(contenu);
+        if (fin < contenu.size() && truncate(m_cheminJournal.c_str(), static_cast<off_t>(fin)) < 0) {
+            echecSysteme("truncate", m_cheminJournal);
+        }
+        m_tailleJournal = fin;
+    } else {
+        const std::string temporaire = m_cheminJournal + ".tmp";
+        ecrireFichierSynchronise(temporaire, enTete(empreinteBase, VERSION_FORMAT));
+        if (std::rename(temporaire.c_str(), m_cheminJournal.c_str()) != 0) echecSysteme("rename", temporaire);
+        synchroniserRepertoire(m_cheminJournal);
+        m_tailleJournal = TAILLE_EN_TETE;
+    }
+
+    m_fd = open(m_cheminJournal.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (m_fd < 0) echecSysteme("open", m_cheminJournal);
+}
+    /**
+     * \brief Applique au bottin les enregistrements complets et intègres du journal.
+     * \param[in] p_contenu Le journal, en-tête compris.
+     * \return La position de la fin du dernier enregistrement valide.
+     */
+size_t JournalBottin::_rejouer(const std::string& p_contenu) {
+    size_t position = TAILLE_EN_TETE;
+    std::string textes[7];
+    while (p_contenu.size() - position >= protocole::TAILLE_LONGUEUR) {
+        uint32_t longueur;
+        std::memcpy(&longueur, p_contenu.data() + position, sizeof(longueur));
+        if (p_contenu.size() - position - protocole::TAILLE_LONGUEUR < longueur) break; // écriture interrompue
+
+        const std::string_view corps(p_contenu.data() + position + protocole::TAILLE_LONGUEUR, longueur);
+        protocole::Lecteur lecteur(corps);
+        const uint32_t somme = lecteur.u32();
+        if (!lecteur.valide() || somme != sommeControle(corps.substr(sizeof(somme)))) break;
+        const uint8_t type = lecteur.u8();
+        const size_t nombre = nombreTextes(type);
+        for (size_t i = 0; i < nombre; ++i) {
+            textes[i] = lecteur.texte();
+        }
+        if (nombre == 0 || !lecteur.valide() || !lecteur.fini()) break;
+
+        _appliquer(static_cast<TypeModification>(type), textes);
+        ++m_nombreRejoues;
+        position += protocole::TAILLE_LONGUEUR + longueur;
+    }
+    return position;
+}
+    /**
+     * \brief Applique une modification rejouée au bottin.
+     * \param[in] p_type Le type de la modification.
+     * \param[in] p_textes Les textes de l'enregistrement, dans l'ordre des paramètres de la méthode du bottin.
+     */
+void JournalBottin::_appliquer(TypeModification p_type, const std::string* p_textes) {
+    switch (p_type) {
+        case TypeModification::AJOUT:
+            m_bottin.ajouter(p_textes[0], p_textes[1], p_textes[2], p_textes[3], p_textes[4]);
+            break;
+        case TypeModification::SUPPRESSION:
+            m_bottin.supprimer(p_textes[0], p_textes[1]);
+            break;
+        case TypeModification::MODIFICATION:
+            m_bottin.modifier(p_textes[0], p_textes[1], p_textes[2], p_textes[3], p_textes[4], p_textes[5], p_textes[6]);
+            break;
+    }
+}
+    /**
+     * \brief Met un enregistrement dans le tampon du journal.
+     * \param[in] p_type Le type de la modification.
+     * \param[in] p_textes Les textes de l'enregistrement.
+     * \return Le numéro de l'enregistrement, à passer à _attendreDurable().
+     */
+uint64_t JournalBottin::_consigner(TypeModification p_type, std::initializer_list<std::string_view> p_textes) {
+    std::string enregistrement;
+    protocole::Ecrivain ecrivain(enregistrement);
+    ecrivain.u32(0); // somme de contrôle, calculée une fois l'enregistrement complet
+    ecrivain.u8(static_cast<uint8_t>(p_type));
+    for (std::string_view texte : p_textes) {
+        ecrivain.texte(texte);
+    }
+    ecrivain.terminer();
+    const size_t debutDonnees = protocole::TAILLE_LONGUEUR + sizeof(uint32_t);
+    const uint32_t somme = sommeControle(std::string_view(enregistrement).substr(debutDonnees));
+    std::memcpy(&enregistrement[protocole::TAILLE_LONGUEUR], &somme, sizeof(somme));
+
+    std::lock_guard<std::mutex> verrou(m_mutexJournal);
+    m_tampon += enregistrement;
+    m_tailleJournal += enregistrement.size();
+    return ++m_dernierConsigne;
+}
+    /**
+     * \brief Attend qu'un enregistrement soit écrit et synchronisé, en écrivant au besoin tout le groupe en attente.
+     * \details Si aucun fil n'écrit, l'appelant écrit tout le tampon et fait un seul fdatasync; sinon il attend
+     * l'écriture en cours, qui a peut-être déjà emporté son enregistrement.
+     * \param[in] p_numero Le numéro retourné par _consigner().
+     * \throw std::runtime_error si l'écriture échoue; les écritures suivantes échouent aussi.
+     */
+void JournalBottin::_attendreDurable(uint64_t p_numero) {
+    std::unique_lock<std::mutex> verrou(m_mutexJournal);
+    while (m_dernierDurable < p_numero) {
+        if (m_erreurEcriture) std::rethrow_exception(m_erreurEcriture);
+        if (m_ecritureEnCours) {
+            m_conditionDurable.wait(verrou);
+            continue;
+        }
+        m_ecritureEnCours = true;
+        std::string groupe;
+        groupe.swap(m_tampon);
+        const uint64_t dernierDuGroupe = m_dernierConsigne;
+        verrou.unlock();
+
+        std::exception_ptr erreur;
+        try {
+            ecrireTout(m_fd, groupe, m_cheminJournal);
+            if (fdatasync(m_fd) < 0) echecSysteme("fdatasync", m_cheminJournal);
+        } catch (...) {
+            erreur = std::current_exception();
+        }
+
+        verrou.lock();
+        m_ecritureEnCours = false;
+        if (erreur) {
+            m_erreurEcriture = erreur;
+        } else {
+            m_dernierDurable = dernierDuGroupe;
+        }
+        m_conditionDurable.notify_all();
+    }
+}
+    /**
+     * \brief Compacte si le journal a dépassé le seuil.
+     */
+void JournalBottin::_compacterSiNecessaire() {
+    if (m_seuilCompaction == 0 || tailleJournal() <= m_seuilCompaction) {
+        return;
+    }
+    std::lock_guard<std::mutex> verrou(m_mutexBottin);
+    if (tailleJournal() > m_seuilCompaction) { // un autre fil a pu compacter entre-temps
+        _compacter();
+    }
+}
+    /**
+     * \brief Compacte le journal; m_mutexBottin doit être détenu.
+     * \details L'écriture du groupe en cours est attendue, puis les nouveaux groupes sont bloqués : les
+     * enregistrements en attente sont inclus dans la nouvelle base et n'ont plus à être écrits.
+     */
+void JournalBottin::_compacter() {
+    {
+        std::unique_lock<std::mutex> verrou(m_mutexJournal);
+        m_conditionDurable.wait(verrou, [this]() { return !m_ecritureEnCours; });
+        if (m_erreurEcriture) std::rethrow_exception(m_erreurEcriture);
+        m_ecritureEnCours = true;
+    }
+
+    const std::string baseTemporaire = m_cheminBase + ".tmp";
+    const std::string journalTemporaire = m_cheminJournal + ".tmp";
+    bool baseRemplacee = false;
+    std::exception_ptr erreur;
+    try {
+        const std::string base = _texteBase();
+        ecrireFichierSynchronise(baseTemporaire, base);
+        ecrireFichierSynchronise(journalTemporaire, enTete(empreinte(base), VERSION_FORMAT));
+
+        // Entre ces deux renommages, l'ancien journal ne correspond plus à la base et sera mis de côté
+        if (std::rename(baseTemporaire.c_str(), m_cheminBase.c_str()) != 0) echecSysteme("rename", baseTemporaire);
+        baseRemplacee = true;
+        if (std::rename(journalTemporaire.c_str(), m_cheminJournal.c_str()) != 0) echecSysteme("rename", journalTemporaire);
+        synchroniserRepertoire(m_cheminBase);
+        synchroniserRepertoire(m_cheminJournal);
+
+        const int fd = open(m_cheminJournal.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+        if (fd < 0) echecSysteme("open", m_cheminJournal);
+        close(m_fd);
+        m_fd = fd;
+    } catch (...) {
+        erreur = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> verrou(m_mutexJournal);
+    m_ecritureEnCours = false;
+    if (!erreur) {
+        m_tampon.clear();
+        m_dernierDurable = m_dernierConsigne;
+        m_tailleJournal = TAILLE_EN_TETE;
+    } else if (baseRemplacee) {
+        // L'ancien journal ne serait plus rejoué : continuer à y écrire perdrait les modifications
+        m_erreurEcriture = erreur;
+    }
+    m_conditionDurable.notify_all();
+    if (erreur) std::rethrow_exception(erreur);
+}
+    /**
+     * \brief Produit le fichier de base (TSV) du bottin, dans le format lu par son constructeur.
+     * \return La ligne d'en-tête (nombre d'entrées) puis une ligne par entrée, en ordre de clé.
+     */
+std::string JournalBottin::_texteBase() const {
+    std::ostringstream texte;
+    m_bottin.exporterTSV(texte, Bottin::OrdreExport::NOM);
+    return std::move(texte).str();
+}
+
+} // namespace TP3
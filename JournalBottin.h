@@ -0,0 +1,113 @@
+/**
+ * \file JournalBottin.h
+ * \brief Journal binaire des modifications d'un bottin, en ajout seulement.
+ *
+ * Chaque ajout, suppression ou modification faite par le journal est
+ * appliquée au Bottin puis consignée à la fin du fichier de journal avant que
+ * l'appel ne retourne. Les écritures concurrentes sont regroupées : le premier
+ * fil qui trouve le tampon non vide écrit tous les enregistrements en attente
+ * et fait un seul fdatasync pour tout le groupe.
+ *
+ * Au démarrage, le journal est rejoué sur le bottin chargé du fichier de base.
+ * Un enregistrement incomplet ou corrompu en fin de fichier (écriture
+ * interrompue) est tronqué. Le compactage réécrit le fichier de base à partir
+ * du bottin et recommence un journal vide.
+ *
+ * Format : en-tête (« BOTJ », uint32 version, uint64 empreinte du fichier de
+ * base), puis des enregistrements au format de ProtocoleBottin.h : uint32
+ * longueur, uint32 somme de contrôle du reste, uint8 type et les textes.
+ * L'empreinte lie le journal à la version du fichier de base sur laquelle il
+ * doit être rejoué : après un compactage interrompu entre le remplacement de
+ * la base et celui du journal, l'ancien journal (déjà inclus dans la base) est
+ * mis de côté au lieu d'être rejoué une seconde fois.
+ */
+#ifndef JOURNALBOTTIN_H
+#define JOURNALBOTTIN_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "Bottin.h"
+
+namespace TP3 {
+
+/**
+ * \class JournalBottin
+ * \brief Rend durables les modifications faites à un bottin pendant l'exécution.
+ *
+ * Le bottin ne doit être modifié que par le journal, et ne pas être figé. Les
+ * méthodes du journal peuvent être appelées de plusieurs fils; les lectures
+ * concurrentes du bottin restent à la charge de l'appelant.
+ */
+class JournalBottin {
+public:
+    JournalBottin(Bottin& p_bottin, const std::string& p_cheminBase, const std::string& p_cheminJournal,
+                  size_t p_seuilCompaction = 64u << 20);
+    ~JournalBottin();
+
+    JournalBottin(const JournalBottin&) = delete;
+    JournalBottin& operator=(const JournalBottin&) = delete;
+
+    void ajouter(const std::string& p_nom, const std::string& p_prenom,
+                 const std::string& p_telephoneFixe, const std::string& p_cellulaire,
+                 const std::string& p_courriel);
+    void supprimer(const std::string& p_nom, const std::string& p_prenom);
+    void modifier(const std::string& p_nom, const std::string& p_prenom,
+                  const std::string& p_nouveauNom, const std::string& p_nouveauPrenom,
+                  const std::string& p_telephoneFixe, const std::string& p_cellulaire,
+                  const std::string& p_courriel);
+
+    void compacter();
+
+    size_t tailleJournal() const;
+    size_t nombreRejoues() const;
+
+private:
+    /**
+     * \enum TypeModification
+     * \brief Type d'un enregistrement du journal.
+     */
+    enum class TypeModification : uint8_t {
+        AJOUT = 1,
+        SUPPRESSION = 2,
+        MODIFICATION = 3
+    };
+
+    static constexpr uint32_t VERSION_FORMAT = 1;
+    static constexpr size_t TAILLE_EN_TETE = 16;
+
+    Bottin& m_bottin;
+    std::string m_cheminBase;
+    std::string m_cheminJournal;
+    size_t m_seuilCompaction; /*!< Taille du journal déclenchant un compactage, 0 pour jamais */
+    int m_fd; /*!< Descripteur du journal, en ajout */
+    size_t m_nombreRejoues;
+
+    std::mutex m_mutexBottin; /*!< Sérialise les modifications : le journal suit l'ordre d'application */
+
+    mutable std::mutex m_mutexJournal; /*!< Protège les membres suivants */
+    std::condition_variable m_conditionDurable;
+    std::string m_tampon; /*!< Enregistrements pas encore écrits */
+    uint64_t m_dernierConsigne; /*!< Numéro du dernier enregistrement mis dans le tampon */
+    uint64_t m_dernierDurable; /*!< Numéro du dernier enregistrement écrit et synchronisé */
+    bool m_ecritureEnCours; /*!< Un fil écrit un groupe d'enregistrements */
+    size_t m_tailleJournal; /*!< Taille du fichier de journal, tampon compris */
+    std::exception_ptr m_erreurEcriture; /*!< Échec d'écriture : le journal n'est plus fiable */
+
+    void _ouvrir();
+    size_t _rejouer(const std::string& p_contenu);
+    void _appliquer(TypeModification p_type, const std::string* p_textes);
+    uint64_t _consigner(TypeModification p_type, std::initializer_list<std::string_view> p_textes);
+    void _attendreDurable(uint64_t p_numero);
+    void _compacterSiNecessaire();
+    void _compacter();
+    std::string _texteBase() const;
+};
+
+} // namespace TP3
+
+#endif // JOURNALBOTTIN_H
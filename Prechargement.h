@@ -0,0 +1,30 @@
+/**
+ * \file Prechargement.h
+ * \brief Préchargement explicite d'une adresse dans le cache.
+ *
+ * Utilisé par les recherches en lot : toutes les cases de départ d'un lot
+ * sont demandées à la mémoire avant d'être sondées, de sorte que leurs
+ * latences se recouvrent au lieu de s'additionner.
+ */
+#ifndef PRECHARGEMENT_H
+#define PRECHARGEMENT_H
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Demande le chargement en cache de l'adresse, pour une lecture prochaine
+ * \param[in] p_adresse L'adresse à précharger; elle n'est pas déréférencée
+ */
+inline void precharger(const void * p_adresse) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p_adresse, 0, 3);
+#else
+    (void) p_adresse;
+#endif
+}
+
+} //Fin du namespace
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * \file ProtocoleBottin.h
+ * \brief Protocole binaire du serveur de bottin.
+ *
+ * Chaque message est préfixé de sa longueur (uint32, sans compter ces quatre
+ * octets), puis contient l'identifiant de la requête (uint32), un octet de
+ * type (requête) ou de statut (réponse) et les données. Un texte est codé
+ * par sa longueur (uint16) suivie de ses octets. Le serveur n'écoute que sur
+ * un socket Unix local : les entiers sont dans l'ordre des octets de l'hôte.
+ *
+ * Requêtes :
+ *  - NOM_PRENOM : texte nom, texte prénom
+ *  - TELEPHONE : texte téléphone fixe
+ *  - LOT_TELEPHONES : uint32 nombre, puis nombre textes
+ *
+ * Réponses (même identifiant que la requête; elles peuvent arriver dans le
+ * désordre) :
+ *  - NOM_PRENOM, TELEPHONE : statut, puis l'entrée si TROUVE
+ *  - LOT_TELEPHONES : statut TROUVE, uint32 nombre, puis pour chaque clé
+ *    un octet de statut suivi de l'entrée si TROUVE
+ *  Une entrée est codée par cinq textes : nom, prénom, téléphone fixe,
+ *  cellulaire et courriel.
+ */
+#ifndef PROTOCOLEBOTTIN_H
+#define PROTOCOLEBOTTIN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace TP3 {
+namespace protocole {
+
+/**
+ * \enum TypeRequete
+ * \brief Type d'une requête, premier octet après l'identifiant.
+ */
+enum class TypeRequete : uint8_t {
+    NOM_PRENOM = 1,
+    TELEPHONE = 2,
+    LOT_TELEPHONES = 3
+};
+
+/**
+ * \enum Statut
+ * \brief Statut d'une réponse ou d'un élément d'un lot.
+ */
+enum class Statut : uint8_t {
+    TROUVE = 0,
+    ABSENT = 1,
+    INVALIDE = 2 /*!< requête mal formée ou de type inconnu */
+};
+
+inline constexpr size_t TAILLE_LONGUEUR = sizeof(uint32_t); /*!< Préfixe de longueur de chaque message */
+inline constexpr uint32_t TAILLE_MAX_MESSAGE = 1u << 24; /*!< Un message plus long ferme la connexion */
+inline constexpr uint32_t NOMBRE_MAX_LOT = 1u << 16; /*!< Nombre maximal de clés par lot */
+
+/**
+ * \class Ecrivain
+ * \brief Ajoute un message à la fin d'un tampon; la longueur est écrite par terminer().
+ */
+class Ecrivain {
+public:
+    /**
+     * \brief Commence un message à la fin du tampon.
+     * \param[in,out] p_tampon Le tampon de sortie.
+     */
+    explicit Ecrivain(std::string& p_tampon) : m_tampon(p_tampon), m_debut(p_tampon.size()) {
+        m_tampon.append(TAILLE_LONGUEUR, '\0');
+    }
+
+    void u8(uint8_t p_valeur) { m_tampon.push_back(static_cast<char>(p_valeur)); }
+    void u16(uint16_t p_valeur) { _brut(&p_valeur, sizeof(p_valeur)); }
+    void u32(uint32_t p_valeur) { _brut(&p_valeur, sizeof(p_valeur)); }
+    /**
+     * \brief Écrit un texte, tronqué à 65535 octets.
+     */
+    void texte(std::string_view p_texte) {
+        const uint16_t longueur = static_cast<uint16_t>(std::min<size_t>(p_texte.size(), UINT16_MAX));
+        u16(longueur);
+        m_tampon.append(p_texte.data(), longueur);
+    }
+    /**
+     * \brief Écrit la longueur du message dans son préfixe.
+     */
+    void terminer() {
+        const uint32_t longueur = static_cast<uint32_t>(m_tampon.size() - m_debut - TAILLE_LONGUEUR);
+        std::memcpy(&m_tampon[m_debut], &longueur, sizeof(longueur));
+    }
+
+private:
+    std::string& m_tampon;
+    size_t m_debut; /*!< Position du préfixe de longueur du message */
+
+    void _brut(const void* p_donnees, size_t p_taille) {
+        m_tampon.append(static_cast<const char*>(p_donnees), p_taille);
+    }
+};
+
+/**
+ * \class Lecteur
+ * \brief Lit les champs d'un message (sans son préfixe de longueur) avec vérification des bornes.
+ *
+ * Une lecture au-delà de la fin rend le lecteur invalide et retourne des valeurs nulles.
+ */
+class Lecteur {
+public:
+    explicit Lecteur(std::string_view p_message) : m_message(p_message), m_position(0), m_valide(true) {}
+
+    uint8_t u8() {
+        uint8_t valeur = 0;
+        _brut(&valeur, sizeof(valeur));
+        return valeur;
+    }
+    uint16_t u16() {
+        uint16_t valeur = 0;
+        _brut(&valeur, sizeof(valeur));
+        return valeur;
+    }
+    uint32_t u32() {
+        uint32_t valeur = 0;
+        _brut(&valeur, sizeof(valeur));
+        return valeur;
+    }
+    /**
+     * \brief Lit un texte; la vue désigne le message.
+     */
+    std::string_view texte() {
+        const uint16_t longueur = u16();
+        if (!m_valide || m_message.size() - m_position < longueur) {
+            m_valide = false;
+            return {};
+        }
+        const std::string_view resultat = m_message.substr(m_position, longueur);
+        m_position += longueur;
+        return resultat;
+    }
+
+    bool valide() const { return m_valide; }
+    bool fini() const { return m_position == m_message.size(); }
+
+private:
+    std::string_view m_message;
+    size_t m_position;
+    bool m_valide;
+
+    void _brut(void* p_destination, size_t p_taille) {
+        if (!m_valide || m_message.size() - m_position < p_taille) {
+            m_valide = false;
+            return;
+        }
+        std::memcpy(p_destination, m_message.data() + m_position, p_taille);
+        m_position += p_taille;
+    }
+};
+
+} // namespace protocole
+} // namespace TP3
+
+#endif // PROTOCOLEBOTTIN_H
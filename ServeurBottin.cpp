@@ -0,0 +1,396 @@
+/**
+ * \file ServeurBottin.cpp
+ * \brief Implantation du serveur local de recherches dans un bottin.
+ */
+#include "ServeurBottin.h"
+#include "ProtocoleBottin.h"
+#include "ContratException.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace TP3 {
+
+namespace {
+    constexpr int NB_EVENEMENTS = 64; /*!< Événements traités par appel à epoll_wait */
+    constexpr size_t TAILLE_LECTURE = 64 * 1024; /*!< Octets lus par appel à read */
+    constexpr size_t TAILLE_MAX_ENTREE = 16 * TAILLE_LECTURE; /*!< Octets reçus au-delà desquels _lire rend la main, si un message est complet */
+    constexpr size_t TAILLE_MAX_SORTIE = 1 << 20; /*!< Réponses en attente au-delà desquelles la lecture est suspendue */
+    constexpr size_t REQUETES_MAX_EN_COURS = 256; /*!< Requêtes d'une connexion confiées aux travailleurs, au plus */
+
+    /**
+     * \brief Lève une std::runtime_error décrivant l'échec d'un appel système.
+     */
+    [[noreturn]] void echecSysteme(const std::string& p_appel) {
+        throw std::runtime_error("Erreur : " + p_appel + " a échoué : " + std::strerror(errno));
+    }
+
+    void ecrireEntree(protocole::Ecrivain& p_ecrivain, const Bottin::Entree& p_entree) {
+        p_ecrivain.texte(p_entree.m_nom);
+        p_ecrivain.texte(p_entree.m_prenom);
+        p_ecrivain.texte(p_entree.m_telephoneFixe);
+        p_ecrivain.texte(p_entree.m_cellulaire);
+        p_ecrivain.texte(p_entree.m_courriel);
+    }
+
+    /**
+     * \brief Indique si le premier message reçu attend encore des octets.
+     * \details Une longueur annoncée invalide compte comme complète : _decouper fermera la connexion.
+     */
+    bool premierMessageIncomplet(const std::string& p_entree) {
+        if (p_entree.size() < protocole::TAILLE_LONGUEUR) return true;
+        uint32_t longueur;
+        std::memcpy(&longueur, p_entree.data(), sizeof(longueur));
+        return longueur <= protocole::TAILLE_MAX_MESSAGE && p_entree.size() - protocole::TAILLE_LONGUEUR < longueur;
+    }
+
+    void modifierEpoll(int p_epoll, int p_fd, uint32_t p_evenements) {
+        epoll_event evenement{};
+        evenement.events = p_evenements;
+        evenement.data.fd = p_fd;
+        epoll_ctl(p_epoll, EPOLL_CTL_MOD, p_fd, &evenement);
+    }
+}
+    /**
+     * \brief Crée le socket d'écoute et démarre les travailleurs.
+     * \param[in] p_bottin Le bottin consulté, dans sa version courante à chaque requête; il doit survivre au serveur.
+     * \param[in] p_chemin Chemin du socket Unix; un fichier existant à ce chemin est remplacé.
+     * \param[in] p_nbTravailleurs Nombre de fils qui traitent les requêtes.
+     * \pre Le chemin tient dans sockaddr_un::sun_path.
+     * \throw std::runtime_error si un appel système échoue.
+     */
+ServeurBottin::ServeurBottin(const BottinVersionne& p_bottin, const std::string& p_chemin, size_t p_nbTravailleurs)
+    : m_bottin(p_bottin), m_chemin(p_chemin), m_ecoute(-1), m_epoll(-1), m_reveil(-1), m_arret(false),
+      m_connexions(), m_mutexPretes(), m_connexionsPretes(), m_travailleurs() {
+    sockaddr_un adresse{};
+    PRECONDITION(p_chemin.size() < sizeof(adresse.sun_path));
+    adresse.sun_family = AF_UNIX;
+    std::memcpy(adresse.sun_path, p_chemin.c_str(), p_chemin.size() + 1);
+
+    m_ecoute = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_ecoute < 0) echecSysteme("socket");
+    unlink(p_chemin.c_str());
+    if (bind(m_ecoute, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) < 0) {
+        close(m_ecoute);
+        echecSysteme("bind");
+    }
+    if (listen(m_ecoute, SOMAXCONN) < 0) {
+        close(m_ecoute);
+        echecSysteme("listen");
+    }
+
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    m_reveil = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll < 0 || m_reveil < 0) {
+        close(m_ecoute);
+        echecSysteme("epoll_create1/eventfd");
+    }
+    for (int fd : {m_ecoute, m_reveil}) {
+        epoll_event evenement{};
+        evenement.events = EPOLLIN;
+        evenement.data.fd = fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &evenement);
+    }
+
+    m_travailleurs = std::make_unique<GroupeTravailleurs>(p_nbTravailleurs);
+}
+    /**
+     * \brief Termine les requêtes en cours, ferme les sockets et supprime le fichier du socket.
+     */
+ServeurBottin::~ServeurBottin() {
+    m_travailleurs.reset();
+    for (auto& paire : m_connexions) {
+        close(paire.first);
+    }
+    close(m_reveil);
+    close(m_epoll);
+    close(m_ecoute);
+    unlink(m_chemin.c_str());
+}
+    /**
+     * \brief Boucle du serveur : accepte, lit et écrit jusqu'à l'appel de arreter().
+     */
+void ServeurBottin::executer() {
+    epoll_event evenements[NB_EVENEMENTS];
+    while (!m_arret.load()) {
+        const int nombre = epoll_wait(m_epoll, evenements, NB_EVENEMENTS, -1);
+        if (nombre < 0) {
+            if (errno == EINTR) continue;
+            echecSysteme("epoll_wait");
+        }
+        for (int i = 0; i < nombre; ++i) {
+            const int fd = evenements[i].data.fd;
+            if (fd == m_ecoute) {
+                _accepter();
+            } else if (fd == m_reveil) {
+                uint64_t compteur;
+                while (read(m_reveil, &compteur, sizeof(compteur)) > 0) {
+                }
+                _ecrirePretes();
+            } else {
+                auto trouvee = m_connexions.find(fd);
+                if (trouvee == m_connexions.end()) continue;
+                const std::shared_ptr<Connexion> connexion = trouvee->second;
+                if (evenements[i].events & (EPOLLERR | EPOLLHUP)) {
+                    _fermer(*connexion);
+                    continue;
+                }
+                if (evenements[i].events & EPOLLOUT) {
+                    _ecrire(connexion);
+                }
+                if ((evenements[i].events & EPOLLIN) && !connexion->m_fermee) {
+                    _lire(connexion);
+                }
+            }
+        }
+    }
+}
+    /**
+     * \brief Demande l'arrêt de executer(); utilisable depuis un gestionnaire de signal.
+     */
+void ServeurBottin::arreter() noexcept {
+    m_arret.store(true);
+    _reveiller();
+}
+    /**
+     * \brief Traite un message de requête et ajoute la réponse au tampon.
+     * \param[in] p_bottin Le bottin consulté.
+     * \param[in] p_message La requête, sans son préfixe de longueur.
+     * \param[in,out] p_reponse Le tampon où la réponse (avec son préfixe) est ajoutée.
+     */
+void ServeurBottin::traiterRequete(const Bottin& p_bottin, std::string_view p_message, std::string& p_reponse) {
+    protocole::Lecteur lecteur(p_message);
+    const uint32_t identifiant = lecteur.u32();
+    const auto type = static_cast<protocole::TypeRequete>(lecteur.u8());
+
+    protocole::Ecrivain ecrivain(p_reponse);
+    ecrivain.u32(identifiant);
+
+    std::optional<Bottin::Entree> trouvee;
+    switch (type) {
+        case protocole::TypeRequete::NOM_PRENOM: {
+            const std::string_view nom = lecteur.texte();
+            const std::string_view prenom = lecteur.texte();
+            if (!lecteur.valide() || !lecteur.fini() || nom.empty() || prenom.empty()) break;
+            trouvee = p_bottin.chercherAvecNomPrenom(nom, prenom);
+            ecrivain.u8(static_cast<uint8_t>(trouvee ? protocole::Statut::TROUVE : protocole::Statut::ABSENT));
+            if (trouvee) ecrireEntree(ecrivain, *trouvee);
+            ecrivain.terminer();
+            return;
+        }
+        case protocole::TypeRequete::TELEPHONE: {
+            const std::string_view telephone = lecteur.texte();
+            if (!lecteur.valide() || !lecteur.fini()) break;
+            trouvee = p_bottin.chercherAvecTelephone(telephone);
+            ecrivain.u8(static_cast<uint8_t>(trouvee ? protocole::Statut::TROUVE : protocole::Statut::ABSENT));
+            if (trouvee) ecrireEntree(ecrivain, *trouvee);
+            ecrivain.terminer();
+            return;
+        }
+        case protocole::TypeRequete::LOT_TELEPHONES: {
+            const uint32_t nombre = lecteur.u32();
+            if (!lecteur.valide() || nombre > protocole::NOMBRE_MAX_LOT) break;
+            std::vector<std::string> telephones;
+            telephones.reserve(nombre);
+            for (uint32_t i = 0; i < nombre && lecteur.valide(); ++i) {
+                telephones.emplace_back(lecteur.texte());
+            }
+            if (!lecteur.valide() || !lecteur.fini()) break;
+            std::vector<std::optional<size_t> > resultats(nombre);
+            p_bottin.trouverPlusieursAvecTelephone(telephones, resultats);
+            ecrivain.u8(static_cast<uint8_t>(protocole::Statut::TROUVE));
+            ecrivain.u32(nombre);
+            for (const std::optional<size_t>& resultat : resultats) {
+                ecrivain.u8(static_cast<uint8_t>(resultat ? protocole::Statut::TROUVE : protocole::Statut::ABSENT));
+                if (resultat) ecrireEntree(ecrivain, p_bottin.reqEntree(*resultat));
+            }
+            ecrivain.terminer();
+            return;
+        }
+    }
+    ecrivain.u8(static_cast<uint8_t>(protocole::Statut::INVALIDE));
+    ecrivain.terminer();
+}
+    /**
+     * \brief Accepte toutes les connexions en attente.
+     */
+void ServeurBottin::_accepter() {
+    for (;;) {
+        const int fd = accept4(m_ecoute, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        auto connexion = std::make_shared<Connexion>();
+        connexion->m_fd = fd;
+        epoll_event evenement{};
+        evenement.events = EPOLLIN;
+        evenement.data.fd = fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &evenement);
+        m_connexions[fd] = std::move(connexion);
+    }
+}
+    /**
+     * \brief Lit les octets disponibles, jusqu'à TAILLE_MAX_ENTREE, puis découpe les messages reçus.
+     * \details La limite ne s'applique qu'une fois le premier message complet : un message peut
+     * atteindre TAILLE_MAX_MESSAGE. epoll est en mode niveau : ce qui reste dans le socket
+     * redéclenche EPOLLIN.
+     */
+void ServeurBottin::_lire(const std::shared_ptr<Connexion>& p_connexion) {
+    Connexion& connexion = *p_connexion;
+    char tampon[TAILLE_LECTURE];
+    while (connexion.m_entree.size() < TAILLE_MAX_ENTREE || premierMessageIncomplet(connexion.m_entree)) {
+        const ssize_t lus = read(connexion.m_fd, tampon, sizeof(tampon));
+        if (lus > 0) {
+            connexion.m_entree.append(tampon, static_cast<size_t>(lus));
+            continue;
+        }
+        if (lus == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            _fermer(connexion);
+            return;
+        }
+        if (errno != EINTR) break;
+    }
+    _decouper(p_connexion);
+}
+    /**
+     * \brief Confie chaque message complet reçu aux travailleurs.
+     * \details Un message annoncé plus long que TAILLE_MAX_MESSAGE, ou trop court pour contenir
+     * son identifiant et son type, ferme la connexion. Lorsque la connexion a REQUETES_MAX_EN_COURS
+     * requêtes en cours ou TAILLE_MAX_SORTIE octets de réponses en attente, les messages suivants
+     * restent dans m_entree et EPOLLIN est retiré; _ecrire le rétablit quand le client a lu.
+     */
+void ServeurBottin::_decouper(const std::shared_ptr<Connexion>& p_connexion) {
+    Connexion& connexion = *p_connexion;
+    bool saturee = false;
+    size_t position = 0;
+    while (connexion.m_entree.size() - position >= protocole::TAILLE_LONGUEUR) {
+        uint32_t longueur;
+        std::memcpy(&longueur, connexion.m_entree.data() + position, sizeof(longueur));
+        if (longueur > protocole::TAILLE_MAX_MESSAGE || longueur < sizeof(uint32_t) + 1) {
+            _fermer(connexion);
+            return;
+        }
+        if (connexion.m_entree.size() - position - protocole::TAILLE_LONGUEUR < longueur) break;
+        {
+            std::lock_guard<std::mutex> verrou(connexion.m_mutex);
+            saturee = connexion.m_enCours >= REQUETES_MAX_EN_COURS || connexion.m_sortie.size() >= TAILLE_MAX_SORTIE;
+            if (saturee) break;
+            ++connexion.m_enCours;
+        }
+
+        std::string message = connexion.m_entree.substr(position + protocole::TAILLE_LONGUEUR, longueur);
+        position += protocole::TAILLE_LONGUEUR + longueur;
+        m_travailleurs->soumettre([this, p_connexion, message = std::move(message)]() {
+            std::string reponse;
+            traiterRequete(*m_bottin.lire(), message, reponse);
+            {
+                std::lock_guard<std::mutex> verrou(p_connexion->m_mutex);
+                --p_connexion->m_enCours;
+                if (p_connexion->m_fermee) return;
+                p_connexion->m_sortie += reponse;
+            }
+            {
+                std::lock_guard<std::mutex> verrou(m_mutexPretes);
+                m_connexionsPretes.push_back(p_connexion);
+            }
+            _reveiller();
+        });
+    }
+    connexion.m_entree.erase(0, position);
+    if (saturee && !connexion.m_lectureSuspendue) {
+        connexion.m_lectureSuspendue = true;
+        _modifierEvenements(connexion);
+    }
+}
+    /**
+     * \brief Écrit autant de réponses que le socket en accepte; demande EPOLLOUT s'il en reste.
+     * \details Si la lecture était suspendue et que la connexion n'est plus saturée, EPOLLIN est
+     * rétabli et les messages déjà reçus sont découpés sans attendre de nouveaux octets.
+     */
+void ServeurBottin::_ecrire(const std::shared_ptr<Connexion>& p_connexion) {
+    Connexion& connexion = *p_connexion;
+    bool resteAEcrire;
+    bool saturee;
+    {
+        std::lock_guard<std::mutex> verrou(connexion.m_mutex);
+        if (connexion.m_fermee) return;
+        size_t ecrits = 0;
+        while (ecrits < connexion.m_sortie.size()) {
+            const ssize_t n = send(connexion.m_fd, connexion.m_sortie.data() + ecrits,
+                                   connexion.m_sortie.size() - ecrits, MSG_NOSIGNAL);
+            if (n > 0) {
+                ecrits += static_cast<size_t>(n);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                break;
+            }
+        }
+        connexion.m_sortie.erase(0, ecrits);
+        resteAEcrire = !connexion.m_sortie.empty();
+        if (resteAEcrire && errno != EAGAIN && errno != EWOULDBLOCK) {
+            resteAEcrire = false;
+            connexion.m_sortie.clear();
+        }
+        saturee = connexion.m_enCours >= REQUETES_MAX_EN_COURS || connexion.m_sortie.size() >= TAILLE_MAX_SORTIE;
+    }
+    const bool reprendre = connexion.m_lectureSuspendue && !saturee;
+    if (resteAEcrire != connexion.m_attendEcriture || reprendre) {
+        connexion.m_attendEcriture = resteAEcrire;
+        if (reprendre) connexion.m_lectureSuspendue = false;
+        _modifierEvenements(connexion);
+    }
+    if (reprendre) {
+        _decouper(p_connexion);
+    }
+}
+    /**
+     * \brief Demande à epoll les événements voulus par l'état de la connexion.
+     */
+void ServeurBottin::_modifierEvenements(const Connexion& p_connexion) {
+    modifierEpoll(m_epoll, p_connexion.m_fd, (p_connexion.m_lectureSuspendue ? 0u : static_cast<uint32_t>(EPOLLIN))
+                                             | (p_connexion.m_attendEcriture ? static_cast<uint32_t>(EPOLLOUT) : 0u));
+}
+    /**
+     * \brief Ferme une connexion; les réponses encore en préparation seront ignorées.
+     */
+void ServeurBottin::_fermer(Connexion& p_connexion) {
+    {
+        std::lock_guard<std::mutex> verrou(p_connexion.m_mutex);
+        if (p_connexion.m_fermee) return;
+        p_connexion.m_fermee = true;
+        p_connexion.m_sortie.clear();
+    }
+    const int fd = p_connexion.m_fd;
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    m_connexions.erase(fd); // peut détruire p_connexion : ne plus y toucher
+}
+    /**
+     * \brief Écrit les réponses déposées par les travailleurs depuis le dernier réveil.
+     */
+void ServeurBottin::_ecrirePretes() {
+    std::vector<std::shared_ptr<Connexion> > pretes;
+    {
+        std::lock_guard<std::mutex> verrou(m_mutexPretes);
+        pretes.swap(m_connexionsPretes);
+    }
+    for (const std::shared_ptr<Connexion>& connexion : pretes) {
+        if (!connexion->m_attendEcriture) {
+            _ecrire(connexion);
+        }
+    }
+}
+    /**
+     * \brief Réveille le fil epoll.
+     */
+void ServeurBottin::_reveiller() noexcept {
+    const uint64_t un = 1;
+    [[maybe_unused]] ssize_t n = write(m_reveil, &un, sizeof(un));
+}
+
+} // namespace TP3
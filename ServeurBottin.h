@@ -0,0 +1,93 @@
+/**
+ * \file ServeurBottin.h
+ * \brief Serveur local de recherches dans un bottin.
+ *
+ * Le bottin est chargé une seule fois; les clients envoient leurs requêtes
+ * sur un socket Unix (voir ProtocoleBottin.h). Un fil unique surveille les
+ * sockets avec epoll, découpe les messages et les confie à un
+ * GroupeTravailleurs de taille fixe. Les travailleurs déposent les réponses
+ * dans le tampon de sortie de la connexion et réveillent le fil epoll par un
+ * eventfd; c'est lui seul qui écrit dans les sockets. Une connexion dont les
+ * réponses s'accumulent (client qui ne lit pas) cesse d'être lue jusqu'à ce
+ * que son tampon de sortie se vide. Chaque requête est
+ * traitée sur la version courante d'un BottinVersionne : le bottin peut être
+ * rechargé sans interrompre le service.
+ */
+#ifndef SERVEURBOTTIN_H
+#define SERVEURBOTTIN_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "BottinVersionne.h"
+#include "GroupeTravailleurs.h"
+
+namespace TP3 {
+
+/**
+ * \class ServeurBottin
+ * \brief Répond aux requêtes de recherche reçues sur un socket Unix.
+ *
+ * Les versions publiées ne doivent plus être modifiées (idéalement figées) :
+ * les travailleurs les consultent en parallèle sans verrou.
+ */
+class ServeurBottin {
+public:
+    ServeurBottin(const BottinVersionne& p_bottin, const std::string& p_chemin,
+                  size_t p_nbTravailleurs = std::thread::hardware_concurrency());
+    ~ServeurBottin();
+
+    ServeurBottin(const ServeurBottin&) = delete;
+    ServeurBottin& operator=(const ServeurBottin&) = delete;
+
+    void executer();
+    void arreter() noexcept;
+
+    static void traiterRequete(const Bottin& p_bottin, std::string_view p_message, std::string& p_reponse);
+
+private:
+    /**
+     * \brief État d'une connexion cliente.
+     */
+    struct Connexion {
+        int m_fd = -1;
+        std::string m_entree; /*!< Octets reçus pas encore découpés en messages (fil epoll seulement) */
+        bool m_attendEcriture = false; /*!< EPOLLOUT est demandé (fil epoll seulement) */
+        bool m_lectureSuspendue = false; /*!< EPOLLIN est retiré : trop de réponses en attente (fil epoll seulement) */
+        std::mutex m_mutex; /*!< Protège m_sortie, m_enCours et m_fermee */
+        std::string m_sortie; /*!< Réponses à écrire */
+        size_t m_enCours = 0; /*!< Requêtes confiées aux travailleurs dont la réponse n'est pas déposée */
+        bool m_fermee = false;
+    };
+
+    const BottinVersionne& m_bottin;
+    std::string m_chemin; /*!< Chemin du socket, supprimé à la destruction */
+    int m_ecoute; /*!< Socket d'écoute */
+    int m_epoll;
+    int m_reveil; /*!< eventfd : réponses prêtes ou arrêt demandé */
+    std::atomic<bool> m_arret;
+
+    std::unordered_map<int, std::shared_ptr<Connexion> > m_connexions; /*!< Fil epoll seulement */
+    std::mutex m_mutexPretes;
+    std::vector<std::shared_ptr<Connexion> > m_connexionsPretes; /*!< Connexions ayant de nouvelles réponses */
+
+    std::unique_ptr<GroupeTravailleurs> m_travailleurs; /*!< Détruit en premier : ses tâches en cours utilisent les autres membres */
+
+    void _accepter();
+    void _lire(const std::shared_ptr<Connexion>& p_connexion);
+    void _decouper(const std::shared_ptr<Connexion>& p_connexion);
+    void _ecrire(const std::shared_ptr<Connexion>& p_connexion);
+    void _modifierEvenements(const Connexion& p_connexion);
+    void _fermer(Connexion& p_connexion);
+    void _ecrirePretes();
+    void _reveiller() noexcept;
+};
+
+} // namespace TP3
+
+#endif // SERVEURBOTTIN_H
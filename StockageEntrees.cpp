@@ -0,0 +1,172 @@
+/**
+ * \file StockageEntrees.cpp
+ * \brief Implantation du stockage en colonnes des entrées du bottin.
+ */
+#include "StockageEntrees.h"
+#include "ContratException.h"
+
+namespace TP3 {
+
+    /**
+     * \brief Constructeur par défaut : un stockage vide.
+     */
+StockageEntrees::StockageEntrees()
+    : m_noms(), m_courriels(), m_debutsNoms(), m_longueursNoms(), m_longueursPrenoms(),
+      m_debutsCourriels(), m_longueursCourriels(), m_telephonesFixes(), m_cellulaires(),
+      m_octetsMorts(0) {
+}
+    /**
+     * \brief Ajoute une entrée à la fin du stockage.
+     * \param[in] p_nom Nom de la personne.
+     * \param[in] p_prenom Prénom de la personne.
+     * \param[in] p_telephoneFixe Téléphone fixe compacté.
+     * \param[in] p_cellulaire Cellulaire compacté.
+     * \param[in] p_courriel Adresse courriel.
+     * \pre Le nom n'est pas vide et aucun champ texte ne dépasse LONGUEUR_MAX.
+     * \return L'index de la nouvelle entrée.
+     */
+size_t StockageEntrees::ajouter(std::string_view p_nom, std::string_view p_prenom, uint64_t p_telephoneFixe,
+                                uint64_t p_cellulaire, std::string_view p_courriel) {
+    const size_t index = taille();
+    m_debutsNoms.push_back(0);
+    m_longueursNoms.push_back(0);
+    m_longueursPrenoms.push_back(0);
+    m_debutsCourriels.push_back(0);
+    m_longueursCourriels.push_back(0);
+    m_telephonesFixes.push_back(p_telephoneFixe);
+    m_cellulaires.push_back(p_cellulaire);
+    _ecrireTexte(index, p_nom, p_prenom, p_courriel);
+    return index;
+}
+    /**
+     * \brief Remplace le contenu d'une position, active ou libre.
+     * \details L'ancien texte devient de l'espace mort; le nouveau est ajouté à la fin des bassins.
+     * \param[in] p_index Index de la position.
+     * \pre L'index est inférieur à taille(), le nom n'est pas vide et aucun champ texte ne dépasse LONGUEUR_MAX.
+     * \post Les vues retournées auparavant ne sont plus valides.
+     */
+void StockageEntrees::remplacer(size_t p_index, std::string_view p_nom, std::string_view p_prenom,
+                                uint64_t p_telephoneFixe, uint64_t p_cellulaire, std::string_view p_courriel) {
+    PRECONDITION(p_index < taille());
+
+    _oublierTexte(p_index);
+    m_telephonesFixes[p_index] = p_telephoneFixe;
+    m_cellulaires[p_index] = p_cellulaire;
+    _ecrireTexte(p_index, p_nom, p_prenom, p_courriel);
+    _compacterSiNecessaire();
+}
+    /**
+     * \brief Libère une position; son index reste réservé et peut être réutilisé par remplacer().
+     * \param[in] p_index Index de la position.
+     * \pre La position contient une entrée.
+     * \post estActive(p_index) est faux.
+     */
+void StockageEntrees::liberer(size_t p_index) {
+    PRECONDITION(p_index < taille() && estActive(p_index));
+
+    _oublierTexte(p_index);
+    m_telephonesFixes[p_index] = 0;
+    m_cellulaires[p_index] = 0;
+    _compacterSiNecessaire();
+
+    POSTCONDITION(!estActive(p_index));
+}
+    /**
+     * \brief Retourne le nombre de positions, actives ou libres.
+     * \return Le nombre de positions.
+     */
+size_t StockageEntrees::taille() const {
+    return m_longueursNoms.size();
+}
+    /**
+     * \brief Retourne la mémoire occupée par le stockage, en octets.
+     * \return La capacité réservée des bassins et des colonnes.
+     */
+size_t StockageEntrees::memoire() const {
+    return sizeof(*this) + m_noms.capacity() + m_courriels.capacity()
+           + (m_debutsNoms.capacity() + m_debutsCourriels.capacity()) * sizeof(uint32_t)
+           + (m_longueursNoms.capacity() + m_longueursPrenoms.capacity() + m_longueursCourriels.capacity()) * sizeof(uint16_t)
+           + (m_telephonesFixes.capacity() + m_cellulaires.capacity()) * sizeof(uint64_t);
+}
+    /**
+     * \brief Remet un téléphone compacté au format (ddd) ddd-dddd.
+     * \param[in] p_telephone L'entier retourné par compacterTelephone().
+     * \return Le numéro formaté; ses 14 caractères tiennent dans le tampon interne de std::string.
+     */
+std::string StockageEntrees::formaterTelephone(uint64_t p_telephone) {
+    std::string texte(LONGUEUR_TELEPHONE, ' ');
+    formaterTelephone(p_telephone, texte.data());
+    return texte;
+}
+    /**
+     * \brief Écrit un numéro compacté au format (ddd) ddd-dddd, sans allocation.
+     * \param[in] p_telephone L'entier formé des dix chiffres.
+     * \param[out] p_destination Zone d'au moins LONGUEUR_TELEPHONE caractères; aucun zéro final n'est écrit.
+     */
+void StockageEntrees::formaterTelephone(uint64_t p_telephone, char* p_destination) {
+    for (size_t i = LONGUEUR_TELEPHONE; i-- > 0;) {
+        if (GABARIT_TELEPHONE[i] == 'd') {
+            p_destination[i] = static_cast<char>('0' + p_telephone % 10);
+            p_telephone /= 10;
+        } else {
+            p_destination[i] = GABARIT_TELEPHONE[i];
+        }
+    }
+}
+    /**
+     * \brief Copie le texte d'une entrée à la fin des bassins et met à jour ses positions.
+     */
+void StockageEntrees::_ecrireTexte(size_t p_index, std::string_view p_nom, std::string_view p_prenom,
+                                   std::string_view p_courriel) {
+    PRECONDITION(!p_nom.empty());
+    PRECONDITION(p_nom.size() <= LONGUEUR_MAX && p_prenom.size() <= LONGUEUR_MAX && p_courriel.size() <= LONGUEUR_MAX);
+    PRECONDITION(m_noms.size() + p_nom.size() + p_prenom.size() <= UINT32_MAX);
+    PRECONDITION(m_courriels.size() + p_courriel.size() <= UINT32_MAX);
+
+    m_debutsNoms[p_index] = static_cast<uint32_t>(m_noms.size());
+    m_longueursNoms[p_index] = static_cast<uint16_t>(p_nom.size());
+    m_longueursPrenoms[p_index] = static_cast<uint16_t>(p_prenom.size());
+    m_noms.append(p_nom);
+    m_noms.append(p_prenom);
+
+    m_debutsCourriels[p_index] = static_cast<uint32_t>(m_courriels.size());
+    m_longueursCourriels[p_index] = static_cast<uint16_t>(p_courriel.size());
+    m_courriels.append(p_courriel);
+}
+    /**
+     * \brief Compte le texte d'une entrée comme espace mort et vide ses longueurs.
+     */
+void StockageEntrees::_oublierTexte(size_t p_index) {
+    m_octetsMorts += m_longueursNoms[p_index] + m_longueursPrenoms[p_index] + m_longueursCourriels[p_index];
+    m_debutsNoms[p_index] = 0;
+    m_longueursNoms[p_index] = 0;
+    m_longueursPrenoms[p_index] = 0;
+    m_debutsCourriels[p_index] = 0;
+    m_longueursCourriels[p_index] = 0;
+}
+    /**
+     * \brief Réécrit les bassins dans l'ordre des index lorsque l'espace mort dépasse la moitié.
+     * \details Les index ne changent pas : seuls les débuts sont recalculés.
+     */
+void StockageEntrees::_compacterSiNecessaire() {
+    if (m_octetsMorts * 2 <= m_noms.size() + m_courriels.size()) {
+        return;
+    }
+    std::string noms;
+    std::string courriels;
+    noms.reserve(m_noms.size());
+    courriels.reserve(m_courriels.size());
+    for (size_t i = 0; i < taille(); ++i) {
+        const std::string_view texteNoms(m_noms.data() + m_debutsNoms[i], m_longueursNoms[i] + m_longueursPrenoms[i]);
+        m_debutsNoms[i] = static_cast<uint32_t>(noms.size());
+        noms.append(texteNoms);
+        const std::string_view texteCourriel = courriel(i);
+        m_debutsCourriels[i] = static_cast<uint32_t>(courriels.size());
+        courriels.append(texteCourriel);
+    }
+    m_noms.swap(noms);
+    m_courriels.swap(courriels);
+    m_octetsMorts = 0;
+}
+
+} // namespace TP3
@@ -0,0 +1,123 @@
+/**
+ * \file StockageEntrees.h
+ * \brief Stockage en colonnes des entrées du bottin.
+ *
+ * Les noms et prénoms sont rangés bout à bout dans un même bassin de
+ * caractères, les courriels dans un autre; chaque entrée n'y garde qu'une
+ * position de début et des longueurs. Les numéros de téléphone, de format
+ * fixe, sont compactés en entiers. Une entrée coûte ainsi une trentaine
+ * d'octets plus son texte, sans allocation par champ, et un parcours
+ * séquentiel lit des tableaux contigus.
+ */
+#ifndef STOCKAGEENTREES_H
+#define STOCKAGEENTREES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ValidateurEntree.h"
+
+namespace TP3 {
+
+/**
+ * \class StockageEntrees
+ * \brief Tableau d'entrées stockées par colonnes, adressées par leur index.
+ *
+ * Une position libérée garde son index (les index des autres entrées ne
+ * changent jamais); son texte devient de l'espace mort, récupéré par un
+ * compactage lorsqu'il dépasse la moitié des bassins. Les vues retournées
+ * restent valides jusqu'à la prochaine modification du stockage.
+ */
+class StockageEntrees {
+public:
+    StockageEntrees();
+
+    size_t ajouter(std::string_view p_nom, std::string_view p_prenom, uint64_t p_telephoneFixe,
+                   uint64_t p_cellulaire, std::string_view p_courriel);
+    void remplacer(size_t p_index, std::string_view p_nom, std::string_view p_prenom,
+                   uint64_t p_telephoneFixe, uint64_t p_cellulaire, std::string_view p_courriel);
+    void liberer(size_t p_index);
+
+    /**
+     * \brief Retourne le nom d'une entrée.
+     * \param[in] p_index Index de l'entrée.
+     * \return Une vue sur le nom, vide si la position est libre.
+     */
+    std::string_view nom(size_t p_index) const {
+        return std::string_view(m_noms.data() + m_debutsNoms[p_index], m_longueursNoms[p_index]);
+    }
+    /**
+     * \brief Retourne le prénom d'une entrée; il suit le nom dans le bassin.
+     * \param[in] p_index Index de l'entrée.
+     * \return Une vue sur le prénom, vide si la position est libre.
+     */
+    std::string_view prenom(size_t p_index) const {
+        return std::string_view(m_noms.data() + m_debutsNoms[p_index] + m_longueursNoms[p_index],
+                                m_longueursPrenoms[p_index]);
+    }
+    /**
+     * \brief Retourne le courriel d'une entrée.
+     * \param[in] p_index Index de l'entrée.
+     * \return Une vue sur le courriel, vide si la position est libre.
+     */
+    std::string_view courriel(size_t p_index) const {
+        return std::string_view(m_courriels.data() + m_debutsCourriels[p_index], m_longueursCourriels[p_index]);
+    }
+    /**
+     * \brief Retourne le téléphone fixe compacté d'une entrée.
+     */
+    uint64_t telephoneFixe(size_t p_index) const { return m_telephonesFixes[p_index]; }
+    /**
+     * \brief Retourne le cellulaire compacté d'une entrée.
+     */
+    uint64_t cellulaire(size_t p_index) const { return m_cellulaires[p_index]; }
+    /**
+     * \brief Indique si une position contient une entrée (un nom n'est jamais vide).
+     */
+    bool estActive(size_t p_index) const { return m_longueursNoms[p_index] != 0; }
+
+    size_t taille() const;
+    size_t memoire() const;
+
+    /**
+     * \brief Compacte un numéro au format (ddd) ddd-dddd en l'entier formé de ses dix chiffres.
+     * \param[in] p_telephone Un numéro valide selon estTelephoneValide().
+     * \return L'entier correspondant, inférieur à 10^10.
+     */
+    static constexpr uint64_t compacterTelephone(std::string_view p_telephone) noexcept {
+        uint64_t valeur = 0;
+        for (size_t i = 0; i < LONGUEUR_TELEPHONE; ++i) {
+            if (GABARIT_TELEPHONE[i] == 'd') {
+                valeur = valeur * 10 + static_cast<uint64_t>(p_telephone[i] - '0');
+            }
+        }
+        return valeur;
+    }
+    static std::string formaterTelephone(uint64_t p_telephone);
+    static void formaterTelephone(uint64_t p_telephone, char* p_destination);
+
+    static constexpr size_t LONGUEUR_MAX = 0xFFFF; /*!< Longueur maximale d'un champ texte */
+
+private:
+    std::string m_noms; /*!< Bassin des noms, chacun suivi de son prénom */
+    std::string m_courriels; /*!< Bassin des courriels */
+    std::vector<uint32_t> m_debutsNoms; /*!< Début du nom de chaque entrée dans m_noms */
+    std::vector<uint16_t> m_longueursNoms; /*!< Longueur du nom, 0 si la position est libre */
+    std::vector<uint16_t> m_longueursPrenoms; /*!< Longueur du prénom */
+    std::vector<uint32_t> m_debutsCourriels; /*!< Début du courriel de chaque entrée dans m_courriels */
+    std::vector<uint16_t> m_longueursCourriels; /*!< Longueur du courriel */
+    std::vector<uint64_t> m_telephonesFixes; /*!< Téléphones fixes compactés */
+    std::vector<uint64_t> m_cellulaires; /*!< Cellulaires compactés */
+    size_t m_octetsMorts; /*!< Octets des bassins qui n'appartiennent plus à aucune entrée */
+
+    void _ecrireTexte(size_t p_index, std::string_view p_nom, std::string_view p_prenom,
+                      std::string_view p_courriel);
+    void _oublierTexte(size_t p_index);
+    void _compacterSiNecessaire();
+};
+
+} // namespace TP3
+
+#endif // STOCKAGEENTREES_H
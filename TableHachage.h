@@ -7,13 +7,27 @@
  *
  *	Résolution des collisions par redistribution quadratique.
  *
+ *	Avec un GroupeTravailleurs (asgTravailleurs), le rehachage des grandes
+ *	tables est réparti entre les fils : chacun parcourt des blocs de l'ancien
+ *	tableau et réserve ses cases dans le nouveau par échange atomique de l'état.
+ *
+ *	Avec un foncteur à graine (HSipString, HSipInt64), une insertion qui subit
+ *	trop de collisions fait tirer une nouvelle graine et rehacher la table.
+ *
  */
 
 #ifndef TABLEHACHAGE_H_
 #define TABLEHACHAGE_H_
 
+#include <memory>
 #include <vector>
 #include <ostream>
+#include "DispersionQuadratique.h"
+
+namespace TP3
+{
+class GroupeTravailleurs;
+}
 
 namespace labTableHachage
 {
@@ -29,8 +43,11 @@ namespace labTableHachage
  * TypeClef : le type des clefs
  * TypeElement : le type des éléments dans la table
  * FoncteurHachage: foncteur de hachage
+ * Allocateur : allocateur du tableau des cases, relié au type des cases
+ *              (AllocateurPagesGeantes<char> pour les très grandes tables)
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+template<typename TypeClef, typename TypeElement, class FoncteurHachage,
+         class Allocateur = std::allocator<char> >
 class TableHachage
 {
 public:
@@ -38,21 +55,30 @@ public:
     TableHachage(size_t = 100);
 
     void inserer(const TypeClef &, const TypeElement &);
+    bool insererSiAbsent(const TypeClef &, const TypeElement &);
     void enlever(const TypeClef &);
 
     bool contient(const TypeClef &) const;
     TypeElement element(const TypeClef &) const;
 
     void rehacher();
+    void reserver(size_t);
     void vider();
-    int taille() const;
+    size_t taille() const;
+
+    void asgTravailleurs(TP3::GroupeTravailleurs *);
+    const FoncteurHachage & reqHachage() const;
+    size_t nombreRegenerationsGraine() const;
 
-    void statistiques(double& p_ratio, int& p_nbCollisions, int& p_maximumCollisionUneInsertion) const;
+    void statistiques(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const;
+
+    template<typename Fonction>
+    void parcourir(Fonction) const;
 
     void afficher(std::ostream &) const;
-    template<typename TClef, typename TElement, class FHachage>
+    template<typename TClef, typename TElement, class FHachage, class Alloc>
     friend std::ostream& operator<<(std::ostream &,
-            const TableHachage<TClef, TElement, FHachage> &);
+            const TableHachage<TClef, TElement, FHachage, Alloc> &);
 
 private:
 
@@ -75,7 +101,7 @@ private:
     {
     public:
         TypeClef m_clef; /*!< la clé de hachage*/
-        TypeElement m_el; /*!< la valeur associée à la clé*/
+        [[no_unique_address]] TypeElement m_el; /*!< la valeur associée à la clé; n'occupe rien si TypeElement est vide */
         EtatEntree m_info; /*!< tag pour préciser l'état de l'entrée */
 
         /**
@@ -105,29 +131,31 @@ private:
             return p_out;
         }
     };
-    std::vector<EntreeHachage> m_tab; /*!< La table de hachage */
+    typedef typename std::allocator_traits<Allocateur>::template rebind_alloc<EntreeHachage> AllocateurEntrees;
+
+    std::vector<EntreeHachage, AllocateurEntrees> m_tab; /*!< La table de hachage */
     size_t m_cardinalite; /*!< Le nombre d'éléments actifs dans la table */
-    static const int TAUX_MAX = 50; /*!< Taux de remplissage maximum dans la table */
+    size_t m_nbEffaces = 0; /*!< Le nombre d'entrées EFFACE, comptées dans le taux de remplissage */
     FoncteurHachage m_hachage; /*!< Foncteur de hachage */
 
-    unsigned long m_nInsertions = 0; /*!< Nombre d'insertions au total*/
-    unsigned long m_nCollisions = 0; /*!< Le nombre de collisions au total*/
-    unsigned long m_maximumCollisionUneInsertion = 0; /*!< Le nombre maximal de collisions au pour une insertion*/
+    StatistiquesCollisions m_statistiques; /*!< Collisions des insertions depuis le dernier rehachage */
 
-    // Méthodes privées
+    TP3::GroupeTravailleurs * m_travailleurs = nullptr; /*!< Fils du rehachage parallèle, ou nullptr */
 
-    int _prochainPremier(int) const;
-    bool _estPremier(int) const;
+    size_t m_nRegenerationsGraine = 0; /*!< Nombre de graines tirées depuis la construction */
+    bool m_rehachageEnCours = false; /*!< Vrai pendant les réinsertions d'un rehachage */
+
+    // Méthodes privées
 
-    size_t _trouverPositionLibre(const TypeClef &);
+    size_t _trouverPositionLibre(const TypeClef &, size_t &);
+    void _occuper(size_t, const TypeClef &, const TypeElement &, size_t);
     size_t _trouverPositionClef(const TypeClef &) const;
-    size_t _distribution(const TypeClef &) const;
     bool _estVacante(size_t) const;
     bool _estEffacee(size_t) const;
     bool _estOccupee(size_t) const;
     bool _clefExiste(const size_t &, const TypeClef &) const;
-    bool _doitEtreRehachee() const;
-    void _redimensionner();
+    void _rehacher(size_t);
+    void _rehacherEnParallele(size_t);
     void _reqEntreesActives(std::vector<EntreeHachage> &) const;
 
     
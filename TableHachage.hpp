@@ -6,8 +6,12 @@
  * \version 0.3
  *
  */
-#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include "ContratException.h"
+#include "GroupeTravailleurs.h"
+#include "Instrumentation.h"
 
 /**
  * \namespace labTableHachage
@@ -23,9 +27,9 @@ namespace labTableHachage
  *
  * \pre Il faut qu'il y ait suffisamment de mémoire
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-TableHachage<TypeClef, TypeElement, FoncteurHachage>::TableHachage(size_t size) :
-m_tab(_prochainPremier(size)), m_cardinalite(0), m_nInsertions(0), m_nCollisions(0)
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::TableHachage(size_t size) :
+m_tab(dispersion::prochainPremier(size)), m_cardinalite(0)
 {
     vider();
 }
@@ -36,31 +40,97 @@ m_tab(_prochainPremier(size)), m_cardinalite(0), m_nInsertions(0), m_nCollisions
  * Une redispersion quadratique sera utilisée en cas de collision
  *
  * Si, après une insertion, le taux de remplissage atteint le maximum, on double la taille
- * de la table et on prend le nombre premier suivant.
+ * de la table et on prend le nombre premier suivant. Si l'insertion a subi plus de
+ * dispersion::SEUIL_COLLISIONS_GRAINE collisions et que le foncteur a une graine (regenererGraine()),
+ * une nouvelle graine est tirée et la table est rehachée : des clefs fabriquées pour
+ * collisionner sous l'ancienne graine sont dispersées par la nouvelle.
  * @param p_clef
  * @param p_el valeur
  * \pre Il faut qu'il y ait assez de mémoire
  * \pre La clef à insérer n'est pas déjà présente dans la table
  * \post La clef est ajoutée avec sa valeur
  */
-    template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-    void TableHachage<TypeClef, TypeElement, FoncteurHachage>::inserer(const TypeClef& p_clef, const TypeElement& p_el) {
-    PRECONDITION(!contient(p_clef));
+    template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+    void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::inserer(const TypeClef& p_clef, const TypeElement& p_el) {
+    PRECONDITION_AUDIT(!contient(p_clef));
 
-    size_t position = _trouverPositionLibre(p_clef);
+    size_t nbCollisions = 0;
+    size_t position = _trouverPositionLibre(p_clef, nbCollisions);
+    _occuper(position, p_clef, p_el, nbCollisions);
+}
 
-    ASSERTION(_estVacante(position) || _estEffacee(position));
+/**
+ * \brief Insérer une paire (clef, valeur) si la clef n'est pas déjà dans la table
+ *
+ * Un seul sondage cherche la clef et retient la première position libre
+ * rencontrée; il s'arrête à une position vacante ou sur la clef. L'insertion
+ * suit ensuite les mêmes règles que inserer() (statistiques, graine, rehachage).
+ *
+ * @param p_clef
+ * @param p_el valeur
+ * \return Vrai si la paire a été insérée, faux si la clef était déjà présente
+ * \post La clef est dans la table; sa valeur est inchangée si elle y était déjà
+ */
+    template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+    bool TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::insererSiAbsent(const TypeClef& p_clef,
+                                                                                          const TypeElement& p_el) {
+    dispersion::Sondage sondage(m_hachage(p_clef), m_tab.size());
+    size_t libre = m_tab.size();
+    size_t nbCollisions = 0;
+
+    while (!_estVacante(sondage.position())) {
+        if (_estOccupee(sondage.position())) {
+            if (_clefExiste(sondage.position(), p_clef)) {
+                return false;
+            }
+        } else if (libre == m_tab.size()) {
+            libre = sondage.position();
+            nbCollisions = sondage.collisions();
+        }
+        sondage.suivant();
+    }
+    if (libre == m_tab.size()) {
+        libre = sondage.position();
+        nbCollisions = sondage.collisions();
+    }
 
-    m_tab[position] = EntreeHachage(p_clef, p_el, OCCUPE);
-    m_cardinalite++;
-    m_nInsertions++; // Compter l'insertion
+    _occuper(libre, p_clef, p_el, nbCollisions);
+    return true;
+}
 
-    POSTCONDITION(m_tab[position].m_clef == p_clef);
-    POSTCONDITION(m_tab[position].m_el == p_el);
-    POSTCONDITION(m_tab[position].m_info == OCCUPE);
+/**
+ * \brief Placer une paire à une position libre, la compter, puis rehacher au besoin
+ *
+ * \param[in] p_position Une position vacante ou effacée
+ * \param[in] p_clef La clef
+ * \param[in] p_el La valeur
+ * \param[in] p_nbCollisions Le nombre de collisions subies pour trouver p_position
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_occuper(size_t p_position, const TypeClef & p_clef,
+                                                                               const TypeElement & p_el, size_t p_nbCollisions)
+{
+    ASSERTION(_estVacante(p_position) || _estEffacee(p_position));
 
-    if (_doitEtreRehachee()) {
-        rehacher();
+    if (_estEffacee(p_position)) {
+        --m_nbEffaces;
+    }
+    m_tab[p_position] = EntreeHachage(p_clef, p_el, OCCUPE);
+    m_cardinalite++;
+    m_statistiques.compter(p_nbCollisions);
+
+    POSTCONDITION(m_tab[p_position].m_clef == p_clef);
+    POSTCONDITION(m_tab[p_position].m_el == p_el);
+    POSTCONDITION(m_tab[p_position].m_info == OCCUPE);
+
+    const bool doitEtreRehachee = dispersion::doitEtreRehachee(m_tab.size(), m_cardinalite, m_nbEffaces);
+    if (p_nbCollisions > dispersion::SEUIL_COLLISIONS_GRAINE && !m_rehachageEnCours
+        && dispersion::regenererGraine(m_hachage)) {
+        ++m_nRegenerationsGraine;
+        _rehacher(doitEtreRehachee ? dispersion::tailleRehachage(m_tab.size(), m_cardinalite, m_nbEffaces)
+                                   : m_tab.size());
+    } else if (doitEtreRehachee) {
+        _rehacher(dispersion::tailleRehachage(m_tab.size(), m_cardinalite, m_nbEffaces));
     }
 }
 /**
@@ -73,31 +143,22 @@ m_tab(_prochainPremier(size)), m_cardinalite(0), m_nInsertions(0), m_nCollisions
  * lorsqu'une position contenant la clef (qui devrait être effacé dans ce cas) est trouvée.
  *
  * \param[in] p_clef La clef laquelle il faut trouver une position libre
+ * \param[out] p_nbCollisions Le nombre de collisions subies
  * \return La position libre de la clef
  *
  */
-    template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-    size_t TableHachage<TypeClef, TypeElement, FoncteurHachage>::_trouverPositionLibre(const TypeClef& p_clef) {
-    size_t valeurHachee = _distribution(p_clef);
-    size_t position = valeurHachee;
-    long i = 0;
-    int nbCollisionsPourInsertion = 0; // Compteur local pour cette insertion
-
-    while (!_estVacante(position) && !_estEffacee(position)) {
-        position = (valeurHachee + (long) pow(i, 2)) % m_tab.size();
-        ++i;
-        ++nbCollisionsPourInsertion; // Incrémenter le compteur local
+    template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+    size_t TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_trouverPositionLibre(const TypeClef& p_clef,
+                                                                                                   size_t& p_nbCollisions) {
+    dispersion::Sondage sondage(m_hachage(p_clef), m_tab.size());
+    while (!_estVacante(sondage.position()) && !_estEffacee(sondage.position())) {
+        sondage.suivant();
     }
 
-    ASSERTION(_estVacante(position) || _estEffacee(position));
+    ASSERTION(_estVacante(sondage.position()) || _estEffacee(sondage.position()));
 
-    // Mettre à jour les statistiques globales
-    m_nCollisions += nbCollisionsPourInsertion;
-    if (nbCollisionsPourInsertion > m_maximumCollisionUneInsertion) {
-        m_maximumCollisionUneInsertion = nbCollisionsPourInsertion;
-    }
-
-    return position;
+    p_nbCollisions = sondage.collisions();
+    return sondage.position();
 }
 
 /**
@@ -108,8 +169,8 @@ m_tab(_prochainPremier(size)), m_cardinalite(0), m_nInsertions(0), m_nCollisions
  * \post La table est inchangée.
  *
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::contient(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+bool TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::contient(
                                                                     const TypeClef & p_clef) const
 {
     size_t position = _trouverPositionClef(p_clef);
@@ -125,8 +186,8 @@ bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::contient(
  * \post La table est inchangée
  *
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-TypeElement TableHachage<TypeClef, TypeElement, FoncteurHachage>::element(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+TypeElement TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::element(
                                                                           const TypeClef & p_clef) const
 {
     size_t position = _trouverPositionClef(p_clef);
@@ -142,35 +203,86 @@ TypeElement TableHachage<TypeClef, TypeElement, FoncteurHachage>::element(
  * \post La table est inchangée
  * \return Le nombre d'éléments dans la table
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-int TableHachage<TypeClef, TypeElement, FoncteurHachage>::taille() const
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+size_t TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::taille() const
 {
     return m_cardinalite;
 }
 
+/**
+ * \brief Assigner les travailleurs qui rehachent les grandes tables
+ *
+ * \param[in] p_travailleurs Le groupe, qui doit survivre à la table, ou nullptr
+ *            pour rehacher dans l'appelant
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::asgTravailleurs(
+                                                                   TP3::GroupeTravailleurs * p_travailleurs)
+{
+    m_travailleurs = p_travailleurs;
+}
+
+/**
+ * \brief Retourner le foncteur de hachage, avec sa graine courante
+ * \post La table est inchangée
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+const FoncteurHachage & TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::reqHachage() const
+{
+    return m_hachage;
+}
+
+/**
+ * \brief Retourner le nombre de graines tirées après une insertion trop longue
+ * \post La table est inchangée
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+size_t TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::nombreRegenerationsGraine() const
+{
+    return m_nRegenerationsGraine;
+}
+
 /**
  * \brief Calcule les statistiques du nombre moyen de collisions par insertion.
  * \pre L'objet doit avoir ajouter au moins un élément
  * \return Le nombre de collisions moyen par insertion : le nombre de collisions / le nombre d'insertions
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
 
-void TableHachage<TypeClef, TypeElement, FoncteurHachage>::statistiques(double& p_ratio, int& p_nbCollisions, int& p_maximumCollisionUneInsertion) const
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::statistiques(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const
 {
-    PRECONDITION(m_nInsertions > 0);
-    p_ratio = (double) (m_nCollisions) / (double) (m_nInsertions);
-    p_nbCollisions = m_nCollisions;
-    p_maximumCollisionUneInsertion = m_maximumCollisionUneInsertion;
+    m_statistiques.statistiques(p_ratio, p_nbCollisions, p_maximumCollisionUneInsertion);
 }
 
 
+/**
+ * \brief Appliquer une fonction à chaque paire (clef, valeur) de la table
+ *
+ * L'ordre de visite est celui des positions dans la table.
+ *
+ * \param[in] p_fonction Fonction appelée avec (const TypeClef &, const TypeElement &)
+ * \post La table est inchangée
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+template<typename Fonction>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::parcourir(Fonction p_fonction) const
+{
+    for (size_t i = 0; i < m_tab.size(); ++i)
+    {
+        if (m_tab[i].m_info == OCCUPE)
+        {
+            p_fonction(m_tab[i].m_clef, m_tab[i].m_el);
+        }
+    }
+}
+
 /**
  * \brief Afficher la table
  * \post La table est inchangée
  * \param[out] p_out Le ostream vers lequel afficher
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-void TableHachage<TypeClef, TypeElement, FoncteurHachage>::afficher(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::afficher(
                                                                     std::ostream & p_out) const
 {
     p_out << "{";
@@ -188,27 +300,17 @@ void TableHachage<TypeClef, TypeElement, FoncteurHachage>::afficher(
  * \brief Vider la table de dispersion
  * \post La table est vide
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-void TableHachage<TypeClef, TypeElement, FoncteurHachage>::vider()
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::vider()
 {
     m_cardinalite = 0;
+    m_nbEffaces = 0;
     for (size_t i = 0; i < m_tab.size(); ++i)
     {
         m_tab[i].m_info = VACANT;
     }
 }
 
-/**
- * \brief Déterminer si la table doit être rehacher
- * \return Bool indiquant si la table doit être rehacher
- * \post La table est inchangée
- */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_doitEtreRehachee() const
-{
-    return ((m_cardinalite * 100) >= (TAUX_MAX * m_tab.size()));
-}
-
 /**
  * \brief Supprimer un élément de la table.
  *
@@ -218,12 +320,12 @@ bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_doitEtreRehachee() c
  * \param[in] p_clef La clef à supprimer
  * \post La table comprend un élément de moins
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-void TableHachage<TypeClef, TypeElement, FoncteurHachage>::enlever(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::enlever(
                                                                    const TypeClef & p_clef)
 {
 
-    PRECONDITION(contient(p_clef));
+    PRECONDITION_AUDIT(contient(p_clef));
 
     size_t position = _trouverPositionClef(p_clef);
 
@@ -232,8 +334,9 @@ void TableHachage<TypeClef, TypeElement, FoncteurHachage>::enlever(
 
     m_tab[position].m_info = EFFACE;
     --m_cardinalite;
+    ++m_nbEffaces;
 
-    POSTCONDITION(!contient(p_clef));
+    POSTCONDITION_AUDIT(!contient(p_clef));
 }
 
 /**
@@ -248,35 +351,17 @@ void TableHachage<TypeClef, TypeElement, FoncteurHachage>::enlever(
  * \return La position trouvée
  * \post La table est inchangée
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-size_t TableHachage<TypeClef, TypeElement, FoncteurHachage>::_trouverPositionClef(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+size_t TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_trouverPositionClef(
                                                                                   const TypeClef & p_clef) const
 {
-    size_t valeurHachee = _distribution(p_clef);
-    size_t position = valeurHachee;
-    long i(0);
-
-    while (!_estVacante(position) && !_clefExiste(position, p_clef))
+    MESURER_PHASE_ECHANTILLONNEE(Phase::TABLE_SONDAGE);
+    dispersion::Sondage sondage(m_hachage(p_clef), m_tab.size());
+    while (!_estVacante(sondage.position()) && !_clefExiste(sondage.position(), p_clef))
     {
-        position = (valeurHachee + (long) pow(i, 2)) % m_tab.size();
-        i++;
+        sondage.suivant();
     }
-    return position;
-}
-
-/**
- * \brief Application du foncteur de hachage sur une clef,
- * modulo la taille de la table
- *
- * \param[in] p_clef La clef à hacher
- * \post La table est inchangée
- * \return La position de la clef
- */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-size_t TableHachage<TypeClef, TypeElement, FoncteurHachage>::_distribution(
-                                                                           const TypeClef & p_clef) const
-{
-    return m_hachage(p_clef) % m_tab.size();
+    return sondage.position();
 }
 
 /**
@@ -284,8 +369,8 @@ size_t TableHachage<TypeClef, TypeElement, FoncteurHachage>::_distribution(
  * \return Bool indiquant si une position est vacante
  * \post La table est inchangée
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_estVacante(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+bool TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_estVacante(
                                                                        size_t p_position) const
 {
     return m_tab[p_position].m_info == VACANT;
@@ -296,8 +381,8 @@ bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_estVacante(
  * \return Bool indiquant si une position est effacée
  * \post La table est inchangée
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_estEffacee(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+bool TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_estEffacee(
                                                                        size_t p_position) const
 {
     return m_tab[p_position].m_info == EFFACE;
@@ -308,8 +393,8 @@ bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_estEffacee(
  * \return Bool indiquant si une position est occupée
  * \post La table est inchangée
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_estOccupee(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+bool TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_estOccupee(
                                                                        size_t currentPos) const
 {
     return m_tab[currentPos].m_info == OCCUPE;
@@ -320,8 +405,8 @@ bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_estOccupee(
  * \return Bool indiquant si la clef est à la position choisie
  * \post La table est inchangée
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_clefExiste(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+bool TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_clefExiste(
                                                                        const size_t & p_position, const TypeClef & p_clef) const
 {
     return m_tab[p_position].m_clef == p_clef;
@@ -334,40 +419,123 @@ bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_clefExiste(
  * est dépassé.
  *
  * La taille est doublée et le premier nombre premier suivant
- * ce nombre est choisie comme nouvelle taille.
+ * ce nombre est choisie comme nouvelle taille. Les tables d'au moins
+ * SEUIL_REHACHAGE_PARALLELE éléments sont rehachées en parallèle si un
+ * groupe de travailleurs leur a été assigné.
  *
  * \post La table est rehachée avec la nouvelle taille
  *
  */
-    template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-    void TableHachage<TypeClef, TypeElement, FoncteurHachage>::rehacher() {
-    // Réinitialiser les compteurs
-    m_nInsertions = 0;
-    m_nCollisions = 0;
-    m_maximumCollisionUneInsertion = 0;
+    template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+    void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::rehacher() {
+    _rehacher(dispersion::prochainPremier(2 * m_tab.size()));
+}
+
+/**
+ * \brief Agrandir la table d'avance pour un certain nombre d'insertions
+ *
+ * Après l'appel, p_nombre insertions de clefs nouvelles ne provoquent aucun
+ * rehachage. La table n'est jamais réduite.
+ *
+ * \param[in] p_nombre Le nombre d'insertions prévues
+ * \post La table est inchangée, sauf la taille de son tableau de cases
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::reserver(size_t p_nombre)
+{
+    const size_t necessaire = (m_cardinalite + p_nombre) / dispersion::TAUX_MAX * 100 + 100;
+    if (necessaire > m_tab.size())
+    {
+        _rehacher(dispersion::prochainPremier(necessaire));
+    }
+}
+
+/**
+ * \brief Replacer les éléments dans un tableau de p_taille cases
+ *
+ * \param[in] p_taille La nouvelle taille, un nombre premier
+ * \post La table est rehachée avec la nouvelle taille
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_rehacher(size_t p_taille)
+{
+    MESURER_PHASE(Phase::TABLE_REHACHAGE);
+    if (m_travailleurs != nullptr && m_cardinalite >= dispersion::SEUIL_REHACHAGE_PARALLELE) {
+        _rehacherEnParallele(p_taille);
+        return;
+    }
+    m_statistiques.reinitialiser();
 
     std::vector<EntreeHachage> entreesActives;
     _reqEntreesActives(entreesActives);
 
-    _redimensionner();
+    m_tab.resize(p_taille);
     vider();
 
+    // Les réinsertions ne tirent pas de nouvelle graine : une seule par rehachage
+    m_rehachageEnCours = true;
     for (size_t i = 0; i < entreesActives.size(); ++i) {
         inserer(entreesActives[i].m_clef, entreesActives[i].m_el);
     }
+    m_rehachageEnCours = false;
 }
+
 /**
- * \brief Redimensionner la taille de la table de dispersion.
+ * \brief Rehacher la table en répartissant l'ancien tableau entre les travailleurs
  *
- * La taille est doublée et le premier nombre premier suivant
- * ce nombre est choisie comme nouvelle taille.
+ * Le nouveau tableau est alloué vacant, puis chaque bloc de l'ancien est
+ * parcouru par un fil. Les clefs étant distinctes, une insertion n'a pas à
+ * comparer de clefs : elle sonde le nouveau tableau et réserve la première
+ * case vacante en échangeant atomiquement son état VACANT pour OCCUPE. La
+ * clef et l'élément ne sont écrits que par le fil qui a réservé la case et
+ * ne sont lus qu'après la fin de la boucle parallèle.
  *
- * \post La table à la nouvelle taille
+ * \param[in] p_taille La nouvelle taille, un nombre premier
+ * \pre Un groupe de travailleurs est assigné
+ * \post La table est rehachée avec la nouvelle taille
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-void TableHachage<TypeClef, TypeElement, FoncteurHachage>::_redimensionner()
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_rehacherEnParallele(size_t p_taille)
 {
-    m_tab.resize(_prochainPremier(2 * m_tab.size()));
+    PRECONDITION(m_travailleurs != nullptr);
+
+    std::vector<EntreeHachage, AllocateurEntrees> nouveau(p_taille, m_tab.get_allocator());
+    const size_t tailleNouveau = nouveau.size();
+    std::mutex verrouStatistiques;
+    m_statistiques.reinitialiser();
+
+    m_travailleurs->executerEnParallele(m_tab.size(), dispersion::TAILLE_BLOC_REHACHAGE,
+        [this, &nouveau, tailleNouveau, &verrouStatistiques](size_t p_debut, size_t p_fin)
+        {
+            StatistiquesCollisions statistiquesBloc;
+            for (size_t i = p_debut; i < p_fin; ++i)
+            {
+                if (m_tab[i].m_info != OCCUPE)
+                {
+                    continue;
+                }
+                dispersion::Sondage sondage(m_hachage(m_tab[i].m_clef), tailleNouveau);
+                for (;;)
+                {
+                    std::atomic_ref<EtatEntree> etat(nouveau[sondage.position()].m_info);
+                    EtatEntree attendu = VACANT;
+                    if (etat.load(std::memory_order_relaxed) == VACANT
+                        && etat.compare_exchange_strong(attendu, OCCUPE, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                    sondage.suivant();
+                }
+                nouveau[sondage.position()].m_clef = m_tab[i].m_clef;
+                nouveau[sondage.position()].m_el = m_tab[i].m_el;
+                statistiquesBloc.compter(sondage.collisions());
+            }
+            std::lock_guard<std::mutex> verrou(verrouStatistiques);
+            m_statistiques.fusionner(statistiquesBloc);
+        });
+
+    m_tab.swap(nouveau);
+    m_nbEffaces = 0;
 }
 
 /**
@@ -375,8 +543,8 @@ void TableHachage<TypeClef, TypeElement, FoncteurHachage>::_redimensionner()
  * \param[out] p_v Un vecteur qui contiendra les entrées actives de la table
  * \post La table est inchangée
  */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-void TableHachage<TypeClef, TypeElement, FoncteurHachage>::_reqEntreesActives(
+template<typename TypeClef, typename TypeElement, class FoncteurHachage, class Allocateur>
+void TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur>::_reqEntreesActives(
                                                                               std::vector<EntreeHachage> & p_v) const
 {
     for (size_t i = 0; i < m_tab.size(); ++i)
@@ -388,74 +556,15 @@ void TableHachage<TypeClef, TypeElement, FoncteurHachage>::_reqEntreesActives(
     }
 }
 
-/**
- * \brief Retourner le prochain nombre premier à partir
- * d'un certain entier
- * \param[in] p_entier Entier de départ
- * \return Le nombre premier suivant p_entier
- * \post La table est inchangée
- */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-int TableHachage<TypeClef, TypeElement, FoncteurHachage>::_prochainPremier(
-                                                                           int p_entier) const
-{
-    if (p_entier % 2 == 0)
-    {
-        p_entier++;
-    }
-    while (!_estPremier(p_entier))
-    {
-        p_entier += 2;
-    }
-    return p_entier;
-}
-
-/**
- * \brief Déterminer si un entier est premier
- * \param[in] p_entier L'entier à tester
- * \return Bool indiquant si l'entier est premier
- * \post La table est inchangée
- */
-template<typename TypeClef, typename TypeElement, class FoncteurHachage>
-bool TableHachage<TypeClef, TypeElement, FoncteurHachage>::_estPremier(
-                                                                       int p_entier) const
-{
-    if (p_entier <= 1)
-    {
-        return false;
-    }
-    if (p_entier == 2)
-    { // le seul nombre premier pair
-        return true;
-    }
-    if (p_entier % 2 == 0)
-    { // sinon, ce n'est pas un nombre premier
-        return false;
-    }
-
-    int divisor = 3;
-    int upperLimit = static_cast<int> (sqrt((float) p_entier) + 1);
-
-    while (divisor <= upperLimit)
-    {
-        if (p_entier % divisor == 0)
-        {
-            return false;
-        }
-        divisor += 2;
-    }
-    return true;
-}
-
 /**
  * \brief Surcharge de l'opérateur <<
  * \param[out] p_out Le ostream vers lequel afficher
  * \param[in] p_source La table à afficher
  * \return p_out
  */
-template<typename TClef, typename TElement, class FHachage>
+template<typename TClef, typename TElement, class FHachage, class Alloc>
 std::ostream& operator<<(std::ostream& p_out,
-        const TableHachage<TClef, TElement, FHachage> & p_source)
+        const TableHachage<TClef, TElement, FHachage, Alloc> & p_source)
 {
     p_source.afficher(p_out);
     return p_out;
@@ -0,0 +1,76 @@
+/**
+ * \file TableHachageFigee.h
+ * \brief Classe définissant une table de hachage figée (lecture seule).
+ *
+ *	Une position par clef, calculée par une fonction de hachage parfaite minimale.
+ *
+ */
+
+#ifndef TABLEHACHAGEFIGEE_H_
+#define TABLEHACHAGEFIGEE_H_
+
+#include <vector>
+#include "TableHachage.h"
+#include "HachageParfaitMinimal.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \class TableHachageFigee
+ *
+ * \brief Index immuable construit à partir d'une TableHachage
+ *
+ *  Le tableau contient exactement une entrée par clef : il n'y a ni case
+ *  vacante ni redistribution. Une recherche calcule la position de la clef,
+ *  puis compare la clef qui s'y trouve. Les rares clefs dont la valeur de
+ *  hachage est identique à celle d'une autre clef sont rangées dans une
+ *  zone de débordement triée par valeur de hachage : seules celles de même
+ *  valeur que la clef cherchée sont comparées.
+ *
+ * TypeClef : le type des clefs
+ * TypeElement : le type des éléments dans la table
+ * FoncteurHachage: foncteur de hachage
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+class TableHachageFigee
+{
+public:
+
+    TableHachageFigee();
+    template<class Allocateur>
+    explicit TableHachageFigee(const TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur> &);
+
+    bool contient(const TypeClef &) const;
+    TypeElement element(const TypeClef &) const;
+    const TypeElement * trouver(const TypeClef &) const;
+
+    size_t taille() const;
+    size_t memoire() const;
+
+private:
+
+    /**
+     * \class EntreeFigee
+     * \brief Classe interne pour définir une entrée dans la table figée
+     */
+    class EntreeFigee
+    {
+    public:
+        TypeClef m_clef; /*!< la clé de hachage*/
+        TypeElement m_el; /*!< la valeur associée à la clé*/
+    };
+
+    std::vector<EntreeFigee> m_tab; /*!< Une entrée par valeur de hachage distincte */
+    std::vector<EntreeFigee> m_debordement; /*!< Clefs dont la valeur de hachage est déjà prise */
+    std::vector<uint64_t> m_hachagesDebordement; /*!< Valeur de hachage de chaque clef en débordement, en ordre croissant */
+    HachageParfaitMinimal m_fonction; /*!< Position de chaque valeur de hachage */
+    FoncteurHachage m_hachage; /*!< Foncteur de hachage */
+
+    const EntreeFigee * _trouver(const TypeClef &) const;
+};
+} //Fin du namespace
+
+#include "TableHachageFigee.hpp"
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * \file TableHachageFigee.hpp
+ * \brief Implémentation des opérateurs de la classe table de hachage figée
+ *
+ */
+#include <algorithm>
+#include "ContratException.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Constructeur par défaut
+ *
+ * Prépare une table figée vide.
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::TableHachageFigee() :
+m_tab(), m_debordement(), m_hachagesDebordement(), m_fonction(), m_hachage()
+{
+}
+
+/**
+ * \brief Construire la table figée à partir d'une table de hachage
+ *
+ * Les paires sont triées par valeur de hachage; la fonction parfaite est
+ * construite sur les valeurs distinctes, puis chaque paire est copiée à sa position.
+ *
+ * \param[in] p_source La table à figer
+ * \post La table figée contient les mêmes paires que p_source
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+template<class Allocateur>
+TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::TableHachageFigee(
+        const TableHachage<TypeClef, TypeElement, FoncteurHachage, Allocateur> & p_source) :
+TableHachageFigee()
+{
+    std::vector<std::pair<uint64_t, EntreeFigee> > paires;
+    paires.reserve(p_source.taille());
+    p_source.parcourir([this, &paires](const TypeClef & p_clef, const TypeElement & p_el)
+    {
+        paires.push_back({m_hachage(p_clef), EntreeFigee{p_clef, p_el}});
+    });
+    if (paires.empty())
+    {
+        return;
+    }
+    std::sort(paires.begin(), paires.end(), [](const auto & a, const auto & b)
+    {
+        return a.first < b.first;
+    });
+
+    std::vector<uint64_t> hachages;
+    hachages.reserve(paires.size());
+    for (size_t i = 0; i < paires.size(); ++i)
+    {
+        if (i > 0 && paires[i].first == paires[i - 1].first)
+        {
+            m_debordement.push_back(paires[i].second);
+            m_hachagesDebordement.push_back(paires[i].first);
+        }
+        else
+        {
+            hachages.push_back(paires[i].first);
+        }
+    }
+    m_fonction.construire(hachages);
+
+    m_tab.resize(hachages.size());
+    for (size_t i = 0; i < paires.size(); ++i)
+    {
+        if (i == 0 || paires[i].first != paires[i - 1].first)
+        {
+            m_tab[m_fonction.position(paires[i].first)] = paires[i].second;
+        }
+    }
+
+    POSTCONDITION(m_tab.size() + m_debordement.size() == static_cast<size_t>(p_source.taille()));
+}
+
+/**
+ * \brief Trouver l'entrée d'une clef
+ *
+ * \param[in] p_clef La clef à chercher
+ * \return Un pointeur vers l'entrée, ou nullptr si la clef est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+const typename TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::EntreeFigee *
+TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::_trouver(const TypeClef & p_clef) const
+{
+    if (m_tab.empty())
+    {
+        return nullptr;
+    }
+    const uint64_t valeurHachee = m_hachage(p_clef);
+    const EntreeFigee & candidate = m_tab[m_fonction.position(valeurHachee)];
+    if (candidate.m_clef == p_clef)
+    {
+        return &candidate;
+    }
+    auto hachage = std::lower_bound(m_hachagesDebordement.begin(), m_hachagesDebordement.end(), valeurHachee);
+    for (; hachage != m_hachagesDebordement.end() && *hachage == valeurHachee; ++hachage)
+    {
+        const EntreeFigee & entree = m_debordement[hachage - m_hachagesDebordement.begin()];
+        if (entree.m_clef == p_clef)
+        {
+            return &entree;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * \brief Déterminer si une clef est présente dans la table
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \return Bool indiquant si la clef est dans la table
+ * \post La table est inchangée.
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+bool TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::contient(const TypeClef & p_clef) const
+{
+    return _trouver(p_clef) != nullptr;
+}
+
+/**
+ * \brief Retourner l'élément associé à une clef
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher l'élément associé
+ * \pre La clef est dans la table
+ * \return L'élément associé à la clef
+ * \post La table est inchangée
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+TypeElement TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::element(const TypeClef & p_clef) const
+{
+    const EntreeFigee * entree = _trouver(p_clef);
+
+    PRECONDITION(entree != nullptr);
+
+    return entree->m_el;
+}
+
+/**
+ * \brief Chercher l'élément associé à une clef, sans précondition
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher l'élément associé
+ * \return Un pointeur vers l'élément, ou nullptr si la clef est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+const TypeElement * TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::trouver(const TypeClef & p_clef) const
+{
+    const EntreeFigee * entree = _trouver(p_clef);
+    return entree != nullptr ? &entree->m_el : nullptr;
+}
+
+/**
+ * \brief Retourner le nombre d'éléments dans la table
+ * \post La table est inchangée
+ * \return Le nombre d'éléments dans la table
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+size_t TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::taille() const
+{
+    return m_tab.size() + m_debordement.size();
+}
+
+/**
+ * \brief Retourner la mémoire occupée par la table, en octets
+ *
+ * Seules les structures de la table sont comptées, pas la mémoire dynamique des clefs.
+ *
+ * \post La table est inchangée
+ * \return La taille des tableaux et de la fonction parfaite
+ */
+template<typename TypeClef, typename TypeElement, class FoncteurHachage>
+size_t TableHachageFigee<TypeClef, TypeElement, FoncteurHachage>::memoire() const
+{
+    return (m_tab.size() + m_debordement.size()) * sizeof(EntreeFigee)
+           + m_hachagesDebordement.size() * sizeof(uint64_t) + m_fonction.memoire();
+}
+
+} //Fin du namespace
@@ -0,0 +1,131 @@
+/**
+ * \file TableHachageIndex.h
+ * \brief Classe définissant un index de hachage sans copie des clefs.
+ *
+ *	Résolution des collisions par redistribution quadratique.
+ *
+ *	Avec un GroupeTravailleurs (asgTravailleurs), le rehachage des grands
+ *	index est réparti entre les fils, comme pour TableHachage.
+ *
+ *	Avec un foncteur à graine (HSipString, HSipInt64), une insertion qui subit
+ *	trop de collisions fait tirer une nouvelle graine et rehacher l'index.
+ *
+ */
+
+#ifndef TABLEHACHAGEINDEX_H_
+#define TABLEHACHAGEINDEX_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include "DispersionQuadratique.h"
+
+namespace TP3
+{
+class GroupeTravailleurs;
+}
+
+namespace labTableHachage
+{
+
+/**
+ * \class TableHachageIndex
+ *
+ * \brief Index de dispersion dont les cases ne contiennent que l'index d'une entrée
+ *
+ *  Les clefs restent dans le conteneur des entrées : chaque case contient
+ *  l'index de l'entrée (32 bits) et un fragment de sa valeur de hachage
+ *  (32 bits). Le fragment écarte la plupart des mauvais candidats sans
+ *  consulter l'entrée; sinon la clef est obtenue par l'extracteur et comparée.
+ *  La redistribution est quadratique, comme pour TableHachage.
+ *
+ * TypeClef : le type des clefs, habituellement une vue (std::string_view, ...)
+ * ExtracteurClef : foncteur retournant la TypeClef d'une entrée à partir de son index
+ * FoncteurHachage: foncteur de hachage sur TypeClef
+ * EgaliteClef : foncteur comparant deux TypeClef; il doit être cohérent avec
+ *               FoncteurHachage (deux clefs égales ont la même valeur de hachage)
+ * Allocateur : allocateur du tableau des cases, comme pour TableHachage
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage,
+         class EgaliteClef = std::equal_to<TypeClef>, class Allocateur = std::allocator<char> >
+class TableHachageIndex
+{
+public:
+
+    explicit TableHachageIndex(const ExtracteurClef & = ExtracteurClef(), size_t = 100,
+                               const FoncteurHachage & = FoncteurHachage(), const EgaliteClef & = EgaliteClef());
+
+    void inserer(size_t);
+    void enlever(const TypeClef &);
+    std::optional<size_t> retirer(const TypeClef &);
+
+    bool contient(const TypeClef &) const;
+    size_t element(const TypeClef &) const;
+    std::optional<size_t> trouver(const TypeClef &) const;
+    void trouverPlusieurs(std::span<const TypeClef>, std::span<std::optional<size_t> >) const;
+
+    void rehacher();
+    void vider();
+    size_t taille() const;
+    size_t memoire() const;
+
+    void asgTravailleurs(TP3::GroupeTravailleurs *);
+
+    void statistiques(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const;
+
+    template<typename Fonction>
+    void parcourir(Fonction) const;
+
+    const ExtracteurClef & reqExtracteur() const;
+    const FoncteurHachage & reqHachage() const;
+    size_t nombreRegenerationsGraine() const;
+    const EgaliteClef & reqEgalite() const;
+
+    static const size_t INDEX_MAX = 0xFFFFFFFDu; /*!< Plus grand index d'entrée pouvant être indexé */
+    static const size_t TAILLE_LOT = 16; /*!< Clefs hachées et préchargées ensemble par trouverPlusieurs */
+
+private:
+
+    /**
+     * \class Case
+     * \brief Une case de l'index : l'index de l'entrée et un fragment de sa valeur de hachage
+     */
+    class Case
+    {
+    public:
+        uint32_t m_index; /*!< index de l'entrée, ou VACANT / EFFACE */
+        uint32_t m_fragment; /*!< 32 bits de la valeur de hachage de la clef */
+    };
+
+    static const uint32_t VACANT = 0xFFFFFFFFu; /*!< la case n'a jamais été utilisée */
+    static const uint32_t EFFACE = 0xFFFFFFFEu; /*!< la case a été utilisée mais ne l'est plus */
+
+    typedef typename std::allocator_traits<Allocateur>::template rebind_alloc<Case> AllocateurCases;
+
+    std::vector<Case, AllocateurCases> m_tab; /*!< La table de dispersion */
+    size_t m_cardinalite; /*!< Le nombre d'éléments actifs dans la table */
+    size_t m_nbEffaces = 0; /*!< Le nombre de cases EFFACE, comptées dans le taux de remplissage */
+    ExtracteurClef m_extracteur; /*!< Accès à la clef d'une entrée */
+    FoncteurHachage m_hachage; /*!< Foncteur de hachage */
+    EgaliteClef m_egalite; /*!< Foncteur de comparaison des clefs */
+
+    StatistiquesCollisions m_statistiques; /*!< Collisions des insertions depuis le dernier rehachage */
+    TP3::GroupeTravailleurs * m_travailleurs = nullptr; /*!< Fils du rehachage parallèle, ou nullptr */
+    size_t m_nRegenerationsGraine = 0; /*!< Nombre de graines tirées depuis la construction */
+
+    // Méthodes privées
+
+    size_t _trouverPositionLibre(size_t, size_t &);
+    size_t _trouverPositionClef(const TypeClef &) const;
+    size_t _trouverPositionClef(const TypeClef &, size_t) const;
+    void _rehacher(size_t);
+    void _rehacherEnParallele(size_t);
+};
+} //Fin du namespace
+
+#include "TableHachageIndex.hpp"
+
+#endif
@@ -0,0 +1,511 @@
+/**
+ * \file TableHachageIndex.hpp
+ * \brief Implémentation des opérateurs de l'index de hachage sans copie des clefs
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "ContratException.h"
+#include "GroupeTravailleurs.h"
+#include "Instrumentation.h"
+#include "Prechargement.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Constructeur
+ *
+ * Prépare un index vide de taille nombre premier.
+ *
+ * \param[in] p_extracteur Foncteur donnant la clef d'une entrée à partir de son index
+ * \param[in] p_taille Taille initiale de la table
+ * \param[in] p_hachage Foncteur de hachage, utile s'il a un état
+ * \param[in] p_egalite Foncteur de comparaison des clefs, utile s'il a un état
+ * \pre Il faut qu'il y ait suffisamment de mémoire
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::TableHachageIndex(
+        const ExtracteurClef & p_extracteur, size_t p_taille,
+        const FoncteurHachage & p_hachage, const EgaliteClef & p_egalite) :
+m_tab(dispersion::prochainPremier(p_taille)), m_cardinalite(0), m_extracteur(p_extracteur), m_hachage(p_hachage),
+m_egalite(p_egalite)
+{
+    vider();
+}
+
+/**
+ * \brief Insertion de l'index d'une entrée
+ *
+ * La clef de l'entrée est obtenue par l'extracteur. Une redispersion
+ * quadratique sera utilisée en cas de collision. Si, après une insertion, le
+ * taux de remplissage (cases EFFACE comprises) atteint le maximum, la table
+ * est rehachée. Comme pour TableHachage, une insertion de plus de
+ * dispersion::SEUIL_COLLISIONS_GRAINE collisions fait tirer une nouvelle
+ * graine au foncteur qui en a une, puis rehacher la table.
+ *
+ * \param[in] p_index L'index de l'entrée
+ * \pre L'index est au plus INDEX_MAX
+ * \pre La clef de l'entrée n'est pas déjà présente dans l'index
+ * \post L'entrée est retrouvée par sa clef
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::inserer(size_t p_index)
+{
+    PRECONDITION(p_index <= INDEX_MAX);
+    PRECONDITION_AUDIT(!contient(m_extracteur(p_index)));
+
+    const size_t valeurHachee = m_hachage(m_extracteur(p_index));
+    size_t nbCollisions = 0;
+    size_t position = _trouverPositionLibre(valeurHachee, nbCollisions);
+
+    if (m_tab[position].m_index == EFFACE)
+    {
+        --m_nbEffaces;
+    }
+    m_tab[position].m_index = static_cast<uint32_t>(p_index);
+    m_tab[position].m_fragment = dispersion::fragment(valeurHachee);
+    m_cardinalite++;
+
+    POSTCONDITION(m_tab[position].m_index == p_index);
+
+    const bool doitEtreRehachee = dispersion::doitEtreRehachee(m_tab.size(), m_cardinalite, m_nbEffaces);
+    if (nbCollisions > dispersion::SEUIL_COLLISIONS_GRAINE && dispersion::regenererGraine(m_hachage))
+    {
+        ++m_nRegenerationsGraine;
+        _rehacher(doitEtreRehachee ? dispersion::tailleRehachage(m_tab.size(), m_cardinalite, m_nbEffaces)
+                                   : m_tab.size());
+    }
+    else if (doitEtreRehachee)
+    {
+        _rehacher(dispersion::tailleRehachage(m_tab.size(), m_cardinalite, m_nbEffaces));
+    }
+}
+
+/**
+ * \brief Trouver une position libre (vacante ou effacée) pour une valeur de hachage
+ *
+ * L'insertion et ses collisions sont comptées dans les statistiques.
+ *
+ * \param[in] p_valeurHachee La valeur de hachage de la clef
+ * \param[out] p_nbCollisions Le nombre de collisions subies
+ * \return La position libre
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+size_t TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::_trouverPositionLibre(
+        size_t p_valeurHachee, size_t & p_nbCollisions)
+{
+    dispersion::Sondage sondage(p_valeurHachee, m_tab.size());
+    while (m_tab[sondage.position()].m_index != VACANT && m_tab[sondage.position()].m_index != EFFACE)
+    {
+        sondage.suivant();
+    }
+
+    m_statistiques.compter(sondage.collisions());
+    p_nbCollisions = sondage.collisions();
+    return sondage.position();
+}
+
+/**
+ * \brief Trouver la position d'une clef dans l'index.
+ *
+ * Les cases dont le fragment diffère sont écartées sans consulter l'entrée.
+ *
+ * \param[in] p_clef La clef à chercher
+ * \return La position de la clef, ou m_tab.size() si elle est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+size_t TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::_trouverPositionClef(const TypeClef & p_clef) const
+{
+    return _trouverPositionClef(p_clef, m_hachage(p_clef));
+}
+
+/**
+ * \brief Trouver la position d'une clef dont la valeur de hachage est déjà calculée
+ *
+ * \param[in] p_clef La clef à chercher
+ * \param[in] valeurHachee La valeur de hachage de p_clef
+ * \return La position de la clef, ou m_tab.size() si elle est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+size_t TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::_trouverPositionClef(const TypeClef & p_clef, size_t valeurHachee) const
+{
+    MESURER_PHASE_ECHANTILLONNEE(Phase::TABLE_SONDAGE);
+    const uint32_t fragment = dispersion::fragment(valeurHachee);
+
+    for (dispersion::Sondage sondage(valeurHachee, m_tab.size()); m_tab[sondage.position()].m_index != VACANT;
+         sondage.suivant())
+    {
+        const Case & courante = m_tab[sondage.position()];
+        if (courante.m_index != EFFACE && courante.m_fragment == fragment
+            && m_egalite(m_extracteur(courante.m_index), p_clef))
+        {
+            return sondage.position();
+        }
+    }
+    return m_tab.size();
+}
+
+/**
+ * \brief Chercher les index des entrées associées à un lot de clefs
+ *
+ * Les clefs sont traitées par lots de TAILLE_LOT : toutes les valeurs de
+ * hachage du lot sont calculées et leurs cases de départ préchargées avant
+ * le premier sondage, ce qui recouvre les accès mémoire du lot.
+ *
+ * \param[in] p_clefs Les clefs à chercher
+ * \param[out] p_resultats L'index de l'entrée de chaque clef, ou rien si elle est absente
+ * \pre p_resultats a au moins autant de cases que p_clefs
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::trouverPlusieurs(
+        std::span<const TypeClef> p_clefs, std::span<std::optional<size_t> > p_resultats) const
+{
+    PRECONDITION(p_resultats.size() >= p_clefs.size());
+
+    size_t hachages[TAILLE_LOT];
+    for (size_t debut = 0; debut < p_clefs.size(); debut += TAILLE_LOT)
+    {
+        const size_t fin = std::min(debut + TAILLE_LOT, p_clefs.size());
+        for (size_t i = debut; i < fin; ++i)
+        {
+            hachages[i - debut] = m_hachage(p_clefs[i]);
+            precharger(&m_tab[hachages[i - debut] % m_tab.size()]);
+        }
+        for (size_t i = debut; i < fin; ++i)
+        {
+            const size_t position = _trouverPositionClef(p_clefs[i], hachages[i - debut]);
+            p_resultats[i] = position == m_tab.size() ? std::nullopt
+                                                      : std::optional<size_t>(m_tab[position].m_index);
+        }
+    }
+}
+
+/**
+ * \brief Déterminer si une clef est présente dans l'index
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \return Bool indiquant si la clef est dans l'index
+ * \post La table est inchangée.
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+bool TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::contient(const TypeClef & p_clef) const
+{
+    return _trouverPositionClef(p_clef) != m_tab.size();
+}
+
+/**
+ * \brief Retourner l'index de l'entrée associée à une clef
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \pre La clef est dans l'index
+ * \return L'index de l'entrée
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+size_t TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::element(const TypeClef & p_clef) const
+{
+    size_t position = _trouverPositionClef(p_clef);
+
+    PRECONDITION(position != m_tab.size());
+
+    return m_tab[position].m_index;
+}
+
+/**
+ * \brief Chercher l'index de l'entrée associée à une clef, en un seul sondage
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \return L'index de l'entrée, ou rien si la clef est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+std::optional<size_t> TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::trouver(const TypeClef & p_clef) const
+{
+    size_t position = _trouverPositionClef(p_clef);
+    if (position == m_tab.size())
+    {
+        return std::nullopt;
+    }
+    return m_tab[position].m_index;
+}
+
+/**
+ * \brief Supprimer une clef de l'index.
+ *
+ * On utilise le "lazy deletion". La case est simplement marquée EFFACE.
+ *
+ * \pre La clé à supprimer doit être présente dans l'index
+ * \param[in] p_clef La clef à supprimer
+ * \post L'index comprend un élément de moins
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::enlever(const TypeClef & p_clef)
+{
+    const std::optional<size_t> index = retirer(p_clef);
+
+    PRECONDITION(index.has_value());
+}
+
+/**
+ * \brief Retirer une clef de l'index si elle y est, en un seul sondage
+ *
+ * \param[in] p_clef La clef à retirer
+ * \return L'index de l'entrée retirée, ou rien si la clef était absente
+ * \post La clef n'est plus dans l'index
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+std::optional<size_t> TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::retirer(const TypeClef & p_clef)
+{
+    size_t position = _trouverPositionClef(p_clef);
+    if (position == m_tab.size())
+    {
+        return std::nullopt;
+    }
+
+    const size_t index = m_tab[position].m_index;
+    m_tab[position].m_index = EFFACE;
+    --m_cardinalite;
+    ++m_nbEffaces;
+
+    POSTCONDITION_AUDIT(!contient(p_clef));
+    return index;
+}
+
+/**
+ * \brief Rehacher la table.
+ *
+ * La taille est doublée et le premier nombre premier suivant ce nombre est
+ * choisi comme nouvelle taille. Les clefs sont relues par l'extracteur pour
+ * recalculer leur position.
+ *
+ * \post La table est rehachée avec la nouvelle taille
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::rehacher()
+{
+    _rehacher(dispersion::prochainPremier(2 * m_tab.size()));
+}
+
+/**
+ * \brief Rehacher la table dans un tableau d'une taille donnée
+ *
+ * Les cases EFFACE disparaissent : une même taille purge la table. Un grand
+ * index est réparti entre les travailleurs s'ils ont été assignés.
+ *
+ * \param[in] p_taille La nouvelle taille, un nombre premier
+ * \pre La nouvelle taille laisse le taux de remplissage sous le maximum
+ * \post La table ne contient plus de case EFFACE
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::_rehacher(size_t p_taille)
+{
+    PRECONDITION(m_cardinalite < dispersion::seuilRemplissage(p_taille));
+    MESURER_PHASE(Phase::TABLE_REHACHAGE);
+    if (m_travailleurs != nullptr && m_cardinalite >= dispersion::SEUIL_REHACHAGE_PARALLELE)
+    {
+        _rehacherEnParallele(p_taille);
+        return;
+    }
+    m_statistiques.reinitialiser();
+
+    std::vector<uint32_t> indexActifs;
+    indexActifs.reserve(m_cardinalite);
+    parcourir([&indexActifs](size_t p_index) { indexActifs.push_back(static_cast<uint32_t>(p_index)); });
+
+    m_tab.resize(p_taille);
+    vider();
+
+    for (uint32_t index : indexActifs)
+    {
+        const size_t valeurHachee = m_hachage(m_extracteur(index));
+        size_t nbCollisions = 0;
+        size_t position = _trouverPositionLibre(valeurHachee, nbCollisions);
+        m_tab[position].m_index = index;
+        m_tab[position].m_fragment = dispersion::fragment(valeurHachee);
+        m_cardinalite++;
+    }
+}
+
+/**
+ * \brief Rehacher l'index en répartissant l'ancien tableau entre les travailleurs
+ *
+ * Comme pour TableHachage : les clefs étant distinctes, chaque fil sonde le
+ * nouveau tableau et réserve la première case vacante en y échangeant
+ * atomiquement VACANT pour l'index de l'entrée, puis y écrit le fragment,
+ * recalculé puisque la graine a pu changer. L'extracteur et le foncteur de
+ * hachage sont appelés depuis plusieurs fils.
+ *
+ * \param[in] p_taille La nouvelle taille, un nombre premier
+ * \pre Un groupe de travailleurs est assigné
+ * \post La table ne contient plus de case EFFACE
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::_rehacherEnParallele(size_t p_taille)
+{
+    PRECONDITION(m_travailleurs != nullptr);
+
+    std::vector<Case, AllocateurCases> nouveau(p_taille, Case{VACANT, 0}, m_tab.get_allocator());
+    const size_t tailleNouveau = nouveau.size();
+    std::mutex verrouStatistiques;
+    m_statistiques.reinitialiser();
+
+    m_travailleurs->executerEnParallele(m_tab.size(), dispersion::TAILLE_BLOC_REHACHAGE,
+        [this, &nouveau, tailleNouveau, &verrouStatistiques](size_t p_debut, size_t p_fin)
+        {
+            StatistiquesCollisions statistiquesBloc;
+            for (size_t i = p_debut; i < p_fin; ++i)
+            {
+                const uint32_t index = m_tab[i].m_index;
+                if (index == VACANT || index == EFFACE)
+                {
+                    continue;
+                }
+                const size_t valeurHachee = m_hachage(m_extracteur(index));
+                dispersion::Sondage sondage(valeurHachee, tailleNouveau);
+                for (;;)
+                {
+                    std::atomic_ref<uint32_t> occupant(nouveau[sondage.position()].m_index);
+                    uint32_t attendu = VACANT;
+                    if (occupant.load(std::memory_order_relaxed) == VACANT
+                        && occupant.compare_exchange_strong(attendu, index, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                    sondage.suivant();
+                }
+                nouveau[sondage.position()].m_fragment = dispersion::fragment(valeurHachee);
+                statistiquesBloc.compter(sondage.collisions());
+            }
+            std::lock_guard<std::mutex> verrou(verrouStatistiques);
+            m_statistiques.fusionner(statistiquesBloc);
+        });
+
+    m_tab.swap(nouveau);
+    m_nbEffaces = 0;
+}
+
+/**
+ * \brief Vider l'index
+ * \post L'index est vide
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::vider()
+{
+    m_cardinalite = 0;
+    m_nbEffaces = 0;
+    for (size_t i = 0; i < m_tab.size(); ++i)
+    {
+        m_tab[i].m_index = VACANT;
+    }
+}
+
+/**
+ * \brief Retourner le nombre d'éléments dans l'index
+ * \post La table est inchangée
+ * \return Le nombre d'éléments dans l'index
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+size_t TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::taille() const
+{
+    return m_cardinalite;
+}
+
+/**
+ * \brief Retourner la mémoire occupée par les cases de l'index, en octets
+ * \post La table est inchangée
+ * \return La taille du tableau des cases
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+size_t TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::memoire() const
+{
+    return m_tab.size() * sizeof(Case);
+}
+
+/**
+ * \brief Assigner les travailleurs qui rehachent les grands index
+ *
+ * \param[in] p_travailleurs Le groupe, qui doit survivre à l'index, ou nullptr
+ *            pour rehacher dans l'appelant
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::asgTravailleurs(
+        TP3::GroupeTravailleurs * p_travailleurs)
+{
+    m_travailleurs = p_travailleurs;
+}
+
+/**
+ * \brief Calcule les statistiques du nombre moyen de collisions par insertion.
+ * \pre L'objet doit avoir ajouter au moins un élément
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::statistiques(
+        double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const
+{
+    m_statistiques.statistiques(p_ratio, p_nbCollisions, p_maximumCollisionUneInsertion);
+}
+
+/**
+ * \brief Appliquer une fonction à l'index de chaque entrée présente
+ * \param[in] p_fonction Fonction appelée avec (size_t index)
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+template<typename Fonction>
+void TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::parcourir(Fonction p_fonction) const
+{
+    for (size_t i = 0; i < m_tab.size(); ++i)
+    {
+        if (m_tab[i].m_index != VACANT && m_tab[i].m_index != EFFACE)
+        {
+            p_fonction(static_cast<size_t>(m_tab[i].m_index));
+        }
+    }
+}
+
+/**
+ * \brief Retourner l'extracteur de clefs
+ * \return L'extracteur utilisé par l'index
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+const ExtracteurClef & TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::reqExtracteur() const
+{
+    return m_extracteur;
+}
+
+/**
+ * \brief Retourner le nombre de graines tirées après une insertion trop longue
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+size_t TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::nombreRegenerationsGraine() const
+{
+    return m_nRegenerationsGraine;
+}
+
+/**
+ * \brief Retourner le foncteur de hachage, avec sa graine courante
+ * \return Le foncteur utilisé par l'index
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+const FoncteurHachage & TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::reqHachage() const
+{
+    return m_hachage;
+}
+
+/**
+ * \brief Retourner le foncteur de comparaison des clefs
+ * \return Le foncteur utilisé par l'index
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef, class Allocateur>
+const EgaliteClef & TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur>::reqEgalite() const
+{
+    return m_egalite;
+}
+
+} //Fin du namespace
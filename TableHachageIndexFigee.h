@@ -0,0 +1,74 @@
+/**
+ * \file TableHachageIndexFigee.h
+ * \brief Classe définissant un index figé (lecture seule) sans copie des clefs.
+ *
+ *	Une position par clef, calculée par une fonction de hachage parfaite minimale.
+ *
+ */
+
+#ifndef TABLEHACHAGEINDEXFIGEE_H_
+#define TABLEHACHAGEINDEXFIGEE_H_
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+#include "TableHachageIndex.h"
+#include "HachageParfaitMinimal.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \class TableHachageIndexFigee
+ *
+ * \brief Version immuable d'une TableHachageIndex
+ *
+ *  Chaque case contient uniquement l'index d'une entrée; la clef est relue
+ *  par l'extracteur pour vérifier le résultat. Comme pour TableHachageFigee,
+ *  les clefs dont la valeur de hachage est déjà prise vont en débordement,
+ *  trié par valeur de hachage.
+ *
+ * TypeClef : le type des clefs
+ * ExtracteurClef : foncteur retournant la TypeClef d'une entrée à partir de son index
+ * FoncteurHachage: foncteur de hachage sur TypeClef
+ * EgaliteClef : foncteur comparant deux TypeClef
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage,
+         class EgaliteClef = std::equal_to<TypeClef> >
+class TableHachageIndexFigee
+{
+public:
+
+    explicit TableHachageIndexFigee(const ExtracteurClef & = ExtracteurClef(),
+                                    const FoncteurHachage & = FoncteurHachage(), const EgaliteClef & = EgaliteClef());
+    template<class Allocateur>
+    explicit TableHachageIndexFigee(const TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur> &);
+
+    bool contient(const TypeClef &) const;
+    size_t element(const TypeClef &) const;
+    std::optional<size_t> trouver(const TypeClef &) const;
+    void trouverPlusieurs(std::span<const TypeClef>, std::span<std::optional<size_t> >) const;
+
+    size_t taille() const;
+    size_t memoire() const;
+
+private:
+    std::vector<uint32_t> m_tab; /*!< Index de l'entrée de chaque valeur de hachage distincte */
+    std::vector<uint32_t> m_debordement; /*!< Entrées dont la valeur de hachage est déjà prise */
+    std::vector<uint64_t> m_hachagesDebordement; /*!< Valeur de hachage de chaque entrée en débordement, en ordre croissant */
+    HachageParfaitMinimal m_fonction; /*!< Position de chaque valeur de hachage */
+    ExtracteurClef m_extracteur; /*!< Accès à la clef d'une entrée */
+    FoncteurHachage m_hachage; /*!< Foncteur de hachage */
+    EgaliteClef m_egalite; /*!< Foncteur de comparaison des clefs */
+
+    static const size_t TAILLE_LOT = 16; /*!< Clefs hachées et préchargées ensemble par trouverPlusieurs */
+
+    std::optional<size_t> _verifier(uint32_t, uint64_t, const TypeClef &) const;
+};
+} //Fin du namespace
+
+#include "TableHachageIndexFigee.hpp"
+
+#endif
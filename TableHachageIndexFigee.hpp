@@ -0,0 +1,225 @@
+/**
+ * \file TableHachageIndexFigee.hpp
+ * \brief Implémentation des opérateurs de l'index figé sans copie des clefs
+ *
+ */
+#include <algorithm>
+#include <utility>
+#include "ContratException.h"
+#include "Prechargement.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Constructeur par défaut
+ *
+ * Prépare un index figé vide.
+ *
+ * \param[in] p_extracteur Foncteur donnant la clef d'une entrée à partir de son index
+ * \param[in] p_hachage Foncteur de hachage
+ * \param[in] p_egalite Foncteur de comparaison des clefs
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::TableHachageIndexFigee(
+        const ExtracteurClef & p_extracteur, const FoncteurHachage & p_hachage, const EgaliteClef & p_egalite) :
+m_tab(), m_debordement(), m_hachagesDebordement(), m_fonction(), m_extracteur(p_extracteur), m_hachage(p_hachage), m_egalite(p_egalite)
+{
+}
+
+/**
+ * \brief Construire l'index figé à partir d'un index dynamique
+ *
+ * \param[in] p_source L'index à figer
+ * \post L'index figé retrouve les mêmes entrées que p_source
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+template<class Allocateur>
+TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::TableHachageIndexFigee(
+        const TableHachageIndex<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef, Allocateur> & p_source) :
+TableHachageIndexFigee(p_source.reqExtracteur(), p_source.reqHachage(), p_source.reqEgalite())
+{
+    std::vector<std::pair<uint64_t, uint32_t> > paires;
+    paires.reserve(p_source.taille());
+    p_source.parcourir([this, &paires](size_t p_index)
+    {
+        paires.push_back({m_hachage(m_extracteur(p_index)), static_cast<uint32_t>(p_index)});
+    });
+    if (paires.empty())
+    {
+        return;
+    }
+    std::sort(paires.begin(), paires.end());
+
+    std::vector<uint64_t> hachages;
+    hachages.reserve(paires.size());
+    for (size_t i = 0; i < paires.size(); ++i)
+    {
+        if (i > 0 && paires[i].first == paires[i - 1].first)
+        {
+            m_debordement.push_back(paires[i].second);
+            m_hachagesDebordement.push_back(paires[i].first);
+        }
+        else
+        {
+            hachages.push_back(paires[i].first);
+        }
+    }
+    m_fonction.construire(hachages);
+
+    m_tab.resize(hachages.size());
+    for (size_t i = 0; i < paires.size(); ++i)
+    {
+        if (i == 0 || paires[i].first != paires[i - 1].first)
+        {
+            m_tab[m_fonction.position(paires[i].first)] = paires[i].second;
+        }
+    }
+
+    POSTCONDITION(m_tab.size() + m_debordement.size() == static_cast<size_t>(p_source.taille()));
+}
+
+/**
+ * \brief Chercher l'index de l'entrée associée à une clef
+ *
+ * \param[in] p_clef La clef à chercher
+ * \return L'index de l'entrée, ou rien si la clef est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+std::optional<size_t> TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::trouver(const TypeClef & p_clef) const
+{
+    if (m_tab.empty())
+    {
+        return std::nullopt;
+    }
+    const uint64_t valeurHachee = m_hachage(p_clef);
+    return _verifier(m_tab[m_fonction.position(valeurHachee)], valeurHachee, p_clef);
+}
+
+/**
+ * \brief Chercher les index des entrées associées à un lot de clefs
+ *
+ * Les positions de tout un lot sont calculées et préchargées avant la
+ * première vérification, ce qui recouvre les accès mémoire du lot.
+ *
+ * \param[in] p_clefs Les clefs à chercher
+ * \param[out] p_resultats L'index de l'entrée de chaque clef, ou rien si elle est absente
+ * \pre p_resultats a au moins autant de cases que p_clefs
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+void TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::trouverPlusieurs(
+        std::span<const TypeClef> p_clefs, std::span<std::optional<size_t> > p_resultats) const
+{
+    PRECONDITION(p_resultats.size() >= p_clefs.size());
+
+    if (m_tab.empty())
+    {
+        std::fill(p_resultats.begin(), p_resultats.begin() + p_clefs.size(), std::nullopt);
+        return;
+    }
+    uint64_t hachages[TAILLE_LOT];
+    size_t positions[TAILLE_LOT];
+    for (size_t debut = 0; debut < p_clefs.size(); debut += TAILLE_LOT)
+    {
+        const size_t fin = std::min(debut + TAILLE_LOT, p_clefs.size());
+        for (size_t i = debut; i < fin; ++i)
+        {
+            hachages[i - debut] = m_hachage(p_clefs[i]);
+            positions[i - debut] = m_fonction.position(hachages[i - debut]);
+            precharger(&m_tab[positions[i - debut]]);
+        }
+        for (size_t i = debut; i < fin; ++i)
+        {
+            p_resultats[i] = _verifier(m_tab[positions[i - debut]], hachages[i - debut], p_clefs[i]);
+        }
+    }
+}
+
+/**
+ * \brief Vérifier le candidat désigné par la fonction parfaite, puis le débordement
+ *
+ * Seules les entrées en débordement de même valeur de hachage que la clef
+ * sont comparées : une recherche dichotomique les trouve.
+ *
+ * \param[in] p_candidat L'index d'entrée trouvé à la position de la clef
+ * \param[in] p_valeurHachee La valeur de hachage de p_clef
+ * \param[in] p_clef La clef cherchée
+ * \return L'index de l'entrée, ou rien si la clef est absente
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+std::optional<size_t> TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::_verifier(
+        uint32_t p_candidat, uint64_t p_valeurHachee, const TypeClef & p_clef) const
+{
+    if (m_egalite(m_extracteur(p_candidat), p_clef))
+    {
+        return p_candidat;
+    }
+    auto hachage = std::lower_bound(m_hachagesDebordement.begin(), m_hachagesDebordement.end(), p_valeurHachee);
+    for (; hachage != m_hachagesDebordement.end() && *hachage == p_valeurHachee; ++hachage)
+    {
+        const uint32_t index = m_debordement[hachage - m_hachagesDebordement.begin()];
+        if (m_egalite(m_extracteur(index), p_clef))
+        {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * \brief Déterminer si une clef est présente dans l'index
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \return Bool indiquant si la clef est dans l'index
+ * \post La table est inchangée.
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+bool TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::contient(const TypeClef & p_clef) const
+{
+    return trouver(p_clef).has_value();
+}
+
+/**
+ * \brief Retourner l'index de l'entrée associée à une clef
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \pre La clef est dans l'index
+ * \return L'index de l'entrée
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+size_t TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::element(const TypeClef & p_clef) const
+{
+    std::optional<size_t> index = trouver(p_clef);
+
+    PRECONDITION(index.has_value());
+
+    return *index;
+}
+
+/**
+ * \brief Retourner le nombre d'éléments dans l'index
+ * \post La table est inchangée
+ * \return Le nombre d'éléments dans l'index
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+size_t TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::taille() const
+{
+    return m_tab.size() + m_debordement.size();
+}
+
+/**
+ * \brief Retourner la mémoire occupée par l'index, en octets
+ * \post La table est inchangée
+ * \return La taille des tableaux et de la fonction parfaite
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class EgaliteClef>
+size_t TableHachageIndexFigee<TypeClef, ExtracteurClef, FoncteurHachage, EgaliteClef>::memoire() const
+{
+    return (m_tab.size() + m_debordement.size()) * sizeof(uint32_t)
+           + m_hachagesDebordement.size() * sizeof(uint64_t) + m_fonction.memoire();
+}
+
+} //Fin du namespace
@@ -0,0 +1,118 @@
+/**
+ * \file TableHachageMulti.h
+ * \brief Classe définissant un index de hachage à clefs multiples, sans copie des clefs.
+ *
+ *	Résolution des collisions par redistribution quadratique.
+ *
+ *	Avec un GroupeTravailleurs (asgTravailleurs), le rehachage des grands
+ *	index est réparti entre les fils, comme pour TableHachage.
+ *
+ *	Avec un foncteur à graine (HSipString, HSipInt64), une insertion qui subit
+ *	trop de collisions fait tirer une nouvelle graine et rehacher l'index.
+ *
+ */
+
+#ifndef TABLEHACHAGEMULTI_H_
+#define TABLEHACHAGEMULTI_H_
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "DispersionQuadratique.h"
+
+namespace TP3
+{
+class GroupeTravailleurs;
+}
+
+namespace labTableHachage
+{
+
+/**
+ * \class TableHachageMulti
+ *
+ * \brief Index de dispersion où plusieurs entrées peuvent partager la même clef
+ *
+ *  Comme TableHachageIndex, les cases ne contiennent que des index d'entrées
+ *  et les clefs sont relues par l'extracteur. Chaque clef distincte occupe une
+ *  case; les index des entrées qui la partagent sont rangés de façon contiguë :
+ *  directement dans la case s'il n'y en a qu'un, sinon dans un groupe commun.
+ *  Une recherche retourne donc toutes les correspondances en une seule plage.
+ *
+ * TypeClef : le type des clefs, habituellement une vue (std::string_view, ...)
+ * ExtracteurClef : foncteur retournant la TypeClef d'une entrée à partir de son index
+ * FoncteurHachage: foncteur de hachage sur TypeClef
+ * Allocateur : allocateur du tableau des cases, comme pour TableHachageIndex
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur = std::allocator<char> >
+class TableHachageMulti
+{
+public:
+
+    explicit TableHachageMulti(const ExtracteurClef & = ExtracteurClef(), size_t = 100);
+
+    void inserer(size_t);
+    void enlever(size_t);
+
+    bool contient(const TypeClef &) const;
+    std::span<const uint32_t> trouver(const TypeClef &) const;
+    size_t compter(const TypeClef &) const;
+
+    void rehacher();
+    void vider();
+    size_t taille() const;
+    size_t nombreClefs() const;
+
+    void asgTravailleurs(TP3::GroupeTravailleurs *);
+    size_t nombreRegenerationsGraine() const;
+
+    void statistiques(double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const;
+
+    static const size_t INDEX_MAX = 0xFFFFFFFDu; /*!< Plus grand index d'entrée pouvant être indexé */
+
+private:
+
+    /**
+     * \class Case
+     * \brief Une case de l'index : une clef distincte et les entrées qui la partagent
+     */
+    class Case
+    {
+    public:
+        uint32_t m_nombre; /*!< nombre d'entrées ayant cette clef, 0 si la case est libre */
+        uint32_t m_fragment; /*!< 32 bits de la valeur de hachage de la clef */
+        uint32_t m_valeur; /*!< l'index de l'entrée si m_nombre == 1, sinon le numéro du groupe; VACANT / EFFACE si libre */
+    };
+
+    static const uint32_t VACANT = 0xFFFFFFFFu; /*!< la case n'a jamais été utilisée */
+    static const uint32_t EFFACE = 0xFFFFFFFEu; /*!< la case a été utilisée mais ne l'est plus */
+
+    typedef typename std::allocator_traits<Allocateur>::template rebind_alloc<Case> AllocateurCases;
+
+    std::vector<Case, AllocateurCases> m_tab; /*!< La table de dispersion */
+    std::vector<std::vector<uint32_t> > m_groupes; /*!< Les index des clefs partagées par plusieurs entrées */
+    std::vector<uint32_t> m_groupesLibres; /*!< Groupes réutilisables */
+    size_t m_cardinalite; /*!< Le nombre de clefs distinctes */
+    size_t m_nbValeurs; /*!< Le nombre d'entrées indexées */
+    size_t m_nbEffaces = 0; /*!< Le nombre de cases EFFACE, comptées dans le taux de remplissage */
+    ExtracteurClef m_extracteur; /*!< Accès à la clef d'une entrée */
+    FoncteurHachage m_hachage; /*!< Foncteur de hachage */
+
+    StatistiquesCollisions m_statistiques; /*!< Collisions des insertions depuis le dernier rehachage */
+    TP3::GroupeTravailleurs * m_travailleurs = nullptr; /*!< Fils du rehachage parallèle, ou nullptr */
+    size_t m_nRegenerationsGraine = 0; /*!< Nombre de graines tirées depuis la construction */
+
+    // Méthodes privées
+
+    size_t _trouverPositionLibre(size_t, size_t &);
+    size_t _trouverPositionClef(const TypeClef &, size_t) const;
+    std::span<const uint32_t> _valeurs(const Case &) const;
+    void _rehacher(size_t);
+    void _rehacherEnParallele(size_t);
+};
+} //Fin du namespace
+
+#include "TableHachageMulti.hpp"
+
+#endif
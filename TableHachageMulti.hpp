@@ -0,0 +1,459 @@
+/**
+ * \file TableHachageMulti.hpp
+ * \brief Implémentation des opérateurs de l'index de hachage à clefs multiples
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "ContratException.h"
+#include "GroupeTravailleurs.h"
+
+namespace labTableHachage
+{
+
+/**
+ * \brief Constructeur
+ *
+ * Prépare un index vide de taille nombre premier.
+ *
+ * \param[in] p_extracteur Foncteur donnant la clef d'une entrée à partir de son index
+ * \param[in] p_taille Taille initiale de la table
+ * \pre Il faut qu'il y ait suffisamment de mémoire
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::TableHachageMulti(
+        const ExtracteurClef & p_extracteur, size_t p_taille) :
+m_tab(dispersion::prochainPremier(p_taille)), m_groupes(), m_groupesLibres(), m_cardinalite(0), m_nbValeurs(0),
+m_extracteur(p_extracteur), m_hachage()
+{
+    vider();
+}
+
+/**
+ * \brief Insertion de l'index d'une entrée
+ *
+ * Si la clef de l'entrée est déjà présente, l'index est ajouté à la suite des
+ * autres; sinon une nouvelle case est prise par redispersion quadratique. Les
+ * règles de rehachage et de changement de graine sont celles de TableHachageIndex.
+ *
+ * \param[in] p_index L'index de l'entrée
+ * \pre L'index est au plus INDEX_MAX
+ * \post L'index fait partie des correspondances de sa clef
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::inserer(size_t p_index)
+{
+    PRECONDITION(p_index <= INDEX_MAX);
+
+    const uint32_t index = static_cast<uint32_t>(p_index);
+    const TypeClef clef = m_extracteur(p_index);
+    const size_t valeurHachee = m_hachage(clef);
+    size_t position = _trouverPositionClef(clef, valeurHachee);
+    m_nbValeurs++;
+
+    if (position != m_tab.size())
+    {
+        Case & existante = m_tab[position];
+        if (existante.m_nombre == 1)
+        {
+            uint32_t groupe;
+            if (m_groupesLibres.empty())
+            {
+                groupe = static_cast<uint32_t>(m_groupes.size());
+                m_groupes.emplace_back();
+            }
+            else
+            {
+                groupe = m_groupesLibres.back();
+                m_groupesLibres.pop_back();
+            }
+            m_groupes[groupe].assign(1, existante.m_valeur);
+            existante.m_valeur = groupe;
+        }
+        m_groupes[existante.m_valeur].push_back(index);
+        existante.m_nombre++;
+        return;
+    }
+
+    size_t nbCollisions = 0;
+    position = _trouverPositionLibre(valeurHachee, nbCollisions);
+    if (m_tab[position].m_valeur == EFFACE)
+    {
+        --m_nbEffaces;
+    }
+    m_tab[position].m_nombre = 1;
+    m_tab[position].m_fragment = dispersion::fragment(valeurHachee);
+    m_tab[position].m_valeur = index;
+    m_cardinalite++;
+
+    const bool doitEtreRehachee = dispersion::doitEtreRehachee(m_tab.size(), m_cardinalite, m_nbEffaces);
+    if (nbCollisions > dispersion::SEUIL_COLLISIONS_GRAINE && dispersion::regenererGraine(m_hachage))
+    {
+        ++m_nRegenerationsGraine;
+        _rehacher(doitEtreRehachee ? dispersion::tailleRehachage(m_tab.size(), m_cardinalite, m_nbEffaces)
+                                   : m_tab.size());
+    }
+    else if (doitEtreRehachee)
+    {
+        _rehacher(dispersion::tailleRehachage(m_tab.size(), m_cardinalite, m_nbEffaces));
+    }
+}
+
+/**
+ * \brief Retirer l'index d'une entrée
+ *
+ * La clef est relue par l'extracteur : l'entrée doit encore contenir sa clef.
+ * Si c'était la dernière entrée de cette clef, la case est marquée EFFACE.
+ *
+ * \param[in] p_index L'index de l'entrée à retirer
+ * \pre L'index fait partie des correspondances de sa clef
+ * \post L'index ne fait plus partie des correspondances de sa clef
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::enlever(size_t p_index)
+{
+    const TypeClef clef = m_extracteur(p_index);
+    const size_t position = _trouverPositionClef(clef, m_hachage(clef));
+
+    PRECONDITION(position != m_tab.size());
+
+    Case & courante = m_tab[position];
+    if (courante.m_nombre == 1)
+    {
+        PRECONDITION(courante.m_valeur == p_index);
+        courante.m_nombre = 0;
+        courante.m_valeur = EFFACE;
+        --m_cardinalite;
+        --m_nbValeurs;
+        ++m_nbEffaces;
+        return;
+    }
+
+    std::vector<uint32_t> & groupe = m_groupes[courante.m_valeur];
+    auto it = std::find(groupe.begin(), groupe.end(), static_cast<uint32_t>(p_index));
+
+    PRECONDITION(it != groupe.end());
+
+    // L'ordre des correspondances n'est pas significatif : on remplace par la dernière
+    *it = groupe.back();
+    groupe.pop_back();
+    --courante.m_nombre;
+    --m_nbValeurs;
+    if (courante.m_nombre == 1)
+    {
+        m_groupesLibres.push_back(courante.m_valeur);
+        courante.m_valeur = groupe.front();
+        groupe.clear();
+    }
+}
+
+/**
+ * \brief Trouver une position libre (vacante ou effacée) pour une valeur de hachage
+ *
+ * L'insertion et ses collisions sont comptées dans les statistiques.
+ *
+ * \param[in] p_valeurHachee La valeur de hachage de la clef
+ * \param[out] p_nbCollisions Le nombre de collisions subies
+ * \return La position libre
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+size_t TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::_trouverPositionLibre(
+        size_t p_valeurHachee, size_t & p_nbCollisions)
+{
+    dispersion::Sondage sondage(p_valeurHachee, m_tab.size());
+    while (m_tab[sondage.position()].m_nombre != 0)
+    {
+        sondage.suivant();
+    }
+
+    m_statistiques.compter(sondage.collisions());
+    p_nbCollisions = sondage.collisions();
+    return sondage.position();
+}
+
+/**
+ * \brief Trouver la position d'une clef dans l'index.
+ *
+ * La clef d'une case est celle de sa première entrée.
+ *
+ * \param[in] p_clef La clef à chercher
+ * \param[in] p_valeurHachee La valeur de hachage de la clef
+ * \return La position de la clef, ou m_tab.size() si elle est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+size_t TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::_trouverPositionClef(
+        const TypeClef & p_clef, size_t p_valeurHachee) const
+{
+    const uint32_t fragment = dispersion::fragment(p_valeurHachee);
+
+    for (dispersion::Sondage sondage(p_valeurHachee, m_tab.size());
+         m_tab[sondage.position()].m_nombre != 0 || m_tab[sondage.position()].m_valeur != VACANT; sondage.suivant())
+    {
+        const Case & courante = m_tab[sondage.position()];
+        if (courante.m_nombre != 0 && courante.m_fragment == fragment
+            && m_extracteur(_valeurs(courante).front()) == p_clef)
+        {
+            return sondage.position();
+        }
+    }
+    return m_tab.size();
+}
+
+/**
+ * \brief Retourner les index des entrées d'une case
+ * \param[in] p_case Une case occupée
+ * \return La plage contiguë des index
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+std::span<const uint32_t> TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::_valeurs(const Case & p_case) const
+{
+    if (p_case.m_nombre == 1)
+    {
+        return std::span<const uint32_t>(&p_case.m_valeur, 1);
+    }
+    return std::span<const uint32_t>(m_groupes[p_case.m_valeur]);
+}
+
+/**
+ * \brief Déterminer si au moins une entrée a cette clef
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \return Bool indiquant si la clef est dans l'index
+ * \post La table est inchangée.
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+bool TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::contient(const TypeClef & p_clef) const
+{
+    return _trouverPositionClef(p_clef, m_hachage(p_clef)) != m_tab.size();
+}
+
+/**
+ * \brief Retourner les index de toutes les entrées ayant une clef
+ *
+ * La plage reste valide jusqu'à la prochaine modification de l'index.
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \return La plage des index, vide si la clef est absente
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+std::span<const uint32_t> TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::trouver(const TypeClef & p_clef) const
+{
+    const size_t position = _trouverPositionClef(p_clef, m_hachage(p_clef));
+    if (position == m_tab.size())
+    {
+        return std::span<const uint32_t>();
+    }
+    return _valeurs(m_tab[position]);
+}
+
+/**
+ * \brief Retourner le nombre d'entrées ayant une clef
+ *
+ * \param[in] p_clef La clef laquelle il faut chercher
+ * \return Le nombre de correspondances
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+size_t TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::compter(const TypeClef & p_clef) const
+{
+    const size_t position = _trouverPositionClef(p_clef, m_hachage(p_clef));
+    return position == m_tab.size() ? 0 : m_tab[position].m_nombre;
+}
+
+/**
+ * \brief Rehacher la table.
+ *
+ * La taille est doublée et le premier nombre premier suivant ce nombre est
+ * choisi comme nouvelle taille. Les groupes ne sont pas recopiés : seules
+ * les cases sont replacées.
+ *
+ * \post La table est rehachée avec la nouvelle taille
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::rehacher()
+{
+    _rehacher(dispersion::prochainPremier(2 * m_tab.size()));
+}
+
+/**
+ * \brief Rehacher la table dans un tableau d'une taille donnée
+ *
+ * Les cases EFFACE disparaissent : une même taille purge la table. Un grand
+ * index est réparti entre les travailleurs s'ils ont été assignés.
+ *
+ * \param[in] p_taille La nouvelle taille, un nombre premier
+ * \pre La nouvelle taille laisse le taux de remplissage sous le maximum
+ * \post La table ne contient plus de case EFFACE
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::_rehacher(size_t p_taille)
+{
+    PRECONDITION(m_cardinalite < dispersion::seuilRemplissage(p_taille));
+    if (m_travailleurs != nullptr && m_cardinalite >= dispersion::SEUIL_REHACHAGE_PARALLELE)
+    {
+        _rehacherEnParallele(p_taille);
+        return;
+    }
+    m_statistiques.reinitialiser();
+
+    std::vector<Case> casesActives;
+    casesActives.reserve(m_cardinalite);
+    for (const Case & courante : m_tab)
+    {
+        if (courante.m_nombre != 0)
+        {
+            casesActives.push_back(courante);
+        }
+    }
+
+    const size_t nbValeurs = m_nbValeurs;
+    m_tab.resize(p_taille);
+    vider();
+
+    for (const Case & courante : casesActives)
+    {
+        const size_t valeurHachee = m_hachage(m_extracteur(_valeurs(courante).front()));
+        size_t nbCollisions = 0;
+        Case & nouvelle = m_tab[_trouverPositionLibre(valeurHachee, nbCollisions)];
+        nouvelle = courante;
+        nouvelle.m_fragment = dispersion::fragment(valeurHachee);
+        m_cardinalite++;
+    }
+    m_nbValeurs = nbValeurs;
+}
+
+/**
+ * \brief Rehacher l'index en répartissant l'ancien tableau entre les travailleurs
+ *
+ * Chaque clef distincte occupe une seule case : un fil réserve la première
+ * case libre du nouveau tableau en y échangeant atomiquement le nombre 0 pour
+ * celui de la case replacée, puis recopie la valeur et recalcule le fragment,
+ * la graine ayant pu changer. Les groupes ne sont pas touchés.
+ *
+ * \param[in] p_taille La nouvelle taille, un nombre premier
+ * \pre Un groupe de travailleurs est assigné
+ * \post La table ne contient plus de case EFFACE
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::_rehacherEnParallele(size_t p_taille)
+{
+    PRECONDITION(m_travailleurs != nullptr);
+
+    std::vector<Case, AllocateurCases> nouveau(p_taille, Case{0, 0, VACANT}, m_tab.get_allocator());
+    const size_t tailleNouveau = nouveau.size();
+    std::mutex verrouStatistiques;
+    m_statistiques.reinitialiser();
+
+    m_travailleurs->executerEnParallele(m_tab.size(), dispersion::TAILLE_BLOC_REHACHAGE,
+        [this, &nouveau, tailleNouveau, &verrouStatistiques](size_t p_debut, size_t p_fin)
+        {
+            StatistiquesCollisions statistiquesBloc;
+            for (size_t i = p_debut; i < p_fin; ++i)
+            {
+                const Case & courante = m_tab[i];
+                if (courante.m_nombre == 0)
+                {
+                    continue;
+                }
+                const size_t valeurHachee = m_hachage(m_extracteur(_valeurs(courante).front()));
+                dispersion::Sondage sondage(valeurHachee, tailleNouveau);
+                for (;;)
+                {
+                    std::atomic_ref<uint32_t> nombre(nouveau[sondage.position()].m_nombre);
+                    uint32_t attendu = 0;
+                    if (nombre.load(std::memory_order_relaxed) == 0
+                        && nombre.compare_exchange_strong(attendu, courante.m_nombre, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                    sondage.suivant();
+                }
+                nouveau[sondage.position()].m_fragment = dispersion::fragment(valeurHachee);
+                nouveau[sondage.position()].m_valeur = courante.m_valeur;
+                statistiquesBloc.compter(sondage.collisions());
+            }
+            std::lock_guard<std::mutex> verrou(verrouStatistiques);
+            m_statistiques.fusionner(statistiquesBloc);
+        });
+
+    m_tab.swap(nouveau);
+    m_nbEffaces = 0;
+}
+
+/**
+ * \brief Vider l'index
+ * \post L'index est vide
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::vider()
+{
+    m_cardinalite = 0;
+    m_nbValeurs = 0;
+    m_nbEffaces = 0;
+    for (size_t i = 0; i < m_tab.size(); ++i)
+    {
+        m_tab[i].m_nombre = 0;
+        m_tab[i].m_valeur = VACANT;
+    }
+}
+
+/**
+ * \brief Retourner le nombre d'entrées indexées
+ * \post La table est inchangée
+ * \return Le nombre d'entrées, toutes clefs confondues
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+size_t TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::taille() const
+{
+    return m_nbValeurs;
+}
+
+/**
+ * \brief Retourner le nombre de clefs distinctes
+ * \post La table est inchangée
+ * \return Le nombre de cases occupées
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+size_t TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::nombreClefs() const
+{
+    return m_cardinalite;
+}
+
+/**
+ * \brief Assigner les travailleurs qui rehachent les grands index
+ *
+ * \param[in] p_travailleurs Le groupe, qui doit survivre à l'index, ou nullptr
+ *            pour rehacher dans l'appelant
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::asgTravailleurs(
+        TP3::GroupeTravailleurs * p_travailleurs)
+{
+    m_travailleurs = p_travailleurs;
+}
+
+/**
+ * \brief Retourner le nombre de graines tirées après une insertion trop longue
+ * \post La table est inchangée
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+size_t TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::nombreRegenerationsGraine() const
+{
+    return m_nRegenerationsGraine;
+}
+
+/**
+ * \brief Calcule les statistiques du nombre moyen de collisions par insertion d'une nouvelle clef.
+ * \pre L'objet doit avoir ajouter au moins un élément
+ */
+template<typename TypeClef, class ExtracteurClef, class FoncteurHachage, class Allocateur>
+void TableHachageMulti<TypeClef, ExtracteurClef, FoncteurHachage, Allocateur>::statistiques(
+        double& p_ratio, size_t& p_nbCollisions, size_t& p_maximumCollisionUneInsertion) const
+{
+    m_statistiques.statistiques(p_ratio, p_nbCollisions, p_maximumCollisionUneInsertion);
+}
+
+} //Fin du namespace
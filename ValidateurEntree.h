@@ -0,0 +1,155 @@
+/**
+ * \file ValidateurEntree.h
+ * \brief Validation des champs d'une entrée du bottin.
+ *
+ * Les règles sont évaluées sans allocation ni expression régulière. Le format
+ * fixe des numéros de téléphone, "(ddd) ddd-dddd", est vérifié d'un seul bloc
+ * (SSE2 lorsque disponible, sinon une boucle sans branchement que le
+ * compilateur peut vectoriser). Toutes les fonctions sont constexpr et peuvent
+ * donc aussi être évaluées à la compilation.
+ */
+#ifndef VALIDATEURENTREE_H
+#define VALIDATEURENTREE_H
+
+#include <string_view>
+#include <type_traits>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace TP3 {
+
+/**
+ * \enum ChampEntree
+ * \brief Identifie le champ d'une entrée qui ne respecte pas les règles de validation.
+ */
+enum class ChampEntree {
+    AUCUN, /*!< tous les champs sont valides */
+    NOM, /*!< le nom est vide ou contient un séparateur */
+    PRENOM, /*!< le prénom est vide ou contient un séparateur */
+    TELEPHONE_FIXE, /*!< le téléphone fixe n'est pas au format (ddd) ddd-dddd */
+    CELLULAIRE, /*!< le cellulaire n'est pas au format (ddd) ddd-dddd */
+    COURRIEL /*!< le courriel n'a pas la forme local@domaine */
+};
+
+/**
+ * \brief Longueur d'un numéro de téléphone au format (ddd) ddd-dddd.
+ */
+inline constexpr std::size_t LONGUEUR_TELEPHONE = 14;
+
+/**
+ * \brief Gabarit du format de téléphone; 'd' désigne un chiffre.
+ */
+inline constexpr char GABARIT_TELEPHONE[LONGUEUR_TELEPHONE + 1] = "(ddd) ddd-dddd";
+
+/**
+ * \brief Vérifie le format d'un numéro de téléphone sans branchement par caractère.
+ * \param[in] p_telephone Le numéro à valider.
+ * \return Vrai si le numéro respecte le format (ddd) ddd-dddd.
+ */
+constexpr bool estTelephoneValide(std::string_view p_telephone) noexcept {
+    if (p_telephone.size() != LONGUEUR_TELEPHONE) {
+        return false;
+    }
+#if defined(__SSE2__)
+    if (!std::is_constant_evaluated()) {
+        // Les 14 octets sont copiés dans un bloc de 16 complété par des zéros;
+        // le gabarit est complété de la même façon pour que les deux derniers octets concordent.
+        alignas(16) char bloc[16] = {};
+        std::memcpy(bloc, p_telephone.data(), LONGUEUR_TELEPHONE);
+        const __m128i valeurs = _mm_load_si128(reinterpret_cast<const __m128i*>(bloc));
+        const __m128i litteraux = _mm_setr_epi8('(', 0, 0, 0, ')', ' ', 0, 0, 0, '-', 0, 0, 0, 0, 0, 0);
+        const __m128i positionsChiffres = _mm_setr_epi8(0, -1, -1, -1, 0, 0, -1, -1, -1, 0, -1, -1, -1, -1, 0, 0);
+        const __m128i chiffres = _mm_and_si128(_mm_cmpgt_epi8(valeurs, _mm_set1_epi8('0' - 1)),
+                                               _mm_cmplt_epi8(valeurs, _mm_set1_epi8('9' + 1)));
+        const __m128i egaux = _mm_cmpeq_epi8(valeurs, litteraux);
+        const __m128i correct = _mm_or_si128(_mm_and_si128(positionsChiffres, chiffres),
+                                             _mm_andnot_si128(positionsChiffres, egaux));
+        return _mm_movemask_epi8(correct) == 0xFFFF;
+    }
+#endif
+    unsigned int correct = 1;
+    for (std::size_t i = 0; i < LONGUEUR_TELEPHONE; ++i) {
+        const unsigned char c = static_cast<unsigned char>(p_telephone[i]);
+        const unsigned int estChiffre = static_cast<unsigned char>(c - '0') <= 9;
+        const unsigned int estLitteral = c == static_cast<unsigned char>(GABARIT_TELEPHONE[i]);
+        const unsigned int attendChiffre = GABARIT_TELEPHONE[i] == 'd';
+        correct &= (attendChiffre & estChiffre) | ((attendChiffre ^ 1u) & estLitteral);
+    }
+    return correct != 0;
+}
+
+/**
+ * \brief Vérifie qu'un nom ou un prénom est non vide et ne contient ni tabulation ni fin de ligne.
+ *
+ * Ces caractères briseraient le format du fichier de bottin (séparé par des tabulations).
+ *
+ * \param[in] p_texte Le nom ou le prénom à valider.
+ * \return Vrai si le texte est acceptable.
+ */
+constexpr bool estNomValide(std::string_view p_texte) noexcept {
+    unsigned int interdit = 0;
+    for (char c : p_texte) {
+        interdit |= (c == '\t') | (c == '\n') | (c == '\r');
+    }
+    return !p_texte.empty() && interdit == 0;
+}
+
+/**
+ * \brief Vérifie qu'un courriel a la forme local@domaine, sans espace ni tabulation.
+ * \param[in] p_courriel Le courriel à valider.
+ * \return Vrai si le courriel est acceptable.
+ */
+constexpr bool estCourrielValide(std::string_view p_courriel) noexcept {
+    const std::size_t arobase = p_courriel.find('@');
+    if (arobase == std::string_view::npos || arobase == 0 || arobase + 1 == p_courriel.size()) {
+        return false;
+    }
+    unsigned int interdit = 0;
+    for (char c : p_courriel) {
+        interdit |= (c == ' ') | (c == '\t') | (c == '\n') | (c == '\r');
+    }
+    return interdit == 0 && p_courriel.find('@', arobase + 1) == std::string_view::npos;
+}
+
+/**
+ * \brief Valide tous les champs d'une entrée.
+ * \param[in] p_nom Nom de la personne.
+ * \param[in] p_prenom Prénom de la personne.
+ * \param[in] p_telephoneFixe Numéro de téléphone fixe.
+ * \param[in] p_cellulaire Numéro de téléphone cellulaire.
+ * \param[in] p_courriel Adresse courriel.
+ * \return Le premier champ invalide, ou ChampEntree::AUCUN si l'entrée est valide.
+ */
+constexpr ChampEntree validerEntree(std::string_view p_nom, std::string_view p_prenom,
+                                    std::string_view p_telephoneFixe, std::string_view p_cellulaire,
+                                    std::string_view p_courriel) noexcept {
+    if (!estNomValide(p_nom)) return ChampEntree::NOM;
+    if (!estNomValide(p_prenom)) return ChampEntree::PRENOM;
+    if (!estTelephoneValide(p_telephoneFixe)) return ChampEntree::TELEPHONE_FIXE;
+    if (!estTelephoneValide(p_cellulaire)) return ChampEntree::CELLULAIRE;
+    if (!estCourrielValide(p_courriel)) return ChampEntree::COURRIEL;
+    return ChampEntree::AUCUN;
+}
+
+/**
+ * \brief Retourne le nom lisible d'un champ, pour les messages d'erreur.
+ * \param[in] p_champ Le champ.
+ * \return Le nom du champ.
+ */
+constexpr const char* nomChamp(ChampEntree p_champ) noexcept {
+    switch (p_champ) {
+        case ChampEntree::NOM: return "nom";
+        case ChampEntree::PRENOM: return "prénom";
+        case ChampEntree::TELEPHONE_FIXE: return "téléphone fixe";
+        case ChampEntree::CELLULAIRE: return "cellulaire";
+        case ChampEntree::COURRIEL: return "courriel";
+        default: return "aucun";
+    }
+}
+
+} // namespace TP3
+
+#endif // VALIDATEURENTREE_H
@@ -1,8 +1,99 @@
 #include <iostream>
 #include <fstream>
+#include <csignal>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <pthread.h>
+#include <unistd.h>
 #include "Bottin.h"
+#include "BottinEmbarqueDonnees.h"
+#include "BottinVersionne.h"
+#include "BottinPartage.h"
+#include "Instrumentation.h"
+#include "ServeurBottin.h"
+
+namespace {
+    /**
+     * \brief Prépare une version du bottin avant sa publication par le serveur.
+     */
+    void preparerPourServeur(TP3::Bottin& p_bottin) {
+        p_bottin.activerFiltresBloom();
+        p_bottin.figer();
+    }
 
-int main() {
+    /**
+     * \brief Mode serveur : répondre aux requêtes sur un socket Unix jusqu'à SIGINT ou SIGTERM.
+     * \details SIGHUP recharge Bottin.txt en arrière-plan et publie la nouvelle version sans
+     * interrompre le service; SIGUSR1 écrit les mesures par phase en JSON sur la sortie
+     * d'erreur (voir Instrumentation.h). Les signaux sont bloqués dans tous les fils et attendus par un fil dédié.
+     */
+    int executerServeur(std::ifstream& p_fichier, const std::string& p_chemin) {
+        sigset_t signaux;
+        sigemptyset(&signaux);
+        sigaddset(&signaux, SIGINT);
+        sigaddset(&signaux, SIGTERM);
+        sigaddset(&signaux, SIGHUP);
+        sigaddset(&signaux, SIGUSR1);
+        pthread_sigmask(SIG_BLOCK, &signaux, nullptr);
+
+        auto bottin = std::make_unique<TP3::Bottin>(p_fichier);
+        p_fichier.close();
+        preparerPourServeur(*bottin);
+        const size_t nbEntrees = bottin->nombreEntrees();
+        TP3::BottinVersionne versionne(std::move(bottin));
+        TP3::ServeurBottin serveur(versionne, p_chemin);
+
+        std::thread filSignaux([&]() {
+            for (;;) {
+                int signal = 0;
+                sigwait(&signaux, &signal);
+                if (signal == SIGUSR1) {
+                    labTableHachage::Instrumentation::ecrireJson(std::cerr);
+                    continue;
+                }
+                if (signal != SIGHUP) break;
+                if (!versionne.rechargerEnArrierePlan("Bottin.txt", preparerPourServeur)) {
+                    std::cerr << "Rechargement déjà en cours" << std::endl;
+                }
+            }
+            serveur.arreter();
+        });
+
+        std::cout << "Serveur à l'écoute sur " << p_chemin << " (" << nbEntrees << " entrées)" << std::endl;
+        try {
+            serveur.executer();
+        } catch (...) {
+            kill(getpid(), SIGTERM); // libérer le fil des signaux
+            filSignaux.join();
+            throw;
+        }
+        filSignaux.join();
+        try {
+            versionne.attendreRechargement();
+        } catch (const std::exception& e) {
+            std::cerr << "Erreur du dernier rechargement : " << e.what() << std::endl;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc > 1 && std::strcmp(argv[1], "--embarque") == 0) {
+        // Bottin construit à la compilation : aucune lecture de fichier (voir BottinEmbarque.h)
+        const auto& embarque = TP3::embarque::BOTTIN_EMBARQUE;
+        std::cout << "Bottin embarqué : " << embarque.nombreEntrees() << " entrées" << std::endl;
+        if (argc > 2) {
+            const std::optional<TP3::Bottin::Entree> entree = embarque.chercherAvecTelephone(argv[2]);
+            if (!entree) {
+                std::cout << "Aucune entrée pour " << argv[2] << std::endl;
+                return 1;
+            }
+            std::cout << *entree << std::endl;
+        }
+        return 0;
+    }
 
     std::ifstream fichier("Bottin.txt");
     if (!fichier.is_open()) {
@@ -10,16 +101,50 @@ int main() {
         return 1;
     }
 
+    if (argc > 1 && std::strcmp(argv[1], "--serveur") == 0) {
+        try {
+            return executerServeur(fichier, argc > 2 ? argv[2] : "/tmp/bottin.sock");
+        } catch (const std::exception& e) {
+            std::cerr << "Erreur du serveur : " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
     TP3::Bottin bottin(fichier);
     fichier.close();
 
+    if (argc > 1 && std::strcmp(argv[1], "--partager") == 0) {
+        // Publier le bottin en mémoire partagée pour les processus de travail (voir BottinPartage)
+        const std::string nom = argc > 2 ? argv[2] : "/bottin";
+        try {
+            TP3::BottinPartage::publier(bottin, nom);
+            std::cout << "Bottin publié dans le segment " << nom << " ("
+                      << TP3::BottinPartage(nom).taille() << " octets)" << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Erreur de publication : " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (argc > 2 && std::strcmp(argv[1], "--exporter") == 0) {
+        // Export TSV trié par nom, relisible par le constructeur du bottin
+        std::ofstream sortie(argv[2], std::ios::binary);
+        bottin.exporterTSV(sortie);
+        if (!sortie) {
+            std::cerr << "Erreur : écriture incomplète dans '" << argv[2] << "'." << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     std::cout << "Contenu du bottin : " << std::endl;
     bottin.afficherBottin(std::cout);
     std::cout << "\nNombre total d'entrées dans le bottin : " << bottin.nombreEntrees() << std::endl;
 
     double ratioNomPrenom;
-    int nbCollisionsNomPrenom;
-    int maxCollisionsNomPrenom;
+    size_t nbCollisionsNomPrenom;
+    size_t maxCollisionsNomPrenom;
     bottin.statistiquesNomPrenom(ratioNomPrenom, nbCollisionsNomPrenom, maxCollisionsNomPrenom);
 
 
@@ -29,8 +154,8 @@ int main() {
     std::cout << "Nombre maximal de collisions pour une insertion : " << maxCollisionsNomPrenom << std::endl;
 
     double ratioTelephone;
-    int nbCollisionsTelephone;
-    int maxCollisionsTelephone;
+    size_t nbCollisionsTelephone;
+    size_t maxCollisionsTelephone;
     bottin.statistiquesTelephone(ratioTelephone, nbCollisionsTelephone, maxCollisionsTelephone);
 
     std::cout << "\nStatistiques des téléphones :" << std::endl;
@@ -1,7 +1,34 @@
 #include <gtest/gtest.h>
 #include "Bottin.h"
+#include "TableHachage.h"
+#include "TableHachageFigee.h"
+#include "TableHachageIndexFigee.h"
+#include "TableHachageMulti.h"
+#include "EnsembleHachage.h"
+#include "StockageEntrees.h"
+#include "FiltreBloom.h"
+#include "ServeurBottin.h"
+#include "BottinVersionne.h"
+#include "JournalBottin.h"
+#include "BottinPartage.h"
+#include "ProtocoleBottin.h"
+#include "Instrumentation.h"
+#include "DonneesSynthetiques.h"
+#include "AllocateurPagesGeantes.h"
+#include "BottinEmbarqueDonnees.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
 #include <fstream>
 #include <iostream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace TP3;
 
@@ -13,7 +40,7 @@ TEST(BottinTests, TestLectureFichier) {
     Bottin bottin(fichier);
     fichier.close();
 
-    EXPECT_GT(bottin.nombreEntrees(), 0) << "Le fichier Bottin.txt semble vide ou mal formaté";
+    EXPECT_GT(bottin.nombreEntrees(), 0u) << "Le fichier Bottin.txt semble vide ou mal formaté";
 }
 
 // Test pour l'ajout d'une entrée
@@ -85,14 +112,14 @@ TEST(BottinTests, TestStatistiquesCollisions) {
     fichier.close();
 
     double ratioNomPrenom, ratioTelephone;
-    int collisionsNomPrenom, collisionsTelephone;
-    int maxCollisionsNomPrenom, maxCollisionsTelephone;
+    size_t collisionsNomPrenom, collisionsTelephone;
+    size_t maxCollisionsNomPrenom, maxCollisionsTelephone;
 
     bottin.statistiquesNomPrenom(ratioNomPrenom, collisionsNomPrenom, maxCollisionsNomPrenom);
     bottin.statistiquesTelephone(ratioTelephone, collisionsTelephone, maxCollisionsTelephone);
 
-    EXPECT_GE(collisionsNomPrenom, 0);
-    EXPECT_GE(collisionsTelephone, 0);
+    EXPECT_GE(maxCollisionsNomPrenom * bottin.nombreEntrees(), collisionsNomPrenom);
+    EXPECT_GE(maxCollisionsTelephone * bottin.nombreEntrees(), collisionsTelephone);
 
     std::cout << "\nStatistiques des collisions :\n";
     std::cout << "Nom/Prénom - Ratio : " << ratioNomPrenom
@@ -101,4 +128,1373 @@ TEST(BottinTests, TestStatistiquesCollisions) {
     std::cout << "Téléphone - Ratio : " << ratioTelephone
               << ", Collisions : " << collisionsTelephone
               << ", Max par insertion : " << maxCollisionsTelephone << "\n";
-}
\ No newline at end of file
+}
+
+// Tests pour la validation des champs d'une entrée
+TEST(ValidateurTests, TestFormatTelephone) {
+    static_assert(estTelephoneValide("(555) 123-4567"), "Validation possible à la compilation");
+    EXPECT_TRUE(estTelephoneValide("(530) 752-7325"));
+    EXPECT_FALSE(estTelephoneValide("(530) 752-732"));
+    EXPECT_FALSE(estTelephoneValide("(530)-752-7325"));
+    EXPECT_FALSE(estTelephoneValide("(53a) 752-7325"));
+    EXPECT_FALSE(estTelephoneValide("530 752-73255"));
+    EXPECT_FALSE(estTelephoneValide(""));
+}
+
+TEST(ValidateurTests, TestChampInvalideSignale) {
+    EXPECT_EQ(validerEntree("Adam", "Carl", "(530) 752-7325", "(530) 752-8960", "a@b.ca"), ChampEntree::AUCUN);
+    EXPECT_EQ(validerEntree("", "Carl", "(530) 752-7325", "(530) 752-8960", "a@b.ca"), ChampEntree::NOM);
+    EXPECT_EQ(validerEntree("Adam", "Carl", "(530) 752-7325", "530-752-8960", "a@b.ca"), ChampEntree::CELLULAIRE);
+    EXPECT_EQ(validerEntree("Adam", "Carl", "(530) 752-7325", "(530) 752-8960", "ab.ca"), ChampEntree::COURRIEL);
+    EXPECT_STREQ(nomChamp(ChampEntree::TELEPHONE_FIXE), "téléphone fixe");
+}
+
+TEST(ValidateurTests, TestAjoutRefuseTelephoneInvalide) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    EXPECT_THROW(bottin.ajouter("fares", "majdoub", "555-123-4567", "(555) 765-4321", "fares.majdoub@gmail.com"),
+                 PreconditionException);
+}
+
+// Tests pour les niveaux de contrat
+TEST(ContratTests, TestNiveauxDeVerification) {
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2> table;
+    table.inserer(7, 1);
+#if CONTRAT_NIVEAU >= 2
+    // Les vérifications d'audit (sondage de la table) ne sont actives qu'au niveau 2
+    EXPECT_THROW(table.inserer(7, 2), PreconditionException);
+    EXPECT_THROW(table.enlever(8), PreconditionException);
+#endif
+    EXPECT_EQ(table.element(7), 1);
+
+#if CONTRAT_NIVEAU >= 1
+    // Une vérification ratée lance l'exception du bon type, avec son expression
+    try {
+        POSTCONDITION(table.taille() == 0);
+        FAIL() << "La postcondition aurait dû échouer";
+    } catch (const PostconditionException& e) {
+        EXPECT_NE(e.reqTexteException().find("table.taille() == 0"), std::string::npos);
+    }
+#else
+    // Au niveau 0, les vérifications ne sont pas évaluées
+    EXPECT_NO_THROW(POSTCONDITION(table.taille() == 0));
+#endif
+}
+
+namespace {
+    /** \brief Hachage qui ne donne que 50 valeurs distinctes : presque toutes les clefs débordent */
+    struct HCinquanteValeurs {
+        size_t operator()(int p_clef) const { return static_cast<size_t>(p_clef % 50); }
+    };
+    struct ExtracteurEntier {
+        const std::vector<int>* m_entiers = nullptr;
+        int operator()(size_t p_index) const { return (*m_entiers)[p_index]; }
+    };
+    struct EgaliteComptee {
+        size_t* m_comparaisons = nullptr;
+        bool operator()(int p_a, int p_b) const { ++*m_comparaisons; return p_a == p_b; }
+    };
+}
+
+// Tests pour les tables de hachage figées
+TEST(TableHachageFigeeTests, TestToutesLesClefsRetrouvees) {
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2> table;
+    for (int i = 0; i < 20000; ++i) {
+        table.inserer(i * 7, i);
+    }
+    labTableHachage::TableHachageFigee<int, int, labTableHachage::HInt2> figee(table);
+
+    EXPECT_EQ(figee.taille(), 20000u);
+    for (int i = 0; i < 20000; ++i) {
+        ASSERT_TRUE(figee.contient(i * 7));
+        EXPECT_EQ(figee.element(i * 7), i);
+    }
+    EXPECT_FALSE(figee.contient(1));
+    EXPECT_EQ(figee.trouver(-7), nullptr);
+}
+
+TEST(TableHachageFigeeTests, TestValeursDeHachageIdentiques) {
+    // HString1 donne la même valeur à "ab" et "nW" : 11 * 97 + 13 * 98 == 11 * 110 + 13 * 87
+    labTableHachage::HString1 hachage;
+    ASSERT_EQ(hachage("ab"), hachage("nW"));
+    labTableHachage::TableHachage<std::string, int, labTableHachage::HString1> table;
+    table.inserer("ab", 1);
+    table.inserer("nW", 2);
+    table.inserer("abc", 3);
+    labTableHachage::TableHachageFigee<std::string, int, labTableHachage::HString1> figee(table);
+
+    EXPECT_EQ(figee.taille(), 3u);
+    EXPECT_EQ(figee.element("ab"), 1);
+    EXPECT_EQ(figee.element("nW"), 2);
+    EXPECT_EQ(figee.element("abc"), 3);
+    EXPECT_FALSE(figee.contient("cba"));
+}
+
+TEST(TableHachageFigeeTests, TestDebordementImportant) {
+    labTableHachage::TableHachage<int, int, HCinquanteValeurs> table(20011);
+    for (int i = 0; i < 10000; ++i) {
+        table.inserer(i * 100 + i % 50, i);
+    }
+    labTableHachage::TableHachageFigee<int, int, HCinquanteValeurs> figee(table);
+
+    EXPECT_EQ(figee.taille(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(figee.element(i * 100 + i % 50), i);
+    }
+    EXPECT_FALSE(figee.contient(-1));
+    EXPECT_EQ(figee.trouver(7 * 100 + 8), nullptr);
+}
+
+TEST(BottinTests, TestBottinFige) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+    bottin.figer();
+
+    EXPECT_TRUE(bottin.estFige());
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("Adam", "Carl").m_telephoneFixe,
+              bottin.trouverAvecTelephone(bottin.trouverAvecNomPrenom("Adam", "Carl").m_telephoneFixe).m_telephoneFixe);
+    EXPECT_EQ(bottin.trouverAvecTelephone("(530) 752-7325").m_nom, "Abbott");
+    EXPECT_THROW(bottin.trouverAvecTelephone("(000) 000-0000"), std::runtime_error);
+    EXPECT_THROW(bottin.ajouter("fares", "majdoub", "(555) 123-4567", "(555) 765-4321", "fares.majdoub@gmail.com"),
+                 PreconditionException);
+    EXPECT_EQ(bottin.maximumNbCollisionTelephone(), 0u);
+}
+
+// Tests pour la recherche par préfixe
+TEST(BottinTests, TestRechercheParPrefixe) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    std::vector<size_t> adams = bottin.trouverParPrefixe("Adams", 10);
+    ASSERT_EQ(adams.size(), 5u);
+    EXPECT_EQ(bottin.reqEntree(adams[0]).m_nom, "Adams");
+    EXPECT_EQ(bottin.reqEntree(adams[0]).m_prenom, "Douglas O");
+    EXPECT_EQ(bottin.reqEntree(adams[4]).m_nom, "Adamson");
+
+    std::vector<size_t> adamsT = bottin.trouverParPrefixe("Adams T", 10);
+    ASSERT_EQ(adamsT.size(), 1u);
+    EXPECT_EQ(bottin.reqEntree(adamsT[0]).m_prenom, "Thomas E");
+
+    EXPECT_EQ(bottin.trouverParPrefixe("A", 3).size(), 3u);
+    EXPECT_TRUE(bottin.trouverParPrefixe("Zz", 10).empty());
+
+    bottin.ajouter("Adams", "Bea", "(555) 123-4567", "(555) 765-4321", "bea@gmail.com");
+    adams = bottin.trouverParPrefixe("Adams", 10);
+    ASSERT_EQ(adams.size(), 6u);
+    EXPECT_EQ(bottin.reqEntree(adams[0]).m_prenom, "Bea");
+}
+
+// Tests pour l'index sans copie des clefs
+namespace {
+    struct ExtracteurMot {
+        const std::vector<std::string>* m_mots = nullptr;
+        std::string_view operator()(size_t p_index) const { return (*m_mots)[p_index]; }
+    };
+    typedef labTableHachage::TableHachageIndex<std::string_view, ExtracteurMot, labTableHachage::HString1> IndexMots;
+}
+
+TEST(TableHachageIndexTests, TestInsertionRechercheEtRehachage) {
+    std::vector<std::string> mots;
+    for (int i = 0; i < 1000; ++i) {
+        mots.push_back("mot" + std::to_string(i));
+    }
+    IndexMots index(ExtracteurMot{&mots}, 11);
+    for (size_t i = 0; i < mots.size(); ++i) {
+        index.inserer(i);
+    }
+
+    EXPECT_EQ(index.taille(), 1000u);
+    EXPECT_EQ(index.element("mot500"), 500u);
+    EXPECT_FALSE(index.trouver("mot1000").has_value());
+    EXPECT_LT(index.memoire(), mots.size() * 2 * sizeof(std::string));
+
+    index.enlever("mot500");
+    EXPECT_FALSE(index.contient("mot500"));
+    EXPECT_EQ(index.element("mot501"), 501u);
+
+    labTableHachage::TableHachageIndexFigee<std::string_view, ExtracteurMot, labTableHachage::HString1> figee(index);
+    EXPECT_EQ(figee.taille(), 999u);
+    EXPECT_EQ(figee.element("mot999"), 999u);
+    EXPECT_FALSE(figee.contient("mot500"));
+}
+
+TEST(TableHachageIndexTests, TestFigeeAvecValeursDeHachageIdentiques) {
+    std::vector<int> entiers;
+    for (int i = 0; i < 10000; ++i) {
+        entiers.push_back(i * 100 + i % 50);
+    }
+    size_t comparaisons = 0;
+    labTableHachage::TableHachageIndex<int, ExtracteurEntier, HCinquanteValeurs, EgaliteComptee> index(
+        ExtracteurEntier{&entiers}, 100, HCinquanteValeurs(), EgaliteComptee{&comparaisons});
+    for (size_t i = 0; i < entiers.size(); ++i) {
+        index.inserer(i);
+    }
+    labTableHachage::TableHachageIndexFigee<int, ExtracteurEntier, HCinquanteValeurs, EgaliteComptee> figee(index);
+    ASSERT_EQ(figee.taille(), 10000u);
+    for (size_t i = 0; i < entiers.size(); ++i) {
+        ASSERT_EQ(figee.trouver(entiers[i]), std::optional<size_t>(i));
+    }
+
+    // Une clef absente dont la valeur de hachage n'est pas en débordement : seul le candidat est comparé
+    comparaisons = 0;
+    EXPECT_FALSE(figee.contient(-1));
+    EXPECT_EQ(comparaisons, 1u);
+    // Sinon, seules les clefs de même valeur de hachage le sont
+    comparaisons = 0;
+    EXPECT_FALSE(figee.contient(7 * 100 + 8));
+    EXPECT_LE(comparaisons, 200u);
+}
+
+TEST(TableHachageIndexTests, TestInsertionsEtRetraitsRepetes) {
+    std::vector<std::string> mots;
+    for (int i = 0; i < 5000; ++i) {
+        mots.push_back("churn" + std::to_string(i));
+    }
+    IndexMots index(ExtracteurMot{&mots}, 11);
+    index.inserer(0);
+    // Chaque retrait laisse une case EFFACE : sans purge, aucune case VACANT n'arrêterait plus le sondage
+    for (size_t i = 1; i < mots.size(); ++i) {
+        index.inserer(i);
+        EXPECT_EQ(index.retirer(mots[i]), std::optional<size_t>(i));
+    }
+    EXPECT_EQ(index.taille(), 1u);
+    EXPECT_FALSE(index.contient("churn4999"));
+    EXPECT_FALSE(index.retirer("churn4999").has_value());
+    EXPECT_EQ(index.element("churn0"), 0u);
+    EXPECT_LT(index.memoire(), 100 * sizeof(std::string));
+}
+
+TEST(BottinTests, TestAjoutsEtSuppressionsRepetes) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+    const size_t nombreInitial = bottin.nombreEntrees();
+
+    for (int r = 0; r < 2000; ++r) {
+        char telephone[16];
+        std::snprintf(telephone, sizeof(telephone), "(555) %03d-%04d", 200 + r / 10000, r % 10000);
+        bottin.ajouter("Churn" + std::to_string(r), "X", telephone, "(555) 765-4321", "churn@exemple.com");
+        bottin.supprimer("Churn" + std::to_string(r), "X");
+    }
+    EXPECT_EQ(bottin.nombreEntrees(), nombreInitial);
+    EXPECT_THROW(bottin.trouverAvecNomPrenom("Churn1999", "X"), std::runtime_error);
+    EXPECT_EQ(bottin.trouverAvecTelephone("(760) 356-3069").m_nom, "Adam");
+}
+
+TEST(BottinTests, TestNomPrenomDistinctsDeLaConcatenation) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    // "Adams Jr, Theodore E" existe; la clé est le couple (nom, prénom), pas la concaténation
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("Adams Jr", "Theodore E").m_courriel, "tjadams@ucdavis.edu");
+    EXPECT_THROW(bottin.trouverAvecNomPrenom("Adams", "Jr Theodore E"), std::runtime_error);
+}
+
+TEST(BottinTests, TestSuppressionDeClesPrefixeEgales) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    // Les deux entrées ont la même clé « Adams Jr Theodore E » dans l'index des préfixes
+    bottin.ajouter("Adams", "Jr Theodore E", "(555) 200-0001", "(555) 765-4321", "jr@exemple.com");
+    EXPECT_EQ(bottin.trouverParPrefixe("Adams Jr Theodore E", 10).size(), 2u);
+
+    bottin.supprimer("Adams", "Jr Theodore E");
+    EXPECT_EQ(bottin.trouverParPrefixe("Adams Jr Theodore E", 10).size(), 1u);
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("Adams Jr", "Theodore E").m_courriel, "tjadams@ucdavis.edu");
+
+    bottin.ajouter("Adams", "Jr Theodore E", "(555) 200-0001", "(555) 765-4321", "jr@exemple.com");
+    bottin.supprimer("Adams Jr", "Theodore E");
+    EXPECT_EQ(bottin.trouverParPrefixe("Adams Jr Theodore E", 10).size(), 1u);
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("Adams", "Jr Theodore E").m_courriel, "jr@exemple.com");
+}
+
+// Tests pour les recherches à correspondances multiples
+TEST(BottinTests, TestRechercheParCourrielPartage) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    std::span<const uint32_t> tjadams = bottin.trouverAvecCourriel("tjadams@ucdavis.edu");
+    ASSERT_EQ(tjadams.size(), 2u);
+    std::vector<std::string> noms;
+    for (uint32_t index : tjadams) {
+        noms.emplace_back(bottin.reqEntree(index).m_nom);
+    }
+    std::sort(noms.begin(), noms.end());
+    EXPECT_EQ(noms[0], "Adam");
+    EXPECT_EQ(noms[1], "Adams Jr");
+
+    EXPECT_EQ(bottin.trouverAvecCourriel("cracredolo@ucdavis.edu").size(), 1u);
+    EXPECT_TRUE(bottin.trouverAvecCourriel("personne@nulle.part").empty());
+
+    bottin.ajouter("fares", "majdoub", "(555) 123-4567", "(530) 752-8960", "tjadams@ucdavis.edu");
+    EXPECT_EQ(bottin.trouverAvecCourriel("tjadams@ucdavis.edu").size(), 3u);
+    EXPECT_EQ(bottin.trouverAvecCellulaire("(530) 752-8960").size(), 3u);
+}
+
+TEST(BottinTests, TestRechercheParIndicatifEtCentral) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    EXPECT_EQ(bottin.compterAvecIndicatif("(530)"), 10u);
+    EXPECT_EQ(bottin.compterAvecCentral("(530) 752"), 10u);
+    EXPECT_EQ(bottin.compterAvecCentral("(909) 787"), 5u);
+    for (uint32_t index : bottin.trouverAvecIndicatif("(510)")) {
+        EXPECT_EQ(bottin.reqEntree(index).m_telephoneFixe.substr(0, 5), "(510)");
+    }
+    EXPECT_EQ(bottin.trouverAvecIndicatif("(510)").size(), 6u);
+    EXPECT_TRUE(bottin.trouverAvecIndicatif("530").empty());
+    EXPECT_TRUE(bottin.trouverAvecCentral("(530)752").empty());
+    EXPECT_EQ(bottin.compterAvecIndicatif("(000)"), 0u);
+
+    // Les groupes suivent les ajouts, retraits et changements de téléphone
+    bottin.ajouter("fares", "majdoub", "(530) 123-4567", "(530) 752-8960", "fm@ulaval.ca");
+    EXPECT_EQ(bottin.compterAvecIndicatif("(530)"), 11u);
+    EXPECT_EQ(bottin.compterAvecCentral("(530) 123"), 1u);
+    bottin.modifier("fares", "majdoub", "fares", "majdoub", "(418) 656-2131", "(530) 752-8960", "fm@ulaval.ca");
+    EXPECT_EQ(bottin.compterAvecIndicatif("(530)"), 10u);
+    EXPECT_EQ(bottin.compterAvecCentral("(418) 656"), 1u);
+    bottin.supprimer("Abbott", "Ursula K");
+    EXPECT_EQ(bottin.compterAvecCentral("(530) 752"), 9u);
+}
+
+namespace {
+    /**
+     * \brief Foncteur dont la graine initiale envoie toutes les clefs dans la même case.
+     */
+    struct HGraineFaible {
+        uint64_t m_graine = 0;
+        size_t operator()(int p_clef) const {
+            return m_graine == 0 ? 0 : labTableHachage::HSipInt64(m_graine, 0)(static_cast<uint64_t>(p_clef));
+        }
+        void regenererGraine() { m_graine = labTableHachage::tirerGraine() | 1; }
+    };
+}
+
+TEST(FoncteurHachageTests, TestSipHashEtRegenerationDeGraine) {
+    // Vecteur de référence de SipHash-2-4 : clé 00..0f, message 00..0e
+    std::string message;
+    for (char c = 0; c < 15; ++c) message.push_back(c);
+    const uint64_t valeur = labTableHachage::sipHash<2, 4>(0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull, message);
+    EXPECT_EQ(valeur, 0xa129ca6149be45e5ull);
+
+    labTableHachage::HSipString premier, second;
+    EXPECT_NE(premier("(530) 752-7325"), second("(530) 752-7325"));
+    EXPECT_EQ(labTableHachage::HSipString(1, 2)("abc"), labTableHachage::HSipString(1, 2)("abc"));
+
+    // Des clefs qui collisionnent toutes font tirer une nouvelle graine, une seule fois
+    labTableHachage::TableHachage<int, int, HGraineFaible> table;
+    for (int i = 0; i < 200; ++i) {
+        table.inserer(i, i * i);
+    }
+    EXPECT_EQ(table.nombreRegenerationsGraine(), 1u);
+    EXPECT_NE(table.reqHachage().m_graine, 0u);
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_EQ(table.element(i), i * i);
+    }
+    double ratio = 0;
+    size_t collisions = 0, maximum = 0;
+    table.statistiques(ratio, collisions, maximum);
+    EXPECT_LT(maximum, 64u);
+
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2> sansGraine;
+    for (int i = 0; i < 1000; ++i) sansGraine.inserer(i, i);
+    EXPECT_EQ(sansGraine.nombreRegenerationsGraine(), 0u);
+}
+
+TEST(FoncteurHachageTests, TestRegenerationDeGraineDesIndex) {
+    // Les index sans copie des clefs tirent aussi une nouvelle graine sous une inondation
+    std::vector<int> entiers;
+    for (int i = 0; i < 400; ++i) {
+        entiers.push_back(i % 200);
+    }
+    labTableHachage::TableHachageIndex<int, ExtracteurEntier, HGraineFaible> index(ExtracteurEntier{&entiers});
+    labTableHachage::TableHachageMulti<int, ExtracteurEntier, HGraineFaible> multi(ExtracteurEntier{&entiers});
+    for (size_t i = 0; i < entiers.size(); ++i) {
+        if (i < 200) {
+            index.inserer(i);
+        }
+        multi.inserer(i);
+    }
+    EXPECT_EQ(index.nombreRegenerationsGraine(), 1u);
+    EXPECT_EQ(multi.nombreRegenerationsGraine(), 1u);
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_EQ(index.element(i), static_cast<size_t>(i));
+        ASSERT_EQ(multi.compter(i), 2u);
+    }
+
+    // Les clefs normalisées équivalentes ont le même hachage sous une même graine
+    labTableHachage::HSipStringNormalisee normalise(3, 4);
+    EXPECT_EQ(normalise("Éloïse"), normalise("eloise"));
+    EXPECT_NE(normalise("Éloïse"), labTableHachage::HSipStringNormalisee()("eloise"));
+    const std::string longue(100, 'A');
+    EXPECT_EQ(normalise(longue), normalise(std::string(100, 'a')));
+}
+
+TEST(TableHachageTests, TestInsererSiAbsent) {
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2> table(11);
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(table.insererSiAbsent(i, i));
+    }
+    EXPECT_FALSE(table.insererSiAbsent(7, 70));
+    EXPECT_EQ(table.element(7), 7);
+    EXPECT_EQ(table.taille(), 200u);
+
+    // Après un retrait, la clef reprend une case effacée sans être dupliquée
+    table.enlever(7);
+    EXPECT_TRUE(table.insererSiAbsent(7, 71));
+    EXPECT_FALSE(table.insererSiAbsent(7, 72));
+    EXPECT_EQ(table.element(7), 71);
+    EXPECT_EQ(table.taille(), 200u);
+}
+
+TEST(EnsembleHachageTests, TestInsertionEnLotEtOperations) {
+    typedef labTableHachage::EnsembleHachage<int, labTableHachage::HInt2> Ensemble;
+    std::vector<int> multiplesDe2, multiplesDe3;
+    for (int i = 0; i < 3000; ++i) {
+        multiplesDe2.push_back(2 * i);
+        multiplesDe3.push_back(3 * i);
+    }
+    multiplesDe2.push_back(0); // doublon
+
+    Ensemble deux, trois;
+    EXPECT_EQ(deux.insererPlusieurs(multiplesDe2.begin(), multiplesDe2.end()), 3000u);
+    EXPECT_EQ(trois.insererPlusieurs(multiplesDe3.begin(), multiplesDe3.end()), 3000u);
+    EXPECT_FALSE(deux.inserer(4));
+    EXPECT_TRUE(deux.contient(5998));
+    EXPECT_FALSE(deux.contient(5999));
+
+    double ratio = 0;
+    size_t collisions = 0, maximum = 0;
+    deux.statistiques(ratio, collisions, maximum);
+    EXPECT_LE(maximum, collisions);
+
+    const Ensemble unionDeuxTrois = deux.unionAvec(trois);
+    const Ensemble multiplesDe6 = deux.intersection(trois);
+    const Ensemble deuxSansTrois = deux.difference(trois);
+    EXPECT_EQ(multiplesDe6.taille(), 1000u);
+    EXPECT_EQ(unionDeuxTrois.taille(), 5000u);
+    EXPECT_EQ(deuxSansTrois.taille(), 2000u);
+    EXPECT_EQ(trois.intersection(deux).taille(), 1000u);
+    multiplesDe6.parcourir([](int p_clef) { EXPECT_EQ(p_clef % 6, 0); });
+    deuxSansTrois.parcourir([](int p_clef) { EXPECT_NE(p_clef % 3, 0); });
+    EXPECT_TRUE(unionDeuxTrois.contient(8997));
+
+    deux.enlever(4);
+    EXPECT_FALSE(deux.contient(4));
+    EXPECT_EQ(deux.taille(), 2999u);
+}
+
+TEST(TableHachageMultiTests, TestRetraitEtRehachage) {
+    std::vector<std::string> mots;
+    for (int i = 0; i < 600; ++i) {
+        mots.push_back("mot" + std::to_string(i % 200));
+    }
+    labTableHachage::TableHachageMulti<std::string_view, ExtracteurMot, labTableHachage::HString1> index(ExtracteurMot{&mots}, 5);
+    for (size_t i = 0; i < mots.size(); ++i) {
+        index.inserer(i);
+    }
+
+    EXPECT_EQ(index.taille(), 600u);
+    EXPECT_EQ(index.nombreClefs(), 200);
+    EXPECT_EQ(index.compter("mot7"), 3u);
+
+    index.enlever(207);
+    index.enlever(7);
+    std::span<const uint32_t> restants = index.trouver("mot7");
+    ASSERT_EQ(restants.size(), 1u);
+    EXPECT_EQ(restants[0], 407u);
+    index.enlever(407);
+    EXPECT_FALSE(index.contient("mot7"));
+    EXPECT_EQ(index.compter("mot8"), 3u);
+}
+
+// Tests pour la suppression et la modification d'entrées
+TEST(BottinTests, TestSuppressionEtReutilisation) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+    const size_t nombreInitial = bottin.nombreEntrees();
+
+    bottin.supprimer("Adam", "Carl");
+    EXPECT_EQ(bottin.nombreEntrees(), nombreInitial - 1);
+    EXPECT_THROW(bottin.trouverAvecNomPrenom("Adam", "Carl"), std::runtime_error);
+    EXPECT_THROW(bottin.trouverAvecTelephone("(760) 356-3069"), std::runtime_error);
+    EXPECT_EQ(bottin.trouverAvecCourriel("tjadams@ucdavis.edu").size(), 1u);
+    EXPECT_EQ(bottin.trouverParPrefixe("Adam ", 10).size(), 0u);
+
+    bottin.ajouter("fares", "majdoub", "(760) 356-3069", "(555) 765-4321", "fares.majdoub@gmail.com");
+    EXPECT_EQ(bottin.nombreEntrees(), nombreInitial);
+    EXPECT_EQ(bottin.trouverAvecTelephone("(760) 356-3069").m_nom, "fares");
+    EXPECT_THROW(bottin.supprimer("Adam", "Carl"), PreconditionException);
+}
+
+TEST(BottinTests, TestModificationSurPlace) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    bottin.modifier("Adam", "Carl", "Adam", "Carl", "(555) 000-1111", "(530) 752-8960", "carl@ucdavis.edu");
+    EXPECT_EQ(bottin.trouverAvecTelephone("(555) 000-1111").m_prenom, "Carl");
+    EXPECT_THROW(bottin.trouverAvecTelephone("(760) 356-3069"), std::runtime_error);
+    EXPECT_EQ(bottin.trouverAvecCourriel("carl@ucdavis.edu").size(), 1u);
+    EXPECT_EQ(bottin.trouverAvecCourriel("tjadams@ucdavis.edu").size(), 1u);
+
+    bottin.modifier("Adam", "Carl", "Zed", "Carl", "(555) 000-1111", "(530) 752-8960", "carl@ucdavis.edu");
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("Zed", "Carl").m_telephoneFixe, "(555) 000-1111");
+    EXPECT_EQ(bottin.trouverParPrefixe("Zed", 10).size(), 1u);
+    EXPECT_THROW(bottin.modifier("Zed", "Carl", "Adams", "Douglas O", "(555) 000-1111", "(530) 752-8960",
+                                 "carl@ucdavis.edu"), PreconditionException);
+}
+
+// Tests pour le stockage en colonnes
+TEST(StockageEntreesTests, TestTelephonesCompactes) {
+    constexpr uint64_t telephone = StockageEntrees::compacterTelephone("(530) 752-7325");
+    static_assert(telephone == 5307527325ull);
+    EXPECT_EQ(StockageEntrees::formaterTelephone(telephone), "(530) 752-7325");
+    EXPECT_EQ(StockageEntrees::formaterTelephone(StockageEntrees::compacterTelephone("(000) 000-0042")), "(000) 000-0042");
+}
+
+TEST(StockageEntreesTests, TestCompactageConserveLesIndex) {
+    StockageEntrees stockage;
+    for (int i = 0; i < 50; ++i) {
+        stockage.ajouter("nom" + std::to_string(i), "prenom", i, i + 1, "n" + std::to_string(i) + "@a.ca");
+    }
+    for (int i = 0; i < 50; i += 2) {
+        stockage.liberer(i);
+    }
+    // Plus de la moitié du texte est morte : les bassins ont été compactés sans déplacer les index
+    for (int i = 1; i < 50; i += 2) {
+        EXPECT_EQ(stockage.nom(i), "nom" + std::to_string(i));
+        EXPECT_EQ(stockage.prenom(i), "prenom");
+        EXPECT_EQ(stockage.courriel(i), "n" + std::to_string(i) + "@a.ca");
+        EXPECT_EQ(stockage.cellulaire(i), static_cast<uint64_t>(i + 1));
+    }
+    EXPECT_FALSE(stockage.estActive(0));
+    stockage.remplacer(0, "Zed", "Alice", 7, 8, "z@a.ca");
+    EXPECT_EQ(stockage.prenom(0), "Alice");
+    EXPECT_EQ(stockage.taille(), 50u);
+}
+
+// Tests pour la comparaison normalisée des noms
+TEST(FoncteurHachageTests, TestNormalisationCasseEtAccents) {
+    labTableHachage::HStringNormalisee hachage;
+    labTableHachage::EgaliteNormalisee egalite;
+    EXPECT_TRUE(egalite("Éloïse", "eloise"));
+    EXPECT_TRUE(egalite("CŒUR", "coeur"));
+    EXPECT_TRUE(egalite("Strauß", "STRAUSS"));
+    EXPECT_EQ(hachage("Éloïse"), hachage("ELOISE"));
+    EXPECT_FALSE(egalite("eloise", "eloises"));
+    EXPECT_FALSE(egalite("a×b", "axb"));
+}
+
+TEST(BottinTests, TestRechercheNormalisee) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier, 100, Bottin::ComparaisonNoms::NORMALISEE);
+    fichier.close();
+
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("adam", "carl").m_nom, "Adam");
+    bottin.ajouter("Lévesque", "Hélène", "(555) 123-4567", "(555) 765-4321", "helene@ulaval.ca");
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("LEVESQUE", "helene").m_prenom, "Hélène");
+    EXPECT_THROW(bottin.ajouter("levesque", "HELENE", "(555) 123-0000", "(555) 765-4321", "h@ulaval.ca"),
+                 PreconditionException);
+
+    // Changer seulement la casse n'entre pas en conflit avec l'entrée elle-même
+    bottin.modifier("Lévesque", "Hélène", "LÉVESQUE", "Hélène", "(555) 123-4567", "(555) 765-4321", "helene@ulaval.ca");
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("levesque", "helene").m_nom, "LÉVESQUE");
+
+    bottin.figer();
+    EXPECT_EQ(bottin.trouverAvecNomPrenom("ADAM", "CARL").m_prenom, "Carl");
+
+    std::ifstream fichierExact("Bottin.txt");
+    Bottin exact(fichierExact);
+    EXPECT_THROW(exact.trouverAvecNomPrenom("adam", "carl"), std::runtime_error);
+}
+
+// Tests pour la recherche approximative
+TEST(IndexTrigrammesTests, TestDistanceEtCandidats) {
+    EXPECT_EQ(IndexTrigrammes::distanceBornee("douglas", "dougals", 3), 2u);
+    EXPECT_EQ(IndexTrigrammes::distanceBornee("adam", "adams", 3), 1u);
+    EXPECT_EQ(IndexTrigrammes::distanceBornee("abc", "xyzxyz", 2), 3u);
+
+    IndexTrigrammes index;
+    index.ajouter(0, "Lévesque Hélène");
+    index.ajouter(1, "Tremblay Jean");
+    std::vector<size_t> candidats = index.candidats("levesque helene", 0);
+    ASSERT_EQ(candidats.size(), 1u);
+    EXPECT_EQ(candidats[0], 0u);
+    index.retirer(0, "Lévesque Hélène");
+    EXPECT_TRUE(index.candidats("levesque helene", 1).empty());
+}
+
+TEST(BottinTests, TestRechercheApproximative) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    std::vector<size_t> resultats = bottin.trouverApproximatif("adams dougals o", 5);
+    ASSERT_FALSE(resultats.empty());
+    EXPECT_EQ(bottin.reqEntree(resultats[0]).m_prenom, "Douglas O");
+
+    EXPECT_TRUE(bottin.trouverApproximatif("zzzzzz qqqqq", 5).empty());
+
+    bottin.modifier("Adams", "Douglas O", "Adamz", "Douglas O", "(530) 752-1902", "(530) 752-0382", "doadams@ucdavis.edu");
+    resultats = bottin.trouverApproximatif("Adams Douglas O", 1, 1);
+    ASSERT_EQ(resultats.size(), 1u);
+    EXPECT_EQ(bottin.reqEntree(resultats[0]).m_nom, "Adamz");
+}
+
+// Tests pour les recherches en lot
+TEST(BottinTests, TestRecherchesEnLot) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    // Assez de clés pour dépasser le seuil de parallélisation
+    std::vector<std::string> telephones;
+    for (int i = 0; i < 40000; ++i) {
+        telephones.push_back(i % 3 == 0 ? "(530) 752-7325" : (i % 3 == 1 ? "(000) 000-0000" : "mal formé"));
+    }
+    std::vector<std::optional<size_t> > resultats(telephones.size());
+    bottin.trouverPlusieursAvecTelephone(telephones, resultats);
+    for (size_t i = 0; i < telephones.size(); ++i) {
+        ASSERT_EQ(resultats[i].has_value(), i % 3 == 0) << i;
+    }
+    EXPECT_EQ(bottin.reqEntree(*resultats[0]).m_nom, "Abbott");
+
+    std::vector<std::pair<std::string, std::string> > noms = {{"Adam", "Carl"}, {"Personne", "Inconnue"}};
+    std::vector<std::optional<size_t> > resultatsNoms(noms.size());
+    bottin.figer();
+    bottin.trouverPlusieursAvecNomPrenom(noms, resultatsNoms);
+    ASSERT_TRUE(resultatsNoms[0].has_value());
+    EXPECT_EQ(bottin.reqEntree(*resultatsNoms[0]).m_prenom, "Carl");
+    EXPECT_FALSE(resultatsNoms[1].has_value());
+}
+
+TEST(GroupeTravailleursTests, TestBouclesParalleles) {
+    GroupeTravailleurs travailleurs(4);
+    std::vector<int> valeurs(10000, 0);
+    travailleurs.executerEnParallele(valeurs.size(), 128, [&valeurs](size_t p_debut, size_t p_fin) {
+        for (size_t i = p_debut; i < p_fin; ++i) valeurs[i] += static_cast<int>(i);
+    });
+    for (size_t i = 0; i < valeurs.size(); ++i) {
+        ASSERT_EQ(valeurs[i], static_cast<int>(i));
+    }
+    EXPECT_THROW(travailleurs.executerEnParallele(1000, 10, [](size_t p_debut, size_t) {
+        if (p_debut == 500) throw std::runtime_error("bloc");
+    }), std::runtime_error);
+}
+
+TEST(GroupeTravailleursTests, TestRehachageParallele) {
+    GroupeTravailleurs travailleurs(4);
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2> parallele;
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2> sequentielle;
+    parallele.asgTravailleurs(&travailleurs);
+    for (int i = 0; i < 300000; ++i) {
+        parallele.inserer(i * 7, -i);
+        sequentielle.inserer(i * 7, -i);
+    }
+    parallele.enlever(14);
+    parallele.rehacher();
+    EXPECT_EQ(parallele.taille(), 299999u);
+    EXPECT_FALSE(parallele.contient(14));
+    for (int i = 3; i < 300000; ++i) {
+        ASSERT_EQ(parallele.element(i * 7), -i);
+    }
+    parallele.inserer(14, 5);
+    EXPECT_EQ(parallele.element(14), 5);
+
+    double ratio = 0;
+    size_t collisions = 0, maximum = 0, collisionsSeq = 0, maximumSeq = 0;
+    parallele.statistiques(ratio, collisions, maximum);
+    sequentielle.statistiques(ratio, collisionsSeq, maximumSeq);
+    EXPECT_LE(maximum, collisions);
+    EXPECT_GT(collisionsSeq, 0u);
+}
+
+TEST(GroupeTravailleursTests, TestRehachageParalleleIndex) {
+    GroupeTravailleurs travailleurs(4);
+    std::vector<std::string> mots;
+    for (int i = 0; i < 150000; ++i) {
+        mots.push_back("mot" + std::to_string(i % 75000));
+    }
+    IndexMots index(ExtracteurMot{&mots});
+    labTableHachage::TableHachageMulti<std::string_view, ExtracteurMot, labTableHachage::HString1> multi(ExtracteurMot{&mots});
+    index.asgTravailleurs(&travailleurs);
+    multi.asgTravailleurs(&travailleurs);
+    for (size_t i = 0; i < mots.size(); ++i) {
+        if (i < 75000) {
+            index.inserer(i);
+        }
+        multi.inserer(i);
+    }
+    index.enlever("mot14");
+    multi.enlever(14);
+    index.rehacher();
+    multi.rehacher();
+
+    EXPECT_EQ(index.taille(), 74999u);
+    EXPECT_FALSE(index.contient("mot14"));
+    EXPECT_EQ(multi.taille(), 149999u);
+    EXPECT_EQ(multi.nombreClefs(), 75000u);
+    for (size_t i = 15; i < 75000; ++i) {
+        ASSERT_EQ(index.element(mots[i]), i);
+        ASSERT_EQ(multi.compter(mots[i]), 2u);
+    }
+    ASSERT_EQ(multi.trouver("mot14").size(), 1u);
+    EXPECT_EQ(multi.trouver("mot14")[0], 75014u);
+
+    double ratio = 0;
+    size_t collisions = 0, maximum = 0;
+    index.statistiques(ratio, collisions, maximum);
+    EXPECT_LE(maximum, collisions);
+}
+
+TEST(ServeurBottinTests, TestTraitementRequetes) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    std::string requetes;
+    protocole::Ecrivain telephone(requetes);
+    telephone.u32(7);
+    telephone.u8(static_cast<uint8_t>(protocole::TypeRequete::TELEPHONE));
+    telephone.texte("(530) 752-7325");
+    telephone.terminer();
+
+    std::string reponse;
+    ServeurBottin::traiterRequete(bottin, std::string_view(requetes).substr(protocole::TAILLE_LONGUEUR), reponse);
+    protocole::Lecteur lecteur(std::string_view(reponse).substr(protocole::TAILLE_LONGUEUR));
+    EXPECT_EQ(lecteur.u32(), 7u);
+    EXPECT_EQ(lecteur.u8(), static_cast<uint8_t>(protocole::Statut::TROUVE));
+    EXPECT_EQ(lecteur.texte(), "Abbott");
+
+    requetes.clear();
+    protocole::Ecrivain lot(requetes);
+    lot.u32(8);
+    lot.u8(static_cast<uint8_t>(protocole::TypeRequete::LOT_TELEPHONES));
+    lot.u32(2);
+    lot.texte("(000) 000-0000");
+    lot.texte("(760) 356-3069");
+    lot.terminer();
+    reponse.clear();
+    ServeurBottin::traiterRequete(bottin, std::string_view(requetes).substr(protocole::TAILLE_LONGUEUR), reponse);
+    protocole::Lecteur lecteurLot(std::string_view(reponse).substr(protocole::TAILLE_LONGUEUR));
+    EXPECT_EQ(lecteurLot.u32(), 8u);
+    EXPECT_EQ(lecteurLot.u8(), static_cast<uint8_t>(protocole::Statut::TROUVE));
+    EXPECT_EQ(lecteurLot.u32(), 2u);
+    EXPECT_EQ(lecteurLot.u8(), static_cast<uint8_t>(protocole::Statut::ABSENT));
+    EXPECT_EQ(lecteurLot.u8(), static_cast<uint8_t>(protocole::Statut::TROUVE));
+    EXPECT_EQ(lecteurLot.texte(), "Adam");
+
+    // Message tronqué
+    reponse.clear();
+    ServeurBottin::traiterRequete(bottin, std::string_view(requetes).substr(protocole::TAILLE_LONGUEUR, 12), reponse);
+    protocole::Lecteur lecteurInvalide(std::string_view(reponse).substr(protocole::TAILLE_LONGUEUR));
+    EXPECT_EQ(lecteurInvalide.u32(), 8u);
+    EXPECT_EQ(lecteurInvalide.u8(), static_cast<uint8_t>(protocole::Statut::INVALIDE));
+}
+
+TEST(ServeurBottinTests, TestAllerRetourSocket) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    auto bottin = std::make_unique<Bottin>(fichier);
+    fichier.close();
+    bottin->figer();
+    BottinVersionne versionne(std::move(bottin));
+
+    const std::string chemin = "/tmp/testeur-bottin-" + std::to_string(getpid()) + ".sock";
+    ServeurBottin serveur(versionne, chemin, 2);
+    std::thread fil([&serveur]() { serveur.executer(); });
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un adresse{};
+    adresse.sun_family = AF_UNIX;
+    std::strncpy(adresse.sun_path, chemin.c_str(), sizeof(adresse.sun_path) - 1);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)), 0);
+
+    std::string requetes;
+    protocole::Ecrivain nomPrenom(requetes);
+    nomPrenom.u32(1);
+    nomPrenom.u8(static_cast<uint8_t>(protocole::TypeRequete::NOM_PRENOM));
+    nomPrenom.texte("Adam");
+    nomPrenom.texte("Carl");
+    nomPrenom.terminer();
+    protocole::Ecrivain absent(requetes);
+    absent.u32(2);
+    absent.u8(static_cast<uint8_t>(protocole::TypeRequete::TELEPHONE));
+    absent.texte("(000) 000-0000");
+    absent.terminer();
+    ASSERT_EQ(write(fd, requetes.data(), requetes.size()), static_cast<ssize_t>(requetes.size()));
+
+    std::vector<uint8_t> statuts(3, 0xFF);
+    for (int i = 0; i < 2; ++i) {
+        uint32_t longueur = 0;
+        ASSERT_EQ(recv(fd, &longueur, sizeof(longueur), MSG_WAITALL), static_cast<ssize_t>(sizeof(longueur)));
+        std::string message(longueur, '\0');
+        ASSERT_EQ(recv(fd, message.data(), longueur, MSG_WAITALL), static_cast<ssize_t>(longueur));
+        protocole::Lecteur lecteur(message);
+        const uint32_t identifiant = lecteur.u32();
+        ASSERT_LT(identifiant, statuts.size());
+        statuts[identifiant] = lecteur.u8();
+    }
+    EXPECT_EQ(statuts[1], static_cast<uint8_t>(protocole::Statut::TROUVE));
+    EXPECT_EQ(statuts[2], static_cast<uint8_t>(protocole::Statut::ABSENT));
+
+    close(fd);
+    serveur.arreter();
+    fil.join();
+}
+
+TEST(ServeurBottinTests, TestClientLentToutesLesReponses) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    auto bottin = std::make_unique<Bottin>(fichier);
+    fichier.close();
+    bottin->figer();
+    BottinVersionne versionne(std::move(bottin));
+
+    const std::string chemin = "/tmp/testeur-bottin-lent-" + std::to_string(getpid()) + ".sock";
+    ServeurBottin serveur(versionne, chemin, 2);
+    std::thread fil([&serveur]() { serveur.executer(); });
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un adresse{};
+    adresse.sun_family = AF_UNIX;
+    std::strncpy(adresse.sun_path, chemin.c_str(), sizeof(adresse.sun_path) - 1);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)), 0);
+
+    // Assez de requêtes pour que le serveur suspende la lecture, puis la reprenne quand le client lit
+    const uint32_t nombre = 20000;
+    std::string requetes;
+    for (uint32_t i = 0; i < nombre; ++i) {
+        protocole::Ecrivain telephone(requetes);
+        telephone.u32(i);
+        telephone.u8(static_cast<uint8_t>(protocole::TypeRequete::TELEPHONE));
+        telephone.texte("(760) 356-3069");
+        telephone.terminer();
+    }
+    std::thread ecrivain([fd, &requetes]() {
+        size_t ecrits = 0;
+        while (ecrits < requetes.size()) {
+            const ssize_t n = write(fd, requetes.data() + ecrits, requetes.size() - ecrits);
+            if (n <= 0) return;
+            ecrits += static_cast<size_t>(n);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<bool> recues(nombre, false);
+    for (uint32_t i = 0; i < nombre; ++i) {
+        uint32_t longueur = 0;
+        ASSERT_EQ(recv(fd, &longueur, sizeof(longueur), MSG_WAITALL), static_cast<ssize_t>(sizeof(longueur)));
+        std::string message(longueur, '\0');
+        ASSERT_EQ(recv(fd, message.data(), longueur, MSG_WAITALL), static_cast<ssize_t>(longueur));
+        protocole::Lecteur lecteur(message);
+        const uint32_t identifiant = lecteur.u32();
+        ASSERT_LT(identifiant, nombre);
+        EXPECT_FALSE(recues[identifiant]);
+        recues[identifiant] = true;
+        ASSERT_EQ(lecteur.u8(), static_cast<uint8_t>(protocole::Statut::TROUVE));
+    }
+    ecrivain.join();
+
+    close(fd);
+    serveur.arreter();
+    fil.join();
+}
+
+TEST(ServeurBottinTests, TestRequetePlusGrandeQueLeTamponDeLecture) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    auto bottin = std::make_unique<Bottin>(fichier);
+    fichier.close();
+    bottin->figer();
+    BottinVersionne versionne(std::move(bottin));
+
+    const std::string chemin = "/tmp/testeur-bottin-gros-" + std::to_string(getpid()) + ".sock";
+    ServeurBottin serveur(versionne, chemin, 2);
+    std::thread fil([&serveur]() { serveur.executer(); });
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un adresse{};
+    adresse.sun_family = AF_UNIX;
+    std::strncpy(adresse.sun_path, chemin.c_str(), sizeof(adresse.sun_path) - 1);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)), 0);
+
+    // Un seul message de plus de 2 Mo : le serveur doit le lire en entier avant de le découper
+    std::string requete;
+    protocole::Ecrivain lot(requete);
+    lot.u32(9);
+    lot.u8(static_cast<uint8_t>(protocole::TypeRequete::LOT_TELEPHONES));
+    lot.u32(protocole::NOMBRE_MAX_LOT);
+    for (uint32_t i = 0; i < protocole::NOMBRE_MAX_LOT; ++i) {
+        lot.texte(i == 1 ? "(760) 356-3069" : "numéro mal formé, mais long : (000) 000-0000");
+    }
+    lot.terminer();
+    ASSERT_GT(requete.size(), size_t{2} << 20);
+    std::thread ecrivain([fd, &requete]() {
+        size_t ecrits = 0;
+        while (ecrits < requete.size()) {
+            const ssize_t n = write(fd, requete.data() + ecrits, requete.size() - ecrits);
+            if (n <= 0) return;
+            ecrits += static_cast<size_t>(n);
+        }
+    });
+
+    uint32_t longueur = 0;
+    ASSERT_EQ(recv(fd, &longueur, sizeof(longueur), MSG_WAITALL), static_cast<ssize_t>(sizeof(longueur)));
+    std::string message(longueur, '\0');
+    ASSERT_EQ(recv(fd, message.data(), longueur, MSG_WAITALL), static_cast<ssize_t>(longueur));
+    ecrivain.join();
+    protocole::Lecteur lecteur(message);
+    EXPECT_EQ(lecteur.u32(), 9u);
+    EXPECT_EQ(lecteur.u8(), static_cast<uint8_t>(protocole::Statut::TROUVE));
+    EXPECT_EQ(lecteur.u32(), protocole::NOMBRE_MAX_LOT);
+    EXPECT_EQ(lecteur.u8(), static_cast<uint8_t>(protocole::Statut::ABSENT));
+    EXPECT_EQ(lecteur.u8(), static_cast<uint8_t>(protocole::Statut::TROUVE));
+    EXPECT_EQ(lecteur.texte(), "Adam");
+
+    close(fd);
+    serveur.arreter();
+    fil.join();
+}
+
+TEST(FiltreBloomTests, TestAbsencesEtFauxPositifs) {
+    labTableHachage::FiltreBloom filtre(10000, 12);
+    labTableHachage::HInt64 hachage;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        filtre.ajouter(hachage(i));
+    }
+    for (uint64_t i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(filtre.peutContenir(hachage(i)));
+    }
+    size_t fauxPositifs = 0;
+    for (uint64_t i = 10000; i < 110000; ++i) {
+        if (filtre.peutContenir(hachage(i))) ++fauxPositifs;
+    }
+    EXPECT_LT(fauxPositifs, 3000u); // moins de 3 %
+    EXPECT_EQ(filtre.nombreElements(), 10000u);
+    EXPECT_EQ(filtre.memoire() % 64, 0u);
+}
+
+TEST(BottinTests, TestRecherchesSansExceptionAvecFiltres) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier);
+    fichier.close();
+
+    EXPECT_FALSE(bottin.chercherAvecTelephone("(000) 000-0000").has_value());
+    EXPECT_FALSE(bottin.chercherAvecTelephone("mal formé").has_value());
+    EXPECT_FALSE(bottin.chercherAvecNomPrenom("Personne", "Inconnue").has_value());
+
+    bottin.activerFiltresBloom();
+    EXPECT_TRUE(bottin.filtresBloomActifs());
+    std::optional<Bottin::Entree> entree = bottin.chercherAvecTelephone("(760) 356-3069");
+    ASSERT_TRUE(entree.has_value());
+    EXPECT_EQ(entree->m_nom, "Adam");
+    EXPECT_EQ(bottin.chercherAvecNomPrenom("Adam", "Carl")->m_telephoneFixe, "(760) 356-3069");
+    EXPECT_FALSE(bottin.chercherAvecNomPrenom("Personne", "Inconnue").has_value());
+    EXPECT_THROW(bottin.trouverAvecTelephone("(000) 000-0000"), std::runtime_error);
+
+    // Assez d'ajouts pour forcer la reconstruction des filtres
+    for (int i = 0; i < 200; ++i) {
+        const std::string suffixe = std::to_string(1000 + i);
+        bottin.ajouter("Nom" + suffixe, "Prenom", "(555) 111-" + suffixe, "(555) 222-" + suffixe,
+                       "n" + suffixe + "@exemple.com");
+    }
+    for (int i = 0; i < 200; ++i) {
+        const std::string suffixe = std::to_string(1000 + i);
+        ASSERT_TRUE(bottin.chercherAvecTelephone("(555) 111-" + suffixe).has_value()) << suffixe;
+        ASSERT_TRUE(bottin.chercherAvecNomPrenom("Nom" + suffixe, "Prenom").has_value()) << suffixe;
+    }
+    bottin.modifier("Adam", "Carl", "Adam", "Carla", "(760) 356-0000", "(760) 356-3073", "tjadams@ucdavis.edu");
+    EXPECT_TRUE(bottin.chercherAvecNomPrenom("Adam", "Carla").has_value());
+    EXPECT_FALSE(bottin.chercherAvecTelephone("(760) 356-3069").has_value());
+
+    bottin.figer();
+    std::vector<std::string> telephones = {"(555) 111-1042", "(000) 000-0000", "(760) 356-0000"};
+    std::vector<std::optional<size_t> > resultats(telephones.size());
+    bottin.trouverPlusieursAvecTelephone(telephones, resultats);
+    EXPECT_TRUE(resultats[0].has_value());
+    EXPECT_FALSE(resultats[1].has_value());
+    EXPECT_TRUE(resultats[2].has_value());
+}
+
+TEST(BottinVersionneTests, TestRechargementPendantLesLectures) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    BottinVersionne versionne(std::make_unique<Bottin>(fichier));
+    fichier.close();
+    EXPECT_EQ(versionne.version(), 1u);
+
+    std::atomic<bool> fin(false);
+    std::atomic<size_t> echecs(0);
+    std::vector<std::thread> lecteurs;
+    for (int i = 0; i < 4; ++i) {
+        lecteurs.emplace_back([&]() {
+            uint64_t derniere = 0;
+            while (!fin.load()) {
+                BottinVersionne::Lecture lecture = versionne.lire();
+                // Les versions vues par un fil ne reculent jamais
+                if (lecture.version() < derniere || !lecture->chercherAvecTelephone("(760) 356-3069")) ++echecs;
+                derniere = lecture.version();
+            }
+        });
+    }
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(versionne.rechargerEnArrierePlan("Bottin.txt", [](Bottin& p_bottin) { p_bottin.figer(); }));
+        versionne.attendreRechargement();
+    }
+    fin.store(true);
+    for (std::thread& lecteur : lecteurs) {
+        lecteur.join();
+    }
+    EXPECT_EQ(echecs.load(), 0u);
+    EXPECT_EQ(versionne.version(), 6u);
+    EXPECT_TRUE(versionne.lire()->estFige());
+
+    // Un rechargement qui échoue laisse la version courante en place
+    ASSERT_TRUE(versionne.rechargerEnArrierePlan("inexistant.txt"));
+    EXPECT_THROW(versionne.attendreRechargement(), std::runtime_error);
+    EXPECT_EQ(versionne.version(), 6u);
+}
+
+TEST(JournalBottinTests, TestRejeuCompactageEtFinTronquee) {
+    const std::filesystem::path repertoire =
+            std::filesystem::temp_directory_path() / ("testeur-journal-" + std::to_string(getpid()));
+    std::filesystem::remove_all(repertoire);
+    std::filesystem::create_directories(repertoire);
+    const std::string base = (repertoire / "Bottin.txt").string();
+    const std::string journal = (repertoire / "Bottin.journal").string();
+    std::filesystem::copy_file("Bottin.txt", base);
+
+    auto ouvrir = [&base]() {
+        std::ifstream fichier(base);
+        return std::make_unique<Bottin>(fichier);
+    };
+
+    const size_t nombreInitial = ouvrir()->nombreEntrees();
+    {
+        auto bottin = ouvrir();
+        JournalBottin journalBottin(*bottin, base, journal, 0);
+        EXPECT_EQ(journalBottin.nombreRejoues(), 0u);
+        std::vector<std::thread> fils;
+        for (int f = 0; f < 4; ++f) {
+            fils.emplace_back([&journalBottin, f]() {
+                for (int i = 0; i < 25; ++i) {
+                    const std::string suffixe = std::to_string(1000 + f * 100 + i);
+                    journalBottin.ajouter("Nom" + suffixe, "Prenom", "(555) 111-" + suffixe, "(555) 222-" + suffixe,
+                                          "n" + suffixe + "@exemple.com");
+                }
+            });
+        }
+        for (std::thread& fil : fils) {
+            fil.join();
+        }
+        journalBottin.supprimer("Adam", "Carl");
+        journalBottin.modifier("Nom1000", "Prenom", "Nom1000", "Autre", "(555) 111-1000", "(555) 222-1000",
+                               "n1000@exemple.com");
+    }
+
+    // Une écriture interrompue laisse un enregistrement incomplet en fin de journal
+    std::ofstream(journal, std::ios::binary | std::ios::app) << std::string("\x40\0\0\0abc", 7);
+    {
+        auto bottin = ouvrir();
+        JournalBottin journalBottin(*bottin, base, journal, 0);
+        EXPECT_EQ(journalBottin.nombreRejoues(), 102u);
+        EXPECT_EQ(journalBottin.tailleJournal(), std::filesystem::file_size(journal));
+        EXPECT_TRUE(bottin->chercherAvecTelephone("(555) 111-1324").has_value());
+        EXPECT_FALSE(bottin->chercherAvecNomPrenom("Adam", "Carl").has_value());
+        EXPECT_TRUE(bottin->chercherAvecNomPrenom("Nom1000", "Autre").has_value());
+
+        std::filesystem::copy_file(journal, journal + ".ancien");
+        journalBottin.compacter();
+        EXPECT_LT(journalBottin.tailleJournal(), 32u);
+        journalBottin.ajouter("Apres", "Compactage", "(555) 333-0000", "(555) 333-0001", "apres@exemple.com");
+    }
+    {
+        auto bottin = ouvrir();
+        JournalBottin journalBottin(*bottin, base, journal, 0);
+        EXPECT_EQ(journalBottin.nombreRejoues(), 1u);
+        EXPECT_EQ(bottin->nombreEntrees(), nombreInitial + 100 - 1 + 1);
+        EXPECT_TRUE(bottin->chercherAvecNomPrenom("Nom1000", "Autre").has_value());
+    }
+
+    // Compactage interrompu entre les deux renommages : l'ancien journal est déjà dans la base
+    std::filesystem::rename(journal + ".ancien", journal);
+    {
+        auto bottin = ouvrir();
+        JournalBottin journalBottin(*bottin, base, journal, 0);
+        EXPECT_EQ(journalBottin.nombreRejoues(), 0u);
+        EXPECT_TRUE(std::filesystem::exists(journal + ".perime"));
+        EXPECT_EQ(bottin->nombreEntrees(), nombreInitial + 100 - 1);
+    }
+    std::filesystem::remove_all(repertoire);
+}
+
+TEST(BottinPartageTests, TestRecherchesDansUnAutreProcessus) {
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open()) << "Impossible d'ouvrir le fichier Bottin.txt";
+
+    Bottin bottin(fichier, 100, Bottin::ComparaisonNoms::NORMALISEE);
+    fichier.close();
+
+    const std::string nom = "/testeur-bottin-" + std::to_string(getpid());
+    BottinPartage::publier(bottin, nom);
+
+    const pid_t enfant = fork();
+    ASSERT_GE(enfant, 0);
+    if (enfant == 0) {
+        // Processus lecteur : mêmes résultats que le bottin source, sans le charger
+        int code = 0;
+        try {
+            BottinPartage partage(nom);
+            if (partage.nombreEntrees() != bottin.nombreEntrees()) code = 1;
+            else if (partage.trouverAvecTelephone("(760) 356-3069").m_nom != "Adam") code = 2;
+            else if (partage.trouverAvecNomPrenom("ADAM", "carl").m_courriel != "tjadams@ucdavis.edu") code = 3;
+            else if (partage.chercherAvecTelephone("(000) 000-0000").has_value()) code = 4;
+        } catch (...) {
+            code = 5;
+        }
+        _exit(code);
+    }
+    int statut = 0;
+    ASSERT_EQ(waitpid(enfant, &statut, 0), enfant);
+    ASSERT_TRUE(WIFEXITED(statut));
+    EXPECT_EQ(WEXITSTATUS(statut), 0);
+
+    BottinPartage partage(nom);
+    for (size_t i = 0; i < partage.nombreEntrees(); ++i) {
+        const Bottin::Entree entree = partage.reqEntree(i);
+        EXPECT_EQ(partage.trouverAvecTelephone(entree.m_telephoneFixe).m_nom, entree.m_nom);
+        EXPECT_EQ(partage.trouverAvecNomPrenom(std::string(entree.m_nom), std::string(entree.m_prenom)).m_courriel,
+                  entree.m_courriel);
+        EXPECT_EQ(bottin.trouverAvecNomPrenom(std::string(entree.m_nom), std::string(entree.m_prenom)).m_telephoneFixe,
+                  entree.m_telephoneFixe);
+    }
+    EXPECT_FALSE(partage.chercherAvecNomPrenom("Personne", "Inconnue").has_value());
+    EXPECT_THROW(partage.trouverAvecTelephone("(000) 000-0000"), std::runtime_error);
+
+    // La projection existante survit au retrait du segment
+    BottinPartage::retirer(nom);
+    EXPECT_EQ(partage.trouverAvecTelephone("(760) 356-3069").m_prenom, "Carl");
+    EXPECT_THROW(BottinPartage autre(nom), std::runtime_error);
+}
+
+// Tests pour l'instrumentation par phase
+TEST(InstrumentationTests, TestCumulsEchantillonnageEtJson) {
+    using labTableHachage::Instrumentation;
+    using labTableHachage::MesurePhase;
+    using labTableHachage::Phase;
+
+    Instrumentation::reinitialiser();
+    {
+        MesurePhase mesure(Phase::BOTTIN_TRI_PREFIXES);
+    }
+    {
+        MesurePhase ignoree(Phase::BOTTIN_TRI_PREFIXES, false);
+    }
+    const Instrumentation::Cumul& cumul = Instrumentation::cumul(Phase::BOTTIN_TRI_PREFIXES);
+    EXPECT_EQ(cumul.m_echantillons.load(), 1u);
+    EXPECT_EQ(cumul.m_echantillonsCompteurs.load(), Instrumentation::compteursDisponibles() ? 1u : 0u);
+
+    // Un appel sur quatre est mesuré, en commençant par le premier de chaque fil
+    const uint32_t periode = Instrumentation::periodeEchantillonnage();
+    Instrumentation::asgPeriodeEchantillonnage(4);
+    int mesures = 0;
+    std::thread([&mesures]() {
+        for (int i = 0; i < 12; ++i) {
+            if (Instrumentation::echantillonner()) ++mesures;
+        }
+    }).join();
+    EXPECT_EQ(mesures, 3);
+
+    std::ostringstream json;
+    Instrumentation::ecrireJson(json);
+    EXPECT_NE(json.str().find("\"periodeEchantillonnage\": 4"), std::string::npos);
+    EXPECT_NE(json.str().find("\"bottin_tri_prefixes\": {\"echantillons\": 1,"), std::string::npos);
+    Instrumentation::asgPeriodeEchantillonnage(periode);
+}
+
+// Tests pour le générateur de bottins synthétiques
+TEST(DonneesSynthetiquesTests, TestReproductibleEtChargeable) {
+    TP3::ParametresDonnees parametres;
+    parametres.m_lignes = 20000;
+    parametres.m_graine = 7;
+    parametres.m_nombreIndicatifs = 3;
+    parametres.m_tauxQuasiDoublons = 0.2;
+
+    std::ostringstream premier, second;
+    TP3::genererDonnees(premier, parametres);
+    TP3::genererDonnees(second, parametres);
+    EXPECT_EQ(premier.str(), second.str());
+    parametres.m_graine = 8;
+    std::ostringstream autreGraine;
+    TP3::genererDonnees(autreGraine, parametres);
+    EXPECT_NE(premier.str(), autreGraine.str());
+
+    // Clés et téléphones fixes uniques : tout se charge, en comparaison exacte comme normalisée
+    const std::filesystem::path chemin = std::filesystem::temp_directory_path() / "bottin_synthetique_test.txt";
+    {
+        std::ofstream fichier(chemin);
+        fichier << premier.str();
+    }
+    for (Bottin::ComparaisonNoms comparaison : {Bottin::ComparaisonNoms::EXACTE, Bottin::ComparaisonNoms::NORMALISEE}) {
+        std::ifstream fichier(chemin);
+        Bottin bottin(fichier, 100, comparaison);
+        EXPECT_EQ(bottin.nombreEntrees(), 20000u);
+    }
+    std::filesystem::remove(chemin);
+}
+
+// Tests pour les pages géantes
+TEST(AllocateurPagesGeantesTests, TestGrandeTableSurPagesGeantes) {
+    labTableHachage::TypePages type = labTableHachage::TypePages::EXPLICITES;
+    void* petite = labTableHachage::allouerPagesGeantes(4096, &type);
+    EXPECT_EQ(type, labTableHachage::TypePages::ORDINAIRES);
+    labTableHachage::libererPagesGeantes(petite, 4096);
+
+    const size_t octets = 3 * labTableHachage::TAILLE_PAGE_GEANTE + 123;
+    char* grande = static_cast<char*>(labTableHachage::allouerPagesGeantes(octets, &type));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(grande) % labTableHachage::TAILLE_PAGE_GEANTE, 0u);
+    grande[0] = 1;
+    grande[octets - 1] = 2;
+    labTableHachage::libererPagesGeantes(grande, octets);
+
+    // Plusieurs rehachages font passer le tableau des cases au-delà de 2 Mo
+    labTableHachage::TableHachage<int, int, labTableHachage::HInt2,
+                                  labTableHachage::AllocateurPagesGeantes<char> > table;
+    for (int i = 0; i < 200000; ++i) {
+        table.inserer(i * 3, i);
+    }
+    EXPECT_EQ(table.taille(), 200000u);
+    for (int i = 0; i < 200000; i += 7) {
+        ASSERT_EQ(table.element(i * 3), i);
+    }
+    EXPECT_FALSE(table.contient(1));
+    size_t collisions = 0, maximum = 0;
+    double ratio = 0;
+    table.statistiques(ratio, collisions, maximum);
+    EXPECT_LE(maximum, collisions);
+}
+
+// Tests pour le bottin embarqué à la compilation
+TEST(BottinEmbarqueTests, TestRecherchesCompileesEtIdentiquesAuBottin) {
+    using TP3::embarque::BOTTIN_EMBARQUE;
+    static_assert(BOTTIN_EMBARQUE.nombreEntrees() == 42u);
+    static_assert(BOTTIN_EMBARQUE.chercherIndexTelephone("(530) 752-7325") == size_t(0));
+    static_assert(BOTTIN_EMBARQUE.chercherIndexNomPrenom("Adam", "Carl").has_value());
+    static_assert(!BOTTIN_EMBARQUE.chercherIndexNomPrenom("adam", "carl").has_value());
+    static_assert(!BOTTIN_EMBARQUE.chercherIndexTelephone("(000) 000-0000").has_value());
+
+    std::ifstream fichier("Bottin.txt");
+    ASSERT_TRUE(fichier.is_open());
+    Bottin bottin(fichier);
+    ASSERT_EQ(BOTTIN_EMBARQUE.nombreEntrees(), bottin.nombreEntrees());
+    for (size_t i = 0; i < BOTTIN_EMBARQUE.nombreEntrees(); ++i) {
+        const Bottin::Entree entree = BOTTIN_EMBARQUE.reqEntree(i);
+        const Bottin::Entree attendue = bottin.trouverAvecNomPrenom(std::string(entree.m_nom), std::string(entree.m_prenom));
+        EXPECT_EQ(attendue.m_telephoneFixe, entree.m_telephoneFixe);
+        EXPECT_EQ(attendue.m_cellulaire, entree.m_cellulaire);
+        EXPECT_EQ(attendue.m_courriel, entree.m_courriel);
+        EXPECT_EQ(BOTTIN_EMBARQUE.trouverAvecTelephone(entree.m_telephoneFixe).m_nom, entree.m_nom);
+    }
+    EXPECT_THROW(BOTTIN_EMBARQUE.trouverAvecNomPrenom("Inconnu", "Personne"), std::runtime_error);
+    EXPECT_FALSE(BOTTIN_EMBARQUE.chercherAvecTelephone("(000) 000-0000").has_value());
+}
+
+// Tests pour l'export TSV
+TEST(ExportBottinTests, TestExportTrieRelisible) {
+    TP3::ParametresDonnees parametres;
+    parametres.m_lignes = 30000;
+    parametres.m_graine = 11;
+    std::istringstream genere([&parametres]() {
+        std::ostringstream texte;
+        TP3::genererDonnees(texte, parametres);
+        return texte.str();
+    }());
+    const std::filesystem::path chemin = std::filesystem::temp_directory_path()
+        / ("bottin_export_test_" + std::to_string(getpid()) + ".txt");
+    {
+        std::ofstream fichier(chemin);
+        fichier << genere.rdbuf();
+    }
+    std::ifstream fichier(chemin);
+    Bottin bottin(fichier);
+    fichier.close();
+    bottin.supprimer(std::string(bottin.reqEntree(5).m_nom), std::string(bottin.reqEntree(5).m_prenom));
+
+    // Les clés « nom prénom » sortent en ordre croissant, après le tri parallèle du chargement
+    std::ostringstream exporte;
+    bottin.exporterTSV(exporte);
+    std::istringstream lignes(exporte.str());
+    std::string ligne;
+    std::getline(lignes, ligne);
+    EXPECT_EQ(ligne, "29999");
+    std::vector<std::string> cles;
+    while (std::getline(lignes, ligne)) {
+        const std::string nomPrenom = ligne.substr(0, ligne.find('\t'));
+        const size_t virgule = nomPrenom.find(',');
+        cles.push_back(nomPrenom.substr(0, virgule) + ' ' + nomPrenom.substr(virgule + 2));
+    }
+    ASSERT_EQ(cles.size(), 29999u);
+    EXPECT_TRUE(std::is_sorted(cles.begin(), cles.end()));
+
+    // Le texte se recharge en un bottin identique
+    {
+        std::ofstream sortie(chemin);
+        sortie << exporte.str();
+    }
+    std::ifstream relu(chemin);
+    Bottin copie(relu);
+    std::ostringstream reexporte;
+    copie.exporterTSV(reexporte);
+    EXPECT_EQ(reexporte.str(), exporte.str());
+
+    std::ostringstream insertion;
+    bottin.exporterTSV(insertion, Bottin::OrdreExport::INSERTION);
+    EXPECT_EQ(insertion.str().size(), exporte.str().size());
+    EXPECT_NE(insertion.str(), exporte.str());
+    std::filesystem::remove(chemin);
+}